@@ -148,7 +148,13 @@ bool AtexitArray::expand_capacity() {
 }
 
 AtexitArray *findAtexitArray() {
-  SandHook::ElfImg libc("libc.so");
+  auto image = SandHook::ElfImg::Shared("libc.so");
+  if (image == nullptr)
+    return nullptr;
+  return findAtexitArray(*image);
+}
+
+AtexitArray *findAtexitArray(const SandHook::ElfImg &libc) {
   auto p_array = getExportedFieldPointer<AtexitEntry *>(libc, "_ZL7g_array.0");
   auto p_size = getExportedFieldPointer<size_t>(libc, "_ZL7g_array.1");
   auto p_extracted_count =
@@ -0,0 +1,27 @@
+#include "atexit.hpp"
+#include "detector.hpp"
+#include "logging.h"
+
+namespace {
+
+// Only logs the state of the atexit handlers for now, so it adds no line to
+// the report.
+class AtexitDetector : public Detectors::Detector {
+public:
+  const char *name() const override { return "atexit"; }
+
+  uint32_t inputs() const override { return Detectors::kLibc; }
+
+  Detectors::Finding Run(Detectors::Inputs &inputs) override {
+    auto *libc = inputs.libc();
+    auto *g_array = libc ? Atexit::findAtexitArray(*libc) : nullptr;
+    if (g_array != nullptr) {
+      LOGD("g_array status: %s", g_array->format_state_string().c_str());
+    }
+    return {};
+  }
+};
+
+} // namespace
+
+REGISTER_DETECTOR(AtexitDetector, 50);
@@ -0,0 +1,112 @@
+// Runs the registered detectors serially and on the work-stealing scheduler,
+// to check that a run takes about as long as its slowest detector.
+//
+// Usage: detector_bench [iterations] [threads]
+// Besides the maps detectors, which share one refresh of /proc/self/maps,
+// synthetic detectors stand for those that cannot run on a host: some wait
+// like a detector blocked on reads of procfs, others spin like one walking
+// symbol tables.
+#include "detector.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+template <int kMicros, bool kSpin>
+class SyntheticDetector : public Detectors::Detector {
+public:
+  const char *name() const override {
+    static const std::string name =
+        std::string(kSpin ? "spin " : "wait ") + std::to_string(kMicros) +
+        " us";
+    return name.c_str();
+  }
+
+  uint32_t inputs() const override { return 0; }
+
+  Detectors::Finding Run(Detectors::Inputs &) override {
+    auto duration = std::chrono::microseconds(kMicros);
+    if (!kSpin) {
+      std::this_thread::sleep_for(duration);
+      return {};
+    }
+    auto end = std::chrono::steady_clock::now() + duration;
+    while (std::chrono::steady_clock::now() < end) {
+    }
+    return {};
+  }
+};
+
+using Wait3000 = SyntheticDetector<3000, false>;
+using Wait1000 = SyntheticDetector<1000, false>;
+using Spin1000 = SyntheticDetector<1000, true>;
+using Spin500 = SyntheticDetector<500, true>;
+
+} // namespace
+
+REGISTER_DETECTOR(Wait3000, 100);
+REGISTER_DETECTOR(Wait1000, 110);
+REGISTER_DETECTOR(Spin1000, 120);
+REGISTER_DETECTOR(Spin500, 130);
+
+namespace {
+
+struct Timing {
+  double total_us;
+  std::vector<Detectors::Result> results;
+};
+
+// The median run, with the results of that run.
+Timing MedianRun(Detectors::Scheduler &scheduler, int iterations) {
+  std::vector<Timing> runs;
+  for (int i = 0; i < iterations; i++) {
+    auto begin = std::chrono::steady_clock::now();
+    auto results = scheduler.Run(Detectors::Registered());
+    auto end = std::chrono::steady_clock::now();
+    runs.push_back(
+        {std::chrono::duration<double, std::micro>(end - begin).count(),
+         std::move(results)});
+  }
+  std::sort(runs.begin(), runs.end(),
+            [](auto &a, auto &b) { return a.total_us < b.total_us; });
+  return std::move(runs[runs.size() / 2]);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  int iterations = argc > 1 ? std::max(1, atoi(argv[1])) : 50;
+  size_t threads = argc > 2 ? std::max(1, atoi(argv[2]))
+                            : Detectors::Scheduler::DefaultThreads();
+  Detectors::Scheduler serial(1);
+  Detectors::Scheduler parallel(threads);
+  // The first refresh of the maps reports every region as new.
+  serial.Run(Detectors::Registered());
+
+  auto before = MedianRun(serial, iterations);
+  auto after = MedianRun(parallel, iterations);
+  printf("%zu detectors, %zu threads, %u cpus\n",
+         Detectors::Registered().size(), parallel.threads(),
+         std::thread::hardware_concurrency());
+  printf("  %-20s %12s %12s %12s\n", "", "wall us", "cpu us", "wall us");
+  printf("  %-20s %12s %12s %12s\n", "", "(serial)", "(serial)",
+         "(scheduled)");
+  double slowest = 0;
+  for (size_t i = 0; i < before.results.size(); i++) {
+    auto &serial_result = before.results[i];
+    auto &result = after.results[i];
+    slowest = std::max(slowest, result.wall_ns / 1e3);
+    printf("  %-20s %12.1f %12.1f %12.1f\n", result.detector->name(),
+           serial_result.wall_ns / 1e3, serial_result.cpu_ns / 1e3,
+           result.wall_ns / 1e3);
+  }
+  printf("  %-20s %12.1f %12s %12.1f\n", "run", before.total_us, "",
+         after.total_us);
+  printf("  %-20s %12s %12s %12.1f\n", "slowest detector", "", "", slowest);
+  return 0;
+}
@@ -0,0 +1,37 @@
+// Writes the C source of the synthetic ELF fixtures of elf_lookup_bench.
+//
+// Usage: elf_fixture_gen <output.c> <exported> <local>
+// The fixture defines <exported> global objects, which land in .dynsym, and
+// <local> static objects named like LTO-renamed locals
+// (_ZL...<n>.llvm.<hash>), which only land in .symtab. The names are long
+// and share prefixes, like the mangled names of libart or the linker.
+#include <cstdio>
+#include <cstdlib>
+
+int main(int argc, char **argv) {
+  if (argc != 4) {
+    fprintf(stderr, "usage: %s <output.c> <exported> <local>\n", argv[0]);
+    return 1;
+  }
+  FILE *out = fopen(argv[1], "w");
+  if (out == nullptr) {
+    perror(argv[1]);
+    return 1;
+  }
+  long exported = atol(argv[2]);
+  long local = atol(argv[3]);
+
+  fprintf(out, "// Generated by elf_fixture_gen; do not edit.\n");
+  for (long i = 0; i < exported; i++) {
+    fprintf(out,
+            "int e%ld __asm__(\"_ZN7fixture5group%ld6objectE%ld\") = %ld;\n",
+            i, i % 97, i, i);
+  }
+  for (long i = 0; i < local; i++) {
+    fprintf(out,
+            "__attribute__((used)) static int l%ld "
+            "__asm__(\"_ZL12local_object%ld.llvm.%lu\") = %ld;\n",
+            i, i, (i * 2654435761UL) % 10000000019UL, i);
+  }
+  return fclose(out) == 0 ? 0 : 1;
+}
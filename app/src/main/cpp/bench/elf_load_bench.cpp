@@ -0,0 +1,179 @@
+// Compares the memory cost of loading an ElfImg and resolving symbols with
+// its section-on-demand loader, against mapping the whole file as ElfImg did
+// before.
+//
+// Usage: elf_load_bench [library...]
+// Without arguments, libc and libstdc++ of the host are measured. Each run
+// happens in a forked child so that page faults and RSS start from the same
+// state, and reports them while the file is still mapped. Symbols with a
+// zero value, such as version definitions, count as found only for the full
+// mapping.
+#include "elf_util.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <string>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+struct Usage {
+  long faults;
+  long rss_kb;
+};
+
+Usage Measure() {
+  rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  char statm[128] = {};
+  int fd = open("/proc/self/statm", O_RDONLY | O_CLOEXEC);
+  ssize_t n = read(fd, statm, sizeof(statm) - 1);
+  close(fd);
+  long pages = 0, resident = 0;
+  if (n > 0)
+    sscanf(statm, "%ld %ld", &pages, &resident);
+  return {usage.ru_minflt + usage.ru_majflt,
+          resident * (sysconf(_SC_PAGESIZE) / 1024)};
+}
+
+// What ElfImg did before: map the whole file, walk the section headers
+// through the mapping and resolve names with the .gnu.hash of the file.
+size_t LegacyResolve(const char *path, const std::vector<std::string> &names,
+                     Usage &peak) {
+  int fd = open(path, O_RDONLY | O_CLOEXEC);
+  off_t size = lseek(fd, 0, SEEK_END);
+  auto *header = static_cast<ElfW(Ehdr) *>(
+      mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0));
+  close(fd);
+  auto *file = reinterpret_cast<char *>(header);
+  auto *sections = reinterpret_cast<ElfW(Shdr) *>(file + header->e_shoff);
+  const ElfW(Sym) *dynsym = nullptr;
+  const char *dynstr = nullptr;
+  const ElfW(Word) *gnu_hash = nullptr;
+  for (int i = 0; i < header->e_shnum; i++) {
+    if (sections[i].sh_type == SHT_DYNSYM) {
+      dynsym = reinterpret_cast<ElfW(Sym) *>(file + sections[i].sh_offset);
+      dynstr = file + sections[sections[i].sh_link].sh_offset;
+    } else if (sections[i].sh_type == SHT_GNU_HASH) {
+      gnu_hash = reinterpret_cast<ElfW(Word) *>(file + sections[i].sh_offset);
+    }
+  }
+
+  size_t found = 0;
+  if (dynsym != nullptr && gnu_hash != nullptr) {
+    uint32_t nbucket = gnu_hash[0], symndx = gnu_hash[1];
+    auto *bucket = gnu_hash + 4 + gnu_hash[2] * (sizeof(ElfW(Addr)) / 4);
+    auto *chain = bucket + nbucket - symndx;
+    for (auto &name : names) {
+      uint32_t hash = SandHook::ElfImg::GnuHash(name);
+      for (uint32_t i = bucket[hash % nbucket]; i >= symndx; i++) {
+        if (((chain[i] ^ hash) >> 1) == 0 &&
+            name == dynstr + dynsym[i].st_name) {
+          found++;
+          break;
+        }
+        if (chain[i] & 1)
+          break;
+      }
+    }
+  }
+  peak = Measure();
+  munmap(header, size);
+  return found;
+}
+
+size_t ElfImgResolve(const char *path, const std::vector<std::string> &names,
+                     Usage &peak) {
+  SandHook::ElfImg image(path);
+  size_t found = 0;
+  for (auto &name : names)
+    found += image.getSymbAddress(name) != 0;
+  peak = Measure();
+  return found;
+}
+
+// Defined dynamic symbols of \p path, read before forking so that the
+// children only measure the resolution.
+std::vector<std::string> DynamicSymbols(const char *path, size_t limit) {
+  std::vector<std::string> names;
+  int fd = open(path, O_RDONLY | O_CLOEXEC);
+  struct stat st;
+  if (fd < 0 || fstat(fd, &st) != 0)
+    return names;
+  auto *file = static_cast<char *>(
+      mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0));
+  close(fd);
+  auto *header = reinterpret_cast<ElfW(Ehdr) *>(file);
+  auto *sections = reinterpret_cast<ElfW(Shdr) *>(file + header->e_shoff);
+  for (int i = 0; i < header->e_shnum; i++) {
+    if (sections[i].sh_type != SHT_DYNSYM)
+      continue;
+    auto *symbols = reinterpret_cast<ElfW(Sym) *>(file + sections[i].sh_offset);
+    const char *strings = file + sections[sections[i].sh_link].sh_offset;
+    size_t count = sections[i].sh_size / sizeof(ElfW(Sym));
+    // Spread over the table, as real lookups are.
+    size_t step = count / limit + 1;
+    for (size_t k = 0; k < count; k += step) {
+      if (symbols[k].st_shndx != SHN_UNDEF && symbols[k].st_name != 0)
+        names.emplace_back(strings + symbols[k].st_name);
+    }
+  }
+  munmap(file, st.st_size);
+  return names;
+}
+
+template <typename F>
+void RunInChild(const char *label, const std::vector<std::string> &names,
+                F &&resolve) {
+  fflush(stdout);
+  pid_t pid = fork();
+  if (pid == 0) {
+    // The first run takes the copy-on-write faults of the heap and stack.
+    Usage before, peak;
+    resolve(names, peak);
+    before = Measure();
+    size_t found = resolve(names, peak);
+    printf("  %-14s %8zu %8ld %10ld\n", label, found,
+           peak.faults - before.faults, peak.rss_kb - before.rss_kb);
+    fflush(stdout);
+    _exit(0);
+  }
+  waitpid(pid, nullptr, 0);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  std::vector<std::string> libraries;
+  for (int i = 1; i < argc; i++)
+    libraries.emplace_back(argv[i]);
+  if (libraries.empty())
+    libraries = {"libc.so.6", "libstdc++.so.6"};
+
+  for (auto &library : libraries) {
+    void *handle = dlopen(library.c_str(), RTLD_NOW);
+    link_map *map = nullptr;
+    if (handle == nullptr || dlinfo(handle, RTLD_DI_LINKMAP, &map) != 0) {
+      fprintf(stderr, "%s: not loadable\n", library.c_str());
+      continue;
+    }
+    const char *path = map->l_name;
+    auto names = DynamicSymbols(path, 256);
+    printf("%s (%zu lookups)\n", path, names.size());
+    printf("  %-14s %8s %8s %10s\n", "", "found", "faults", "RSS KiB");
+    RunInChild("full mmap", names, [&](auto &names, Usage &peak) {
+      return LegacyResolve(path, names, peak);
+    });
+    RunInChild("on demand", names, [&](auto &names, Usage &peak) {
+      return ElfImgResolve(path, names, peak);
+    });
+  }
+  return 0;
+}
@@ -0,0 +1,209 @@
+// Measures SandHook::ElfImg lookups by the table they are answered from:
+// .gnu.hash, .hash (SysV), the .symtab index, and prefix searches for
+// LTO-renamed locals.
+//
+// Usage: elf_lookup_bench [iterations] [library...]
+// The synthetic fixtures built next to this benchmark hold over 100k symbols:
+// libelf_fixture_gnu.so is linked with --hash-style=both and
+// libelf_fixture_sysv.so with --hash-style=sysv. The host libraries, libc and
+// libstdc++ by default, only have their .dynsym measured since distributions
+// strip .symtab.
+#include "elf_util.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+int iterations = 10;
+
+template <typename F> double MedianUs(F &&f) {
+  std::vector<double> samples;
+  for (int i = 0; i < iterations; i++) {
+    auto begin = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    samples.push_back(
+        std::chrono::duration<double, std::micro>(end - begin).count());
+  }
+  std::sort(samples.begin(), samples.end());
+  return samples[samples.size() / 2];
+}
+
+// Keeps the lookups from being optimized out.
+volatile ElfW(Addr) sink;
+
+void Report(const char *label, size_t count, double us) {
+  printf("  %-22s %8zu %12.1f\n", label, count, us * 1000 / count);
+}
+
+// Resolves every name and checks the addresses against the dynamic linker.
+void MeasureLookups(const char *label, const SandHook::ElfImg &image,
+                    void *handle, const std::vector<std::string> &names) {
+  for (auto &name : names) {
+    auto expected = reinterpret_cast<ElfW(Addr)>(dlsym(handle, name.c_str()));
+    if (expected != 0 && image.getSymbAddress(name) != expected) {
+      fprintf(stderr, "%s resolves to 0x%lx instead of 0x%lx\n", name.c_str(),
+              static_cast<unsigned long>(image.getSymbAddress(name)),
+              static_cast<unsigned long>(expected));
+      exit(1);
+    }
+  }
+  Report(label, names.size(), MedianUs([&] {
+           for (auto &name : names)
+             sink = image.getSymbAddress(name);
+         }));
+}
+
+void *Open(const std::string &library, std::string &path) {
+  void *handle = dlopen(library.c_str(), RTLD_NOW);
+  link_map *map = nullptr;
+  if (handle == nullptr || dlinfo(handle, RTLD_DI_LINKMAP, &map) != 0) {
+    fprintf(stderr, "%s: not loadable\n", library.c_str());
+    return nullptr;
+  }
+  path = map->l_name;
+  return handle;
+}
+
+// Every 16th defined name of .dynsym. dlsym() returns the implementation an
+// IFUNC selects rather than its resolver, so those are left out.
+std::vector<std::string> DynamicSymbols(const std::string &path) {
+  std::vector<std::string> names;
+  int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  struct stat st;
+  if (fd < 0 || fstat(fd, &st) != 0)
+    return names;
+  auto *file = static_cast<char *>(
+      mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0));
+  close(fd);
+  auto *header = reinterpret_cast<ElfW(Ehdr) *>(file);
+  auto *sections = reinterpret_cast<ElfW(Shdr) *>(file + header->e_shoff);
+  for (int i = 0; i < header->e_shnum; i++) {
+    if (sections[i].sh_type != SHT_DYNSYM)
+      continue;
+    auto *symbols =
+        reinterpret_cast<ElfW(Sym) *>(file + sections[i].sh_offset);
+    const char *strings = file + sections[sections[i].sh_link].sh_offset;
+    size_t count = sections[i].sh_size / sizeof(ElfW(Sym));
+    for (size_t k = 0; k < count; k += 16) {
+      if (symbols[k].st_shndx != SHN_UNDEF && symbols[k].st_value != 0 &&
+          (symbols[k].st_info & 0xf) != STT_GNU_IFUNC)
+        names.emplace_back(strings + symbols[k].st_name);
+    }
+  }
+  munmap(file, st.st_size);
+  return names;
+}
+
+void RunHostLibrary(const std::string &library) {
+  std::string path;
+  void *handle = Open(library, path);
+  if (handle == nullptr)
+    return;
+  printf("%s\n", path.c_str());
+  printf("  %-22s %8s %12s\n", "", "count", "ns/lookup");
+  Report("load", 1, MedianUs([&] { SandHook::ElfImg image(path); }));
+  SandHook::ElfImg image(path);
+  MeasureLookups("dynsym", image, handle, DynamicSymbols(path));
+}
+
+// The names elf_fixture_gen gives to the symbols of the fixtures.
+std::string ExportedName(long i) {
+  return "_ZN7fixture5group" + std::to_string(i % 97) + "6objectE" +
+         std::to_string(i);
+}
+
+std::string LocalName(long i) {
+  return "_ZL12local_object" + std::to_string(i);
+}
+
+std::string SuffixedLocalName(long i) {
+  return LocalName(i) + ".llvm." +
+         std::to_string((i * 2654435761UL) % 10000000019UL);
+}
+
+void RunFixture(const char *library, const char *hash_style) {
+  std::string path;
+  void *handle = Open(library, path);
+  if (handle == nullptr)
+    return;
+  printf("%s (%d exported, %d local symbols)\n", path.c_str(),
+         FIXTURE_EXPORTED, FIXTURE_LOCAL);
+  printf("  %-22s %8s %12s\n", "", "count", "ns/lookup");
+  Report("load", 1, MedianUs([&] { SandHook::ElfImg image(path); }));
+
+  std::vector<std::string> exported, locals, prefixes;
+  for (long i = 0; i < FIXTURE_EXPORTED; i += 7)
+    exported.push_back(ExportedName(i));
+  for (long i = 0; i < FIXTURE_LOCAL; i += 7) {
+    locals.push_back(SuffixedLocalName(i));
+    prefixes.push_back(LocalName(i));
+  }
+
+  SandHook::ElfImg image(path);
+  MeasureLookups(hash_style, image, handle, exported);
+
+  // The first miss of .dynsym maps .symtab and builds its index.
+  Report("symtab index build", 1, MedianUs([&] {
+           SandHook::ElfImg fresh(path);
+           sink = fresh.getSymbAddress(locals.front());
+         }));
+  MeasureLookups("symtab", image, handle, locals);
+
+  Report("name order build", 1, MedianUs([&] {
+           SandHook::ElfImg fresh(path);
+           sink = fresh.getSymbAddress(locals.front());
+           sink = fresh.getLocalSymbAddress(prefixes.front());
+         }));
+  for (size_t i = 0; i < prefixes.size(); i++) {
+    if (image.getLocalSymbAddress(prefixes[i]) !=
+        image.getSymbAddress(locals[i])) {
+      fprintf(stderr, "%s resolves differently by prefix\n",
+              prefixes[i].c_str());
+      exit(1);
+    }
+  }
+  Report("prefix", prefixes.size(), MedianUs([&] {
+           for (auto &prefix : prefixes)
+             sink = image.getLocalSymbAddress(prefix);
+         }));
+
+  // resolveAll() answers a batch of .symtab names in one pass without an
+  // index, as SoList::Initialize does.
+  std::vector<SandHook::SymbolRequest> batch;
+  for (size_t i = 0; i < 8; i++)
+    batch.emplace_back(prefixes[i * prefixes.size() / 8], true);
+  std::vector<ElfW(Addr)> addresses(batch.size());
+  Report("resolveAll (8, fresh)", batch.size(), MedianUs([&] {
+           SandHook::ElfImg fresh(path);
+           fresh.resolveAll(batch, addresses);
+         }));
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  if (argc > 1)
+    iterations = std::max(1, atoi(argv[1]));
+  std::vector<std::string> libraries;
+  for (int i = 2; i < argc; i++)
+    libraries.emplace_back(argv[i]);
+  if (libraries.empty())
+    libraries = {"libc.so.6", "libstdc++.so.6"};
+
+  RunFixture(FIXTURE_GNU, "gnu hash");
+  RunFixture(FIXTURE_SYSV, "sysv hash");
+  for (auto &library : libraries)
+    RunHostLibrary(library);
+  return 0;
+}
@@ -0,0 +1,154 @@
+// Compares the chunked maps scanner against the getline/sscanf parser it
+// replaced, on recorded maps files.
+//
+// Usage: maps_bench [iterations] [maps file...]
+// Without files, the benchmark runs on /proc/self/maps of the host process.
+// Recorded device maps can be captured with `adb shell cat /proc/<pid>/maps`.
+#include "map_snapshot.hpp"
+#include "vmap.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <sys/mman.h>
+#include <sys/sysmacros.h>
+#include <vector>
+
+static std::atomic<size_t> allocations{0};
+
+void *operator new(size_t size) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void *p = malloc(size))
+    return p;
+  throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { free(p); }
+void operator delete(void *p, size_t) noexcept { free(p); }
+
+using VirtualMap::MapInfo;
+
+// The parser MapInfo::Scan() used before the chunked scanner, kept verbatim
+// apart from taking the file to read.
+static std::vector<MapInfo> LegacyScan(const char *path) {
+  constexpr static auto kPermLength = 5;
+  constexpr static auto kMapEntry = 7;
+  std::vector<MapInfo> info;
+  auto maps =
+      std::unique_ptr<FILE, decltype(&fclose)>{fopen(path, "r"), &fclose};
+  if (maps) {
+    char *line = nullptr;
+    size_t len = 0;
+    ssize_t read;
+    while ((read = getline(&line, &len, maps.get())) > 0) {
+      line[read - 1] = '\0';
+      uintptr_t start = 0;
+      uintptr_t end = 0;
+      uintptr_t off = 0;
+      ino_t inode = 0;
+      unsigned int dev_major = 0;
+      unsigned int dev_minor = 0;
+      std::array<char, kPermLength> perm{'\0'};
+      int path_off;
+      if (sscanf(line,
+                 "%" PRIxPTR "-%" PRIxPTR " %4s %" PRIxPTR " %x:%x %lu %n%*s",
+                 &start, &end, perm.data(), &off, &dev_major, &dev_minor,
+                 &inode, &path_off) != kMapEntry) {
+        continue;
+      }
+      while (path_off < read && isspace(line[path_off]))
+        path_off++;
+      auto &ref = info.emplace_back(
+          MapInfo{start, end, 0, perm[3] == 'p', off,
+                  static_cast<dev_t>(makedev(dev_major, dev_minor)), inode,
+                  line + path_off});
+      if (perm[0] == 'r')
+        ref.perms |= PROT_READ;
+      if (perm[1] == 'w')
+        ref.perms |= PROT_WRITE;
+      if (perm[2] == 'x')
+        ref.perms |= PROT_EXEC;
+    }
+    free(line);
+  }
+  return info;
+}
+
+struct Result {
+  double ns_per_scan;
+  size_t entries;
+  size_t allocations;
+};
+
+template <typename F> static Result Measure(int iterations, F scan) {
+  size_t entries = scan(); // warm up the page cache
+  size_t before = allocations.load();
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; i++)
+    entries = scan();
+  auto elapsed = std::chrono::steady_clock::now() - start;
+  return {std::chrono::duration<double, std::nano>(elapsed).count() /
+              iterations,
+          entries, (allocations.load() - before) / iterations};
+}
+
+static void Report(const char *name, const Result &r, size_t bytes) {
+  printf("  %-10s %10.0f ns/scan %8.1f MB/s %8zu entries %8zu allocs/scan\n",
+         name, r.ns_per_scan, bytes * 1e3 / r.ns_per_scan, r.entries,
+         r.allocations);
+}
+
+int main(int argc, char **argv) {
+  int iterations = argc > 1 ? atoi(argv[1]) : 200;
+  std::vector<const char *> files(argv + (argc > 1 ? 2 : 1), argv + argc);
+  if (iterations <= 0)
+    iterations = 200;
+  if (files.empty())
+    files.push_back("/proc/self/maps");
+
+  for (const char *path : files) {
+    VirtualMap::MapsScanner scanner(path);
+    if (!scanner.ok()) {
+      fprintf(stderr, "cannot open %s\n", path);
+      continue;
+    }
+    VirtualMap::MapEntry entry;
+    size_t bytes = 0;
+    while (scanner.Next(entry))
+      bytes = scanner.bytes_read();
+
+    printf("%s (%zu bytes, %d iterations)\n", path, bytes, iterations);
+    Report("sscanf", Measure(iterations, [&] {
+             return LegacyScan(path).size();
+           }),
+           bytes);
+    Report("scanner", Measure(iterations, [&] {
+             size_t n = 0;
+             scanner.Rewind();
+             while (scanner.Next(entry))
+               n++;
+             return n;
+           }),
+           bytes);
+    Report("owned", Measure(iterations, [&] {
+             VirtualMap::MapsScanner fresh(path);
+             std::vector<MapInfo> info;
+             while (fresh.Next(entry))
+               info.emplace_back(entry.ToOwned());
+             return info.size();
+           }),
+           bytes);
+    VirtualMap::MapSnapshot snapshot(path);
+    VirtualMap::MapDelta delta;
+    Report("snapshot", Measure(iterations, [&] {
+             snapshot.Refresh(delta);
+             return snapshot.regions().size();
+           }),
+           bytes);
+  }
+  return 0;
+}
@@ -0,0 +1,104 @@
+// Compares the CPU cost of a session under the background monitor against
+// that of requesting a full scan on a fixed timer, as polling
+// stringFromJNI would.
+//
+// Usage: monitor_bench [seconds] [timer ms]
+// Besides the maps detectors, a synthetic detector spins like one parsing
+// ELF images, and is left out of the monitor as expensive. Halfway through
+// the session a new executable mapping appears, which both modes must
+// report.
+#include "detector.hpp"
+#include "monitor.hpp"
+#include "scan.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <sys/mman.h>
+#include <thread>
+
+namespace {
+
+class ElfParseDetector : public Detectors::Detector {
+public:
+  const char *name() const override { return "elf parse"; }
+  uint32_t inputs() const override { return 0; }
+  bool cheap() const override { return false; }
+
+  Detectors::Finding Run(Detectors::Inputs &) override {
+    auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(2);
+    while (std::chrono::steady_clock::now() < end) {
+    }
+    return {};
+  }
+};
+
+} // namespace
+
+REGISTER_DETECTOR(ElfParseDetector, 100);
+
+namespace {
+
+double ProcessCpuMs() {
+  timespec ts;
+  clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+  return ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+}
+
+// Maps an anonymous executable page halfway through the session, which the
+// maps detector reports, and unmaps it at the end.
+template <typename Tick> double Session(double seconds, Tick &&tick) {
+  auto start = std::chrono::steady_clock::now();
+  auto half = start + std::chrono::duration<double>(seconds / 2);
+  auto end = start + std::chrono::duration<double>(seconds);
+  void *page = nullptr;
+  double cpu = ProcessCpuMs();
+  while (std::chrono::steady_clock::now() < end) {
+    if (page == nullptr && std::chrono::steady_clock::now() >= half)
+      page = mmap(nullptr, 4096, PROT_READ | PROT_EXEC,
+                  MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    tick();
+  }
+  cpu = ProcessCpuMs() - cpu;
+  if (page != nullptr)
+    munmap(page, 4096);
+  return cpu;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  double seconds = argc > 1 ? atof(argv[1]) : 20;
+  int timer_ms = argc > 2 ? atoi(argv[2]) : 250;
+  // The first scan maps the worker and every region of the process.
+  Scan::Wait(Scan::Request());
+
+  uint64_t scans = 0;
+  double timer_cpu = Session(seconds, [&] {
+    Scan::Wait(Scan::Request());
+    scans++;
+    std::this_thread::sleep_for(std::chrono::milliseconds(timer_ms));
+  });
+
+  Monitor::Options options;
+  options.min_interval = std::chrono::milliseconds(timer_ms);
+  uint64_t before = Scan::Completed();
+  Monitor::Start(options);
+  double monitor_cpu = Session(seconds, [] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  });
+  Monitor::Stop();
+  auto stats = Monitor::GetStats();
+
+  printf("%.0f s sessions, timer every %d ms\n", seconds, timer_ms);
+  printf("  %-10s %10s %10s %10s\n", "", "cpu ms", "ticks", "scans");
+  printf("  %-10s %10.1f %10llu %10llu\n", "timer", timer_cpu,
+         (unsigned long long)scans, (unsigned long long)scans);
+  printf("  %-10s %10.1f %10llu %10llu\n", "monitor", monitor_cpu,
+         (unsigned long long)stats.ticks,
+         (unsigned long long)(Scan::Completed() - before));
+  printf("  monitor: %llu changes, last interval %lld ms, %.1f ms cpu\n",
+         (unsigned long long)stats.changes, (long long)stats.interval.count(),
+         stats.cpu_ns / 1e6);
+  return 0;
+}
@@ -0,0 +1,104 @@
+// Measures the throughput of the maps and smaps parsers and of both
+// DetectInjection() paths on synthetic files of growing size (see
+// proc_fixture.hpp), read from memory so that only the parse is timed.
+//
+// Usage: parse_bench [entries...]
+//        parse_bench dump maps|smaps <entries>
+// The second form prints a fixture, e.g. to feed maps_bench a large file.
+#include "logging.h"
+#include "proc_fixture.hpp"
+#include "smap.h"
+#include "vmap.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+constexpr size_t kDefaultSizes[] = {100, 1000, 10000, 100000, 200000};
+
+// Libraries watched by the smaps check, as the app would.
+constexpr std::string_view kWatched[] = {"libart.so", "libc.so",
+                                         "libandroid_runtime.so"};
+
+// Runs \p parse for at least 3 iterations and 0.2 s, and prints its rates
+// over \p bytes of input holding \p entries.
+template <typename F>
+void Measure(const char *name, size_t bytes, size_t entries, F parse) {
+  using Clock = std::chrono::steady_clock;
+  size_t parsed = parse();
+  int iterations = 0;
+  auto start = Clock::now();
+  auto elapsed = Clock::duration::zero();
+  do {
+    parsed = parse();
+    iterations++;
+    elapsed = Clock::now() - start;
+  } while (iterations < 3 || elapsed < std::chrono::milliseconds(200));
+  double seconds = std::chrono::duration<double>(elapsed).count() / iterations;
+  printf("  %-22s %10.3f ms %9.1f MB/s %11.0f entries/s%s\n", name,
+         seconds * 1e3, bytes / seconds / 1e6, entries / seconds,
+         parsed == entries ? "" : "  (entry count mismatch)");
+}
+
+void Run(size_t size) {
+  auto mappings = ProcFixture::Generate(size);
+  auto maps = ProcFixture::Maps(mappings);
+  auto smaps = ProcFixture::Smaps(mappings);
+  size_t entries = mappings.size();
+  printf("%zu entries: maps %zu bytes, smaps %zu bytes\n", entries,
+         maps.size(), smaps.size());
+
+  auto maps_source = ProcFs::Source::Memory(maps);
+  auto smaps_source = ProcFs::Source::Memory(smaps);
+  Measure("MapInfo::Scan", maps.size(), entries, [&] {
+    return VirtualMap::MapInfo::Scan(maps_source).size();
+  });
+  Measure("ParseSmaps", smaps.size(), entries, [&] {
+    ProcFs::LineReader reader(smaps_source);
+    size_t parsed = 0;
+    StatsMap::ParseSmaps(reader, StatsMap::kAllFields,
+                         [&](const StatsMap::SmapsEntry &) { parsed++; });
+    return parsed;
+  });
+  // The check logs every region whose inode does not match, which on the
+  // host is every file mapping. The messages are still queued, as on the
+  // device, but not written.
+  logging::SetSink(nullptr);
+  Measure("VirtualMap::Detect", maps.size(), entries, [&] {
+    VirtualMap::DetectInjection(maps_source);
+    return entries;
+  });
+  logging::SetSink(logging::DefaultSink());
+  Matcher::AhoCorasick watched(kWatched);
+  Measure("StatsMap::Detect", smaps.size(), entries, [&] {
+    StatsMap::DetectInjection(watched, smaps_source);
+    return entries;
+  });
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  if (argc == 4 && strcmp(argv[1], "dump") == 0) {
+    auto mappings = ProcFixture::Generate(strtoul(argv[3], nullptr, 10));
+    bool smaps = strcmp(argv[2], "smaps") == 0;
+    auto file =
+        smaps ? ProcFixture::Smaps(mappings) : ProcFixture::Maps(mappings);
+    fwrite(file.data(), 1, file.size(), stdout);
+    return 0;
+  }
+  std::vector<size_t> sizes(std::begin(kDefaultSizes),
+                            std::end(kDefaultSizes));
+  if (argc > 1) {
+    sizes.clear();
+    for (int i = 1; i < argc; i++)
+      sizes.push_back(strtoul(argv[i], nullptr, 10));
+  }
+  for (size_t size : sizes)
+    Run(size);
+  return 0;
+}
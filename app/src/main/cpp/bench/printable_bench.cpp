@@ -0,0 +1,138 @@
+// Measures the printable-run kernels against the byte-at-a-time isprint()
+// loop DumpStackStrings() used before, on synthetic stack-like buffers.
+//
+// Usage: printable_bench [megabytes...]
+#include "printable.hpp"
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+struct Totals {
+  size_t runs = 0;
+  size_t bytes = 0;
+};
+
+// The loop of logPossibleStrings() before the vector kernels, minus logging.
+static Totals LegacyRuns(const char *start, size_t size, size_t min_length) {
+  Totals totals;
+  const char *end = start + size;
+  const char *ptr = start;
+  while (ptr < end) {
+    if (isprint(static_cast<unsigned char>(*ptr))) {
+      const char *string_end = ptr + 1;
+      while (string_end < end &&
+             isprint(static_cast<unsigned char>(*string_end)))
+        string_end++;
+      size_t length = string_end - ptr;
+      if (length >= min_length) {
+        std::string found_str(ptr, length);
+        totals.runs++;
+        totals.bytes += found_str.size();
+      }
+      ptr = string_end;
+    } else {
+      ptr++;
+    }
+  }
+  return totals;
+}
+
+static Totals KernelRuns(const char *start, size_t size, size_t min_length,
+                         Printable::Kernel kernel) {
+  Totals totals;
+  Printable::Run runs[256];
+  Printable::RunFinder finder(start, size, min_length, kernel);
+  while (size_t count = finder.Next(runs)) {
+    totals.runs += count;
+    for (size_t i = 0; i < count; i++)
+      totals.bytes += runs[i].length;
+  }
+  return totals;
+}
+
+// Mostly pointers, small integers and zeroes, with a string every few
+// hundred bytes, like the main thread stack of an app.
+static std::vector<char> StackLikeBuffer(size_t size) {
+  static const char *const kWords[] = {
+      "/system/lib64/libart.so", "zygisk", "Ljava/lang/String;",
+      "/data/app/~~xyz/base.apk", "android.app.ActivityThread", "main"};
+  std::mt19937_64 rng(42);
+  std::vector<char> buffer(size);
+  for (size_t i = 0; i + 8 <= size; i += 8) {
+    uint64_t word;
+    switch (rng() % 8) {
+    case 0:
+    case 1:
+      word = 0;
+      break;
+    case 2:
+      word = rng() % 4096;
+      break;
+    default:
+      word = 0x0000007000000000ull | (rng() & 0xfffffff8ull);
+      break;
+    }
+    memcpy(&buffer[i], &word, sizeof(word));
+    if (rng() % 32 == 0) {
+      const char *text = kWords[rng() % std::size(kWords)];
+      size_t length = std::min(strlen(text), size - i);
+      memcpy(&buffer[i], text, length);
+      i += length & ~size_t{7};
+    }
+  }
+  return buffer;
+}
+
+template <typename F> static double MeasureMBs(size_t size, F scan) {
+  scan();
+  int iterations = 0;
+  auto start = std::chrono::steady_clock::now();
+  std::chrono::duration<double> elapsed{};
+  do {
+    scan();
+    iterations++;
+    elapsed = std::chrono::steady_clock::now() - start;
+  } while (elapsed.count() < 0.5);
+  return size * iterations / elapsed.count() / 1e6;
+}
+
+int main(int argc, char **argv) {
+  std::vector<size_t> sizes;
+  for (int i = 1; i < argc; i++)
+    sizes.push_back(strtoul(argv[i], nullptr, 10) << 20);
+  if (sizes.empty())
+    sizes = {1 << 20, 8 << 20, 32 << 20};
+
+  constexpr size_t kMinLength = 3;
+  for (size_t size : sizes) {
+    auto buffer = StackLikeBuffer(size);
+    Totals expected = LegacyRuns(buffer.data(), size, kMinLength);
+    printf("%zu MiB, %zu runs of %zu bytes\n", size >> 20, expected.runs,
+           expected.bytes);
+    printf("  %-8s %10.1f MB/s\n", "isprint", MeasureMBs(size, [&] {
+             return LegacyRuns(buffer.data(), size, kMinLength);
+           }));
+    for (auto kernel :
+         {Printable::Kernel::kScalar, Printable::Kernel::kVector128,
+          Printable::Kernel::kVector256}) {
+      if (kernel > Printable::BestKernel())
+        continue;
+      Totals totals = KernelRuns(buffer.data(), size, kMinLength, kernel);
+      if (totals.runs != expected.runs || totals.bytes != expected.bytes) {
+        fprintf(stderr, "%s found %zu runs of %zu bytes\n",
+                Printable::KernelName(kernel), totals.runs, totals.bytes);
+        return 1;
+      }
+      printf("  %-8s %10.1f MB/s\n", Printable::KernelName(kernel),
+             MeasureMBs(size, [&] {
+               return KernelRuns(buffer.data(), size, kMinLength, kernel);
+             }));
+    }
+  }
+  return 0;
+}
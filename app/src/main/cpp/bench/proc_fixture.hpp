@@ -0,0 +1,272 @@
+#pragma once
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/// \brief Synthetic /proc/<pid>/maps and smaps files shaped like those of an
+/// Android app process, at any number of entries.
+///
+/// The regions are a mix of anonymous memory, ART (the runtime, boot image
+/// and app oat files), JIT memfds, and system and vendor libraries mapped
+/// segment by segment. There is one executable JIT cache of each kind and no
+/// anonymous executable memory, so the maps detectors only object to the
+/// inodes, which do not match any file of the host.
+namespace ProcFixture {
+
+struct Mapping {
+  uintptr_t start;
+  uintptr_t end;
+  const char *perms;
+  uintptr_t offset;
+  unsigned major;
+  unsigned minor;
+  uint64_t inode;
+  std::string path;
+};
+
+namespace Detail {
+
+inline constexpr std::string_view kAnonymous[] = {
+    "",
+    "[anon:libc_malloc]",
+    "[anon:scudo:primary]",
+    "[anon:scudo:secondary]",
+    "[anon:dalvik-main space (region space)]",
+    "[anon:dalvik-LinearAlloc]",
+    "[anon:dalvik-indirect ref table]",
+    "[anon:dalvik-CompilerMetadata]",
+    "[anon:.bss]",
+    "[anon:cfi shadow]",
+    "[anon:thread signal stack]",
+};
+
+inline constexpr std::string_view kBootImages[] = {
+    "boot", "boot-core-libart", "boot-okhttp", "boot-bouncycastle",
+    "boot-apache-xml", "boot-framework", "boot-framework-graphics",
+    "boot-ext", "boot-telephony-common", "boot-voip-common", "boot-ims-common",
+    "boot-framework-adservices"};
+
+inline constexpr std::string_view kArtLibraries[] = {
+    "libart.so",        "libartbase.so",      "libdexfile.so",
+    "libnativebridge.so", "libnativeloader.so", "libprofile.so",
+    "libartpalette.so", "libsigchain.so"};
+
+inline constexpr std::string_view kSystemLibraries[] = {
+    "libc.so",      "libm.so",        "libdl.so",
+    "liblog.so",    "libutils.so",    "libcutils.so",
+    "libbinder.so", "libui.so",       "libgui.so",
+    "libhwui.so",   "libskia.so",     "libandroid_runtime.so",
+    "libEGL.so",    "libGLESv2.so",   "libvulkan.so",
+    "libmedia.so",  "libsqlite.so",   "libcamera_client.so",
+    "libssl.so",    "libcrypto.so",   "libz.so"};
+
+/// \brief Appends a region to \p out after the previous one, with a gap.
+class Layout {
+public:
+  Layout(std::vector<Mapping> &out, uint32_t seed) : out_(out), random_(seed) {}
+
+  void Add(size_t pages, const char *perms, uintptr_t offset, unsigned major,
+           unsigned minor, uint64_t inode, std::string path) {
+    next_ += Pick(4) * 0x1000;
+    out_.push_back({next_, next_ + pages * 0x1000, perms, offset, major, minor,
+                    inode, std::move(path)});
+    next_ += pages * 0x1000;
+  }
+
+  // The read-only, code, relro and data segments of a shared object.
+  void AddLibrary(const std::string &path, unsigned major, unsigned minor) {
+    uint64_t inode = 1000 + Pick(1 << 20);
+    size_t text = 1 + Pick(256);
+    uintptr_t offset = 0;
+    struct Segment {
+      size_t pages;
+      const char *perms;
+    } segments[] = {{1 + Pick(64), "r--p"},
+                    {text, "r-xp"},
+                    {1 + Pick(8), "r--p"},
+                    {1 + Pick(4), "rw-p"}};
+    for (auto &segment : segments) {
+      Add(segment.pages, segment.perms, offset, major, minor, inode, path);
+      offset += segment.pages * 0x1000;
+    }
+  }
+
+  size_t Pick(size_t n) { return random_() % n; }
+
+  size_t size() const { return out_.size(); }
+
+private:
+  std::vector<Mapping> &out_;
+  std::mt19937 random_;
+  uintptr_t next_ = 0x12c00000;
+};
+
+} // namespace Detail
+
+/// \brief About \p entries regions in address order. The mix is fixed by
+/// \p seed.
+inline std::vector<Mapping> Generate(size_t entries, uint32_t seed = 1) {
+  std::vector<Mapping> maps;
+  maps.reserve(entries + 8);
+  Detail::Layout layout(maps, seed);
+  // Distinct paths grow with the size, so that large files do not reuse a
+  // handful of names.
+  size_t vendor_libraries = std::max<size_t>(entries / 16, 4);
+  size_t apps = std::max<size_t>(entries / 400, 1);
+
+  layout.Add(16, "r-xs", 0, 0, 1, 4101, "/memfd:jit-zygote-cache (deleted)");
+  layout.Add(16, "r--s", 0x10000, 0, 1, 4101,
+             "/memfd:jit-zygote-cache (deleted)");
+  layout.Add(64, "r-xs", 0, 0, 1, 4102, "/memfd:jit-cache (deleted)");
+  layout.Add(64, "rw-s", 0x40000, 0, 1, 4102, "/memfd:jit-cache (deleted)");
+
+  char path[160];
+  while (layout.size() < entries) {
+    size_t kind = layout.Pick(100);
+    if (kind < 40) {
+      auto name =
+          Detail::kAnonymous[layout.Pick(std::size(Detail::kAnonymous))];
+      layout.Add(1 + layout.Pick(512), layout.Pick(8) ? "rw-p" : "---p", 0, 0,
+                 0, 0, std::string(name));
+    } else if (kind < 45) {
+      // A thread stack and its guard page.
+      snprintf(path, sizeof(path), "[anon:stack_and_tls:%zu]",
+               1000 + layout.Pick(30000));
+      layout.Add(1, "---p", 0, 0, 0, 0, "");
+      layout.Add(256, "rw-p", 0, 0, 0, 0, path);
+    } else if (kind < 60) {
+      auto name =
+          Detail::kSystemLibraries[layout.Pick(
+              std::size(Detail::kSystemLibraries))];
+      snprintf(path, sizeof(path), "/system/lib64/%.*s", int(name.size()),
+               name.data());
+      layout.AddLibrary(path, 253, 6);
+    } else if (kind < 75) {
+      snprintf(path, sizeof(path), "/vendor/lib64/libvendor.%zu.so",
+               layout.Pick(vendor_libraries));
+      layout.AddLibrary(path, 253, 7);
+    } else if (kind < 82) {
+      auto name =
+          Detail::kArtLibraries[layout.Pick(std::size(Detail::kArtLibraries))];
+      snprintf(path, sizeof(path), "/apex/com.android.art/lib64/%.*s",
+               int(name.size()), name.data());
+      layout.AddLibrary(path, 7, 40);
+    } else if (kind < 92) {
+      auto name =
+          Detail::kBootImages[layout.Pick(std::size(Detail::kBootImages))];
+      static constexpr const char *kSuffixes[] = {".art", ".oat", ".vdex"};
+      snprintf(path, sizeof(path), "/system/framework/arm64/%.*s%s",
+               int(name.size()), name.data(), kSuffixes[layout.Pick(3)]);
+      layout.Add(1 + layout.Pick(128), layout.Pick(2) ? "r--p" : "rw-p",
+                 layout.Pick(64) * 0x1000, 253, 6, 2000 + layout.Pick(4096),
+                 path);
+    } else if (kind < 97) {
+      size_t app = layout.Pick(apps);
+      static constexpr const char *kFiles[] = {
+          "base.apk", "oat/arm64/base.odex", "oat/arm64/base.vdex"};
+      snprintf(path, sizeof(path),
+               "/data/app/~~%08zx==/com.example.app%zu-%08zx==/%s", app * 7919,
+               app, app * 104729, kFiles[layout.Pick(3)]);
+      layout.Add(1 + layout.Pick(256), "r--p", layout.Pick(256) * 0x1000, 254,
+                 40, 3000 + app, path);
+    } else {
+      static constexpr const char *kMemfds[] = {
+          "/memfd:jit-cache (deleted)", "/memfd:jit-zygote-cache (deleted)",
+          "/dev/ashmem/dalvik-data-code-cache (deleted)",
+          "/memfd:gralloc (deleted)"};
+      layout.Add(1 + layout.Pick(64), "r--s", 0, 0, 1, 5000 + layout.Pick(512),
+                 kMemfds[layout.Pick(std::size(kMemfds))]);
+    }
+  }
+  layout.Add(2, "r-xp", 0, 0, 0, 0, "[vdso]");
+  layout.Add(2048, "rw-p", 0, 0, 0, 0, "[stack]");
+  return maps;
+}
+
+/// \brief Appends the line the kernel prints for \p map, padding the path to
+/// the same column.
+inline void AppendHeader(std::string &out, const Mapping &map) {
+  char line[96];
+  int n = snprintf(line, sizeof(line),
+                   "%08" PRIxPTR "-%08" PRIxPTR " %s %08" PRIxPTR
+                   " %02x:%02x %" PRIu64 " ",
+                   map.start, map.end, map.perms, map.offset, map.major,
+                   map.minor, map.inode);
+  out.append(line, n);
+  if (!map.path.empty()) {
+    if (n < 73)
+      out.append(73 - n, ' ');
+    out += map.path;
+  }
+  out += '\n';
+}
+
+/// \brief The maps file of \p maps.
+inline std::string Maps(const std::vector<Mapping> &maps) {
+  std::string out;
+  out.reserve(maps.size() * 100);
+  for (auto &map : maps)
+    AppendHeader(out, map);
+  return out;
+}
+
+/// \brief The smaps file of \p maps, with every attribute of a 6.1 kernel.
+/// Writable file mappings have dirty private pages.
+inline std::string Smaps(const std::vector<Mapping> &maps) {
+  std::string out;
+  out.reserve(maps.size() * 800);
+  char line[64];
+  auto attribute = [&](const char *name, uint64_t kb) {
+    int n = snprintf(line, sizeof(line), "%-16s%8" PRIu64 " kB\n", name, kb);
+    out.append(line, n);
+  };
+  for (auto &map : maps) {
+    AppendHeader(out, map);
+    uint64_t size = (map.end - map.start) / 1024;
+    bool writable = map.perms[1] == 'w';
+    bool anonymous = map.inode == 0;
+    uint64_t rss = size / 2;
+    uint64_t dirty = writable ? rss / 2 : 0;
+    attribute("Size:", size);
+    attribute("KernelPageSize:", 4);
+    attribute("MMUPageSize:", 4);
+    attribute("Rss:", rss);
+    attribute("Pss:", rss / 2);
+    attribute("Pss_Dirty:", dirty / 2);
+    attribute("Shared_Clean:", rss - dirty);
+    attribute("Shared_Dirty:", 0);
+    attribute("Private_Clean:", 0);
+    attribute("Private_Dirty:", dirty);
+    attribute("Referenced:", rss);
+    attribute("Anonymous:", anonymous || writable ? dirty : 0);
+    attribute("LazyFree:", 0);
+    attribute("AnonHugePages:", 0);
+    attribute("ShmemPmdMapped:", 0);
+    attribute("FilePmdMapped:", 0);
+    attribute("Shared_Hugetlb:", 0);
+    attribute("Private_Hugetlb:", 0);
+    attribute("Swap:", 0);
+    attribute("SwapPss:", 0);
+    attribute("Locked:", 0);
+    out += "THPeligible:    0\nVmFlags: rd ";
+    if (writable)
+      out += "wr ";
+    if (map.perms[2] == 'x')
+      out += "ex ";
+    if (map.perms[3] == 's')
+      out += "sh ";
+    out += "mr mw me ";
+    if (anonymous)
+      out += "ac ";
+    out += '\n';
+  }
+  return out;
+}
+
+} // namespace ProcFixture
@@ -0,0 +1,70 @@
+// Prints binary reports (see binary_report.hpp), e.g. the contents of the
+// report buffer saved by the app, for offline analysis.
+//
+// Usage: report_dump [file...]
+// Without files, scans this process with the maps detectors and prints the
+// report after encoding and parsing it again, followed by the counters of
+// the hot paths when built with DEMO_INSTRUMENTATION.
+#include "binary_report.hpp"
+#include "instrument.hpp"
+#include "scan.hpp"
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+namespace {
+
+bool Print(const char *source, std::span<const char> data) {
+  BinaryReport::View view;
+  if (!view.Parse(data)) {
+    fprintf(stderr, "%s: not a report of version %u\n", source,
+            BinaryReport::kVersion);
+    return false;
+  }
+  auto &header = view.header();
+  printf("%s: generation %llu, %zu detectors, %.3f ms, %u bytes\n", source,
+         (unsigned long long)header.generation, view.size(),
+         header.wall_ns / 1e6, header.total_size);
+  for (size_t i = 0; i < view.size(); i++) {
+    auto record = view.record(i);
+    auto name = view.name(record);
+    auto summary = view.summary(record);
+    printf("  %-16.*s %c %10.3f ms wall %10.3f ms cpu  %.*s\n",
+           (int)name.size(), name.data(),
+           record.flags & BinaryReport::Record::kDetected ? '!' : ' ',
+           record.wall_ns / 1e6, record.cpu_ns / 1e6, (int)summary.size(),
+           summary.data());
+  }
+  return true;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  if (argc < 2) {
+    Scan::Wait(Scan::Request());
+    Scan::Pinned report;
+    std::vector<char> data(BinaryReport::Encode(*report, {}));
+    BinaryReport::Encode(*report, data);
+    if (!Print("self", data))
+      return 1;
+    if (auto summary = Instrument::Summary(); !summary.empty())
+      printf("%s\n", summary.c_str());
+    return 0;
+  }
+  int status = 0;
+  for (int i = 1; i < argc; i++) {
+    std::ifstream file(argv[i], std::ios::binary);
+    std::vector<char> data((std::istreambuf_iterator<char>(file)),
+                           std::istreambuf_iterator<char>());
+    if (!file.good() && !file.eof()) {
+      perror(argv[i]);
+      status = 1;
+      continue;
+    }
+    if (!Print(argv[i], data))
+      status = 1;
+  }
+  return status;
+}
@@ -0,0 +1,194 @@
+// Checks SoList::FindAnomalies() on synthetic soinfo lists laid out like the
+// pools of the linker's block allocator, and times it on 10k soinfos.
+//
+// Usage: soinfo_allocator_harness [iterations]
+// Exits with 1 if any layout is misclassified. The layouts are built as
+// snapshots, so no soinfo memory is needed.
+#include "soinfo_allocator.hpp"
+#include "solist_snapshot.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <utility>
+#include <vector>
+
+using SoList::Anomaly;
+
+namespace {
+
+constexpr size_t kBlock = 0x240;
+constexpr size_t kPoolSize = 100 * 4096;
+constexpr size_t kPerPool = (kPoolSize - 16) / kBlock;
+constexpr size_t kCount = 10000;
+constexpr size_t kNativehelper = 40;
+constexpr size_t kArt = 60;
+
+// The address of the n-th block handed out, with pools mapped 16 MiB apart.
+uintptr_t Slot(size_t n) {
+  return 0x7a0000000000 + n / kPerPool * 0x1000000 + 16 + n % kPerPool * kBlock;
+}
+
+// The allocator mappings of the pools of Slot().
+std::vector<std::pair<uintptr_t, uintptr_t>> Mappings() {
+  std::vector<std::pair<uintptr_t, uintptr_t>> mappings;
+  for (size_t n = 0; n < kCount + kPerPool; n += kPerPool)
+    mappings.emplace_back(Slot(n) - 16, Slot(n) - 16 + kPoolSize);
+  return mappings;
+}
+
+struct Library {
+  uintptr_t address;
+  std::string path;
+  bool has_name = true;
+};
+
+// Libraries in load order, each in the next block.
+std::vector<Library> LoadOrder(size_t count) {
+  std::vector<Library> libraries;
+  for (size_t i = 0; i < count; i++) {
+    std::string name = "libvendor" + std::to_string(i) + ".so";
+    if (i == kNativehelper)
+      name = "libnativehelper.so";
+    else if (i == kArt)
+      name = "libart.so";
+    libraries.push_back({Slot(i), "/system/lib64/" + name});
+  }
+  libraries[0] = {Slot(0), "/system/bin/app_process64", false};
+  return libraries;
+}
+
+SoList::Snapshot Capture(const std::vector<Library> &libraries) {
+  SoList::Snapshot snapshot;
+  for (auto &library : libraries) {
+    auto slash = library.path.rfind('/');
+    std::string name = library.path.substr(slash + 1);
+    snapshot.Append(library.address, 0, library.path.c_str(),
+                    library.has_name ? name.c_str() : nullptr);
+  }
+  return snapshot;
+}
+
+int failures = 0;
+
+void Expect(const char *layout, const std::vector<Library> &libraries,
+            const std::vector<Anomaly> &expected,
+            size_t unload_counter = SIZE_MAX, bool mapped = true) {
+  SoList::AllocatorModel model;
+  model.pool_size = kPoolSize;
+  model.unload_counter = unload_counter;
+  if (mapped)
+    model.mappings = Mappings();
+  auto snapshot = Capture(libraries);
+  auto found = SoList::FindAnomalies(snapshot, model);
+  bool same = SoList::InferBlockSize(snapshot, model) == kBlock &&
+              found.size() == expected.size();
+  for (size_t i = 0; same && i < found.size(); i++) {
+    same = found[i].kind == expected[i].kind &&
+           found[i].confidence == expected[i].confidence &&
+           found[i].address == expected[i].address &&
+           found[i].blocks == expected[i].blocks;
+  }
+  printf("  %-34s %s\n", layout, same ? "ok" : "FAILED");
+  if (!same) {
+    failures++;
+    for (auto &anomaly : found)
+      printf("    kind %d confidence %d at 0x%lx, %zu blocks\n", anomaly.kind,
+             anomaly.confidence, static_cast<unsigned long>(anomaly.address),
+             anomaly.blocks);
+  }
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  int iterations = argc > 1 ? std::max(1, atoi(argv[1])) : 100;
+  printf("%zu soinfos, %zu per pool\n", kCount, kPerPool);
+
+  Expect("clean", LoadOrder(kCount), {});
+  Expect("clean, without the mappings", LoadOrder(kCount), {}, SIZE_MAX,
+         false);
+  Expect("lone soinfo in a new pool", LoadOrder(2 * kPerPool + 1), {});
+
+  auto libraries = LoadOrder(kCount);
+  libraries.erase(libraries.begin() + 20);
+  Expect("unloaded before specialization", libraries,
+         {{Anomaly::kDropped, Anomaly::kHigh, Slot(20), 1}});
+
+  // The free list hands out the block freed last first.
+  libraries = LoadOrder(kCount);
+  libraries.back().address = Slot(5001);
+  libraries.erase(libraries.begin() + 5000, libraries.begin() + 5002);
+  Expect("unloaded, one block reused", libraries,
+         {{Anomaly::kDropped, Anomaly::kLow, Slot(5000), 1}});
+  Expect("more holes than unloads", libraries,
+         {{Anomaly::kDropped, Anomaly::kMedium, Slot(5000), 1}}, 0);
+
+  libraries = LoadOrder(kCount);
+  libraries.erase(libraries.begin() + 3000, libraries.begin() + 3003);
+  Expect("three adjacent unloads", libraries,
+         {{Anomaly::kDropped, Anomaly::kLow, Slot(3000), 3}}, 3);
+
+  // The pools before the last one were full when the next was mapped.
+  libraries = LoadOrder(kCount);
+  libraries.erase(libraries.begin() + kPerPool,
+                  libraries.begin() + kPerPool + 2);
+  Expect("unloaded at the start of a pool", libraries,
+         {{Anomaly::kDropped, Anomaly::kLow, Slot(kPerPool), 2}});
+
+  // Start addresses on the block grid repeat every 64 blocks, so without
+  // the mappings only the part of the hole that every start has is found.
+  libraries = LoadOrder(kCount);
+  libraries.erase(libraries.begin() + kPerPool,
+                  libraries.begin() + kPerPool + 100);
+  Expect("100 unloaded at a pool start", libraries,
+         {{Anomaly::kDropped, Anomaly::kLow, Slot(kPerPool), 100}});
+  Expect("the same, without the mappings", libraries,
+         {{Anomaly::kDropped, Anomaly::kLow, Slot(kPerPool + 64), 36}},
+         SIZE_MAX, false);
+
+  libraries = LoadOrder(kCount);
+  libraries.erase(libraries.begin() + 2 * kPerPool - 2,
+                  libraries.begin() + 2 * kPerPool);
+  Expect("unloaded at the end of a full pool", libraries,
+         {{Anomaly::kDropped, Anomaly::kLow, Slot(2 * kPerPool - 2), 2}});
+  Expect("trailing holes are counted", libraries,
+         {{Anomaly::kDropped, Anomaly::kMedium, Slot(2 * kPerPool - 2), 2}},
+         1);
+
+  libraries = LoadOrder(kCount);
+  libraries.insert(libraries.begin() + 30,
+                   {0x5555000012a0, "/data/local/tmp/libinjected.so"});
+  Expect("soinfo outside the pools", libraries,
+         {{Anomaly::kIsolated, Anomaly::kMedium, 0x5555000012a0, 1}});
+
+  libraries = LoadOrder(kCount);
+  libraries[100].path.clear();
+  libraries[200].has_name = false;
+  Expect("empty path, nameless", libraries,
+         {{Anomaly::kEmptyPath, Anomaly::kHigh, Slot(100), 1},
+          {Anomaly::kNameless, Anomaly::kHigh, Slot(200), 1}});
+
+  // Shuffled list order, as after many unloads and reloads.
+  libraries = LoadOrder(kCount);
+  std::reverse(libraries.begin() + kArt + 1, libraries.end());
+  auto snapshot = Capture(libraries);
+  SoList::AllocatorModel model;
+  model.pool_size = kPoolSize;
+  model.mappings = Mappings();
+  std::vector<double> samples;
+  for (int i = 0; i < iterations; i++) {
+    auto begin = std::chrono::steady_clock::now();
+    auto anomalies = SoList::FindAnomalies(snapshot, model);
+    auto end = std::chrono::steady_clock::now();
+    if (!anomalies.empty())
+      failures++;
+    samples.push_back(
+        std::chrono::duration<double, std::micro>(end - begin).count());
+  }
+  std::sort(samples.begin(), samples.end());
+  printf("  %-34s %.1f us\n", "FindAnomalies, unsorted list",
+         samples[samples.size() / 2]);
+  return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,195 @@
+// Compares the snapshot-then-analyse walk of the soinfo list against the
+// single pass SoList::DetectInjection() made before, on a synthetic list.
+//
+// Usage: solist_bench [iterations] [soinfos]
+// The list mimics the soinfo allocator: soinfos of one size in a contiguous
+// pool, in load order, holding their name and realpath as std::string at the
+// offsets of SoList::SoInfo. The timed list is clean, so both walks visit
+// every soinfo; both must report a soinfo unlinked before libnativehelper.
+#include "solist.hpp"
+#include "solist_snapshot.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+
+using SoList::SoInfo;
+
+namespace {
+
+// The loop SoList::DetectInjection() ran before, kept verbatim apart from
+// taking the head of the list, the casts of gap and dropping the logging.
+SoInfo *LegacyDetect(SoInfo *solinker) {
+  SoInfo *prev = solinker;
+  size_t gap = 0;
+  auto gap_repeated = 0;
+  bool app_process_loaded = false;
+  bool app_specialized = false;
+  const char *libraries_after_specialization[2] = {"libart.so",
+                                                   "libdexfile.so"};
+  bool nativehelper_loaded =
+      false; // Not necessarily loaded after AppSpecialize
+
+  for (auto iter = solinker; iter; iter = iter->get_next()) {
+    // No soinfo has empty path name
+    if (iter->get_path() == NULL || iter->get_path()[0] == '\0') {
+      return iter;
+    }
+
+    if (iter->get_name() == NULL && app_process_loaded) {
+      return iter;
+    }
+
+    if (iter->get_name() == NULL &&
+        strstr(iter->get_path(), "/system/bin/app_proces")) {
+      app_process_loaded = true;
+      continue;
+    }
+
+    if (iter - prev != (ptrdiff_t)gap && gap_repeated < 1) {
+      gap = iter - prev;
+      gap_repeated = 0;
+    } else if (iter - prev == (ptrdiff_t)gap) {
+      gap_repeated++;
+    } else if (iter - prev == 2 * (ptrdiff_t)gap) {
+      // A gap appears, indicating that one library was unloaded
+      auto dropped = (SoInfo *)((uintptr_t)prev + gap);
+
+      if (!nativehelper_loaded || !app_specialized) {
+        // gap cannot appear before libnativehelper is loaded
+        return dropped;
+      }
+    } else {
+      gap_repeated--;
+    }
+
+    auto name = iter->get_name();
+    if (!app_specialized) {
+      for (int i = 0; i < 2; i++) {
+        if (strcmp(name, libraries_after_specialization[i]) == 0) {
+          app_specialized = true;
+          break;
+        }
+      }
+    }
+
+    if (!nativehelper_loaded && strcmp(name, "libnativehelper.so") == 0) {
+      nativehelper_loaded = true;
+    }
+
+    prev = iter;
+  }
+
+  return nullptr;
+}
+
+constexpr size_t kSoInfoSize = 0x240;
+static_assert(kSoInfoSize >= 0x1a0 + sizeof(std::string));
+
+// A pool of soinfos linked in address order, skipping the one at \p dropped
+// if any.
+struct Pool {
+  std::vector<char> memory;
+  size_t count;
+
+  SoInfo *at(size_t i) {
+    return reinterpret_cast<SoInfo *>(memory.data() + i * kSoInfoSize);
+  }
+
+  std::string *field(size_t i, size_t offset) {
+    return reinterpret_cast<std::string *>(
+        reinterpret_cast<char *>(at(i)) + offset);
+  }
+
+  Pool(size_t count, size_t dropped = SIZE_MAX)
+      : memory(count * kSoInfoSize), count(count) {
+    SoInfo *prev = nullptr;
+    for (size_t i = 0; i < count; i++) {
+      std::string name =
+          i == count / 2 ? "libnativehelper.so"
+                         : "libvendor_component_" + std::to_string(i) + ".so";
+      new (field(i, SoInfo::solist_realpath_offset - sizeof(std::string)))
+          std::string(name);
+      new (field(i, SoInfo::solist_realpath_offset))
+          std::string("/system/lib64/" + name);
+      at(i)->set_next(nullptr);
+      if (i == dropped)
+        continue;
+      if (prev != nullptr)
+        prev->set_next(at(i));
+      prev = at(i);
+    }
+  }
+
+  ~Pool() {
+    for (size_t i = 0; i < count; i++) {
+      using std::string;
+      field(i, SoInfo::solist_realpath_offset - sizeof(string))->~string();
+      field(i, SoInfo::solist_realpath_offset)->~string();
+    }
+  }
+};
+
+template <typename F> double MedianUs(int iterations, F &&f) {
+  std::vector<double> samples;
+  for (int i = 0; i < iterations; i++) {
+    auto begin = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    samples.push_back(
+        std::chrono::duration<double, std::micro>(end - begin).count());
+  }
+  std::sort(samples.begin(), samples.end());
+  return samples[samples.size() / 2];
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  int iterations = argc > 1 ? std::max(1, atoi(argv[1])) : 1000;
+  size_t count = argc > 2 ? std::max(4, atoi(argv[2])) : 600;
+  {
+    Pool injected(count, count / 4);
+    auto dropped = reinterpret_cast<uintptr_t>(injected.at(count / 4));
+    SoInfo *head = injected.at(0);
+    if (reinterpret_cast<uintptr_t>(LegacyDetect(head)) != dropped ||
+        SoList::FindInjection(SoList::Snapshot::Capture(head)) != dropped) {
+      fprintf(stderr, "the dropped soinfo was not reported\n");
+      return 1;
+    }
+  }
+
+  Pool pool(count);
+  SoInfo *head = pool.at(0);
+  if (LegacyDetect(head) != nullptr ||
+      SoList::FindInjection(SoList::Snapshot::Capture(head)) != 0) {
+    fprintf(stderr, "the clean list was reported\n");
+    return 1;
+  }
+
+  volatile uintptr_t sink;
+  double legacy = MedianUs(iterations, [&] {
+    sink = reinterpret_cast<uintptr_t>(LegacyDetect(head));
+  });
+  double capture = MedianUs(iterations, [&] {
+    auto snapshot = SoList::Snapshot::Capture(head);
+    sink = snapshot.entries().size();
+  });
+  auto snapshot = SoList::Snapshot::Capture(head);
+  double analyse = MedianUs(iterations, [&] {
+    sink = SoList::FindInjection(snapshot);
+  });
+  (void)sink;
+
+  printf("%zu soinfos\n", count);
+  printf("  %-24s %10s\n", "", "us");
+  printf("  %-24s %10.2f\n", "single pass (before)", legacy);
+  printf("  %-24s %10.2f\n", "capture (linker memory)", capture);
+  printf("  %-24s %10.2f\n", "analyse (snapshot)", analyse);
+  return 0;
+}
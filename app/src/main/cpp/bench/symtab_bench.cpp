@@ -0,0 +1,273 @@
+// Compares the bucketed symbol index of ElfImg against the unordered_map of
+// string_view it replaced, for build time, peak heap, exact lookups and
+// prefix searches.
+//
+// Usage: symtab_bench [iterations] [ELF file...]
+// Without files, the benchmark runs on every object loaded in the host
+// process (its libc, ld.so, libstdc++, ...) and on itself. Objects without a
+// .symtab, such as stripped distribution libraries, are measured on .dynsym.
+#include "symbol_index.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <malloc.h>
+#include <new>
+#include <string>
+#include <string_view>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <unordered_map>
+#include <vector>
+
+static size_t heap_bytes = 0;
+static size_t heap_peak = 0;
+
+void *operator new(size_t size) {
+  if (void *p = malloc(size)) {
+    heap_bytes += malloc_usable_size(p);
+    heap_peak = std::max(heap_peak, heap_bytes);
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+// Not inlined, so that GCC does not match the free() below against the
+// operator new of the caller (-Wmismatched-new-delete).
+[[gnu::noinline]] void operator delete(void *p) noexcept {
+  heap_bytes -= malloc_usable_size(p);
+  free(p);
+}
+
+[[gnu::noinline]] void operator delete(void *p, size_t) noexcept {
+  heap_bytes -= malloc_usable_size(p);
+  free(p);
+}
+
+namespace {
+
+struct SymbolTable {
+  std::string path;
+  const char *section;
+  const ElfW(Sym) *symbols = nullptr;
+  size_t count = 0;
+  const char *strings = nullptr;
+};
+
+// Maps \p path and finds its .symtab, or its .dynsym when stripped. The
+// mapping is kept for the lifetime of the benchmark.
+bool LoadSymbolTable(const std::string &path, SymbolTable &table) {
+  int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0)
+    return false;
+  struct stat st;
+  void *map = MAP_FAILED;
+  if (fstat(fd, &st) == 0 && st.st_size > 0)
+    map = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (map == MAP_FAILED)
+    return false;
+
+  auto *file = static_cast<const char *>(map);
+  auto *header = reinterpret_cast<const ElfW(Ehdr) *>(file);
+  if (memcmp(header->e_ident, ELFMAG, SELFMAG) != 0 ||
+      header->e_ident[EI_CLASS] != ELFCLASS64)
+    return false;
+  auto *sections = reinterpret_cast<const ElfW(Shdr) *>(file + header->e_shoff);
+  const ElfW(Shdr) *best = nullptr;
+  for (int i = 0; i < header->e_shnum; i++) {
+    if (sections[i].sh_type == SHT_SYMTAB ||
+        (sections[i].sh_type == SHT_DYNSYM && best == nullptr))
+      best = &sections[i];
+  }
+  if (best == nullptr)
+    return false;
+  table.path = path;
+  table.section = best->sh_type == SHT_SYMTAB ? ".symtab" : ".dynsym";
+  table.symbols = reinterpret_cast<const ElfW(Sym) *>(file + best->sh_offset);
+  table.count = best->sh_size / sizeof(ElfW(Sym));
+  table.strings = file + sections[best->sh_link].sh_offset;
+  return true;
+}
+
+// The cache ElfImg::LinearLookup() filled before the bucketed index, kept
+// verbatim apart from taking the table and spelling out ELF_ST_TYPE().
+using LegacyIndex = std::unordered_map<std::string_view, const ElfW(Sym) *>;
+
+// With -O3, GCC inlines the operator new above into emplace() and, seeing
+// malloc(), warns about the matching operator delete. The replacements pair
+// up, so the warning is silenced here rather than the code changed.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+void BuildLegacy(const SymbolTable &table, LegacyIndex &symtabs_) {
+  symtabs_.reserve(table.count);
+  for (size_t i = 0; i < table.count; i++) {
+    unsigned int st_type = table.symbols[i].st_info & 0xf;
+    const char *st_name = table.strings + table.symbols[i].st_name;
+    if ((st_type == STT_FUNC || st_type == STT_OBJECT) &&
+        table.symbols[i].st_size) {
+      symtabs_.emplace(st_name, &table.symbols[i]);
+    }
+  }
+}
+#pragma GCC diagnostic pop
+
+template <typename F> double MeasureUs(int iterations, F &&f) {
+  std::vector<double> samples;
+  for (int i = 0; i < iterations; i++) {
+    auto begin = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    samples.push_back(
+        std::chrono::duration<double, std::micro>(end - begin).count());
+  }
+  std::sort(samples.begin(), samples.end());
+  return samples[samples.size() / 2];
+}
+
+void Run(const SymbolTable &table, int iterations) {
+  std::vector<std::string_view> names;
+  for (size_t i = 0; i < table.count; i++) {
+    if (SandHook::SymbolIndex::Indexed(table.symbols[i]))
+      names.emplace_back(table.strings + table.symbols[i].st_name);
+  }
+  // Lookups missing the index are as common as hits on the startup path.
+  std::vector<std::string> misses;
+  for (size_t i = 0; i < names.size(); i++)
+    misses.push_back(std::string(names[i]) + ".missing");
+
+  size_t base = heap_bytes;
+  heap_peak = heap_bytes;
+  size_t legacy_peak = 0;
+  double legacy_build = MeasureUs(iterations, [&] {
+    LegacyIndex index;
+    BuildLegacy(table, index);
+    legacy_peak = heap_peak - base;
+  });
+  heap_peak = heap_bytes;
+  size_t bucketed_peak = 0;
+  double bucketed_build = MeasureUs(iterations, [&] {
+    SandHook::SymbolIndex index;
+    index.Build(table.symbols, table.count, table.strings);
+    bucketed_peak = heap_peak - base;
+  });
+
+  LegacyIndex legacy;
+  BuildLegacy(table, legacy);
+  SandHook::SymbolIndex bucketed;
+  bucketed.Build(table.symbols, table.count, table.strings);
+  for (auto name : names) {
+    if (legacy.find(name)->second != bucketed.Find(name)) {
+      fprintf(stderr, "%s: %.*s resolves differently\n", table.path.c_str(),
+              static_cast<int>(name.size()), name.data());
+      exit(1);
+    }
+  }
+
+  // ElfImg passes the GNU hash it computed for the .gnu.hash lookup.
+  std::vector<uint32_t> name_hashes, miss_hashes;
+  for (auto name : names)
+    name_hashes.push_back(SandHook::SymbolIndex::Hash(name));
+  for (auto &name : misses)
+    miss_hashes.push_back(SandHook::SymbolIndex::Hash(name));
+
+  size_t found = 0;
+  double legacy_lookup = MeasureUs(iterations, [&] {
+    for (auto name : names)
+      found += legacy.count(name);
+    for (auto &name : misses)
+      found += legacy.count(name);
+  });
+  double bucketed_lookup = MeasureUs(iterations, [&] {
+    for (size_t i = 0; i < names.size(); i++)
+      found += bucketed.Find(names[i], name_hashes[i]) != nullptr;
+    for (size_t i = 0; i < misses.size(); i++)
+      found += bucketed.Find(misses[i], miss_hashes[i]) != nullptr;
+  });
+  size_t lookups = names.size() + misses.size();
+
+  // Prefix searches as SoList does for .llvm.<hash> suffixed symbols: the old
+  // cache answered them with a scan in hash order.
+  std::vector<std::string_view> prefixes;
+  for (size_t i = 0; i < names.size(); i += 16)
+    prefixes.push_back(names[i].substr(0, (names[i].size() + 1) / 2));
+  double name_order_build = MeasureUs(iterations, [&] {
+    SandHook::SymbolIndex index;
+    index.Build(table.symbols, table.count, table.strings);
+    index.BuildNameOrder();
+  }) - bucketed_build;
+  bucketed.BuildNameOrder();
+  for (auto prefix : prefixes) {
+    size_t expected = 0;
+    for (auto name : names)
+      expected += name.starts_with(prefix);
+    if (bucketed.FindPrefix(prefix).size() != expected) {
+      fprintf(stderr, "%s: %.*s matches %zu names instead of %zu\n",
+              table.path.c_str(), static_cast<int>(prefix.size()),
+              prefix.data(), bucketed.FindPrefix(prefix).size(), expected);
+      exit(1);
+    }
+  }
+  double legacy_prefix = MeasureUs(iterations, [&] {
+    for (auto prefix : prefixes) {
+      for (auto &symtab : legacy) {
+        if (symtab.first.starts_with(prefix)) {
+          found++;
+          break;
+        }
+      }
+    }
+  });
+  double bucketed_prefix = MeasureUs(iterations, [&] {
+    for (auto prefix : prefixes)
+      found += bucketed.FindPrefix(prefix).size();
+  });
+
+  printf("%s (%s, %zu symbols, %zu indexed)\n", table.path.c_str(),
+         table.section, table.count, names.size());
+  printf("  %-14s %10s %12s %12s %12s\n", "", "build us", "peak KiB",
+         "lookup ns", "prefix ns");
+  printf("  %-14s %10.1f %12.1f %12.1f %12.1f\n", "unordered_map",
+         legacy_build, legacy_peak / 1024.0, legacy_lookup * 1000 / lookups,
+         legacy_prefix * 1000 / prefixes.size());
+  printf("  %-14s %10.1f %12.1f %12.1f %12.1f\n", "bucket index",
+         bucketed_build, bucketed_peak / 1024.0,
+         bucketed_lookup * 1000 / lookups,
+         bucketed_prefix * 1000 / prefixes.size());
+  printf("  %-14s %10.1f\n", "+ name order", name_order_build);
+  // Keeps the lookups from being optimized out.
+  asm volatile("" ::"r"(found));
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  int iterations = argc > 1 ? atoi(argv[1]) : 20;
+  std::vector<std::string> paths;
+  for (int i = 2; i < argc; i++)
+    paths.emplace_back(argv[i]);
+  if (paths.empty()) {
+    dl_iterate_phdr(
+        [](struct dl_phdr_info *info, size_t, void *data) -> int {
+          if (info->dlpi_name != nullptr && info->dlpi_name[0] == '/')
+            static_cast<std::vector<std::string> *>(data)->emplace_back(
+                info->dlpi_name);
+          return 0;
+        },
+        &paths);
+    paths.emplace_back("/proc/self/exe");
+  }
+
+  for (auto &path : paths) {
+    SymbolTable table;
+    if (!LoadSymbolTable(path, table)) {
+      fprintf(stderr, "%s: no symbol table\n", path.c_str());
+      continue;
+    }
+    Run(table, iterations);
+  }
+  return 0;
+}
@@ -0,0 +1,123 @@
+// Checks SandHook::Xz::Decode() on the .xz files of xz_vectors.hpp, and that
+// it rejects every truncation of them and every single bit flip of those
+// with a check, then times it.
+//
+// Usage: xz_harness [iterations]
+// Exits with 1 if any file decodes wrong or corruption goes unnoticed.
+#include "xz.hpp"
+#include "xz_vectors.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Mangled names, as in the .strtab of MiniDebugInfo.
+std::string Text(size_t lines) {
+  std::string text;
+  char line[48];
+  for (size_t i = 0; i < lines; i++) {
+    snprintf(line, sizeof(line), "_ZN7android%zuSymbol%zuEv\n", i % 97,
+             i * 31 % 1009);
+    text += line;
+  }
+  return text;
+}
+
+// Incompressible bytes, which LZMA2 stores as they are.
+std::string Noise(size_t size, uint32_t seed) {
+  std::string noise;
+  for (size_t i = 0; i < size; i++) {
+    seed = seed * 1103515245 + 12345;
+    noise += char(seed >> 24);
+  }
+  return noise;
+}
+
+struct Vector {
+  const char *name;
+  std::span<const uint8_t> xz;
+  std::string data;
+  // Whether the file has a CRC of the data, so that corrupt data is caught.
+  bool checked;
+};
+
+std::span<const char> Chars(std::span<const uint8_t> bytes) {
+  return {reinterpret_cast<const char *>(bytes.data()), bytes.size()};
+}
+
+bool Decodes(std::span<const uint8_t> xz, const std::string &data) {
+  std::vector<char> out;
+  return SandHook::Xz::Decode(Chars(xz), out) &&
+         std::string_view(out.data(), out.size()) == data;
+}
+
+int failures = 0;
+
+void Check(const Vector &vector) {
+  bool same = Decodes(vector.xz, vector.data);
+  // A prefix may be a whole stream of the file, so it only has to not pass
+  // for the file.
+  size_t truncated = 0;
+  for (size_t size = 0; size < vector.xz.size(); size++)
+    truncated += Decodes(vector.xz.first(size), vector.data);
+  // Without a check, a flip in the compressed data may decode to other data.
+  size_t flipped = 0;
+  std::vector<uint8_t> copy(vector.xz.begin(), vector.xz.end());
+  for (size_t i = 0; vector.checked && i < copy.size(); i++) {
+    for (int bit = 0; bit < 8; bit++) {
+      copy[i] ^= 1 << bit;
+      std::vector<char> out;
+      flipped += SandHook::Xz::Decode(Chars(copy), out) &&
+                 std::string_view(out.data(), out.size()) != vector.data;
+      copy[i] ^= 1 << bit;
+    }
+  }
+  bool ok = same && truncated == 0 && flipped == 0;
+  printf("  %-26s %5zu bytes %s\n", vector.name, vector.xz.size(),
+         ok ? "ok" : "FAILED");
+  if (!ok) {
+    failures++;
+    printf("    decodes %d, %zu truncations and %zu flips accepted\n", same,
+           truncated, flipped);
+  }
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  int iterations = argc > 1 ? std::max(1, atoi(argv[1])) : 100;
+  std::string text = Text(400);
+  const Vector vectors[] = {
+      {"CRC64", XzVectors::kCrc64, text, true},
+      {"CRC32, lc=0 lp=4 pb=4", XzVectors::kCrc32Lc0Lp4Pb4, text, true},
+      {"no check, lc=4 lp=0 pb=0", XzVectors::kNoCheckLc4Lp0Pb0, text, false},
+      {"stored chunk", XzVectors::kStoredChunk, Noise(1024, 1), true},
+      {"two streams, padding", XzVectors::kTwoStreams, text + Noise(512, 2),
+       true},
+      {"4 KiB blocks", XzVectors::kBlocks, text, true},
+  };
+  for (auto &vector : vectors)
+    Check(vector);
+
+  std::vector<double> samples;
+  std::vector<char> out;
+  for (int i = 0; i < iterations; i++) {
+    out.clear();
+    auto begin = std::chrono::steady_clock::now();
+    SandHook::Xz::Decode(Chars(XzVectors::kCrc64), out);
+    auto end = std::chrono::steady_clock::now();
+    samples.push_back(
+        std::chrono::duration<double, std::micro>(end - begin).count());
+  }
+  std::sort(samples.begin(), samples.end());
+  double median = samples[samples.size() / 2];
+  printf("  %-26s %.1f us, %.0f MB/s\n", "Decode, CRC64", median,
+         text.size() / median);
+  return failures == 0 ? 0 : 1;
+}
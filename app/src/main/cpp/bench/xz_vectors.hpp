@@ -0,0 +1,581 @@
+#pragma once
+
+#include <cstdint>
+
+// .xz files for xz_harness: kBlocks written by the xz tool, the others by
+// liblzma through the lzma module of Python. See the harness for the data.
+namespace XzVectors {
+
+inline constexpr uint8_t kCrc64[] = {
+    0xfd, 0x37, 0x7a, 0x58, 0x5a, 0x00, 0x00, 0x04, 0xe6, 0xd6, 0xb4, 0x46,
+    0x02, 0x00, 0x21, 0x01, 0x16, 0x00, 0x00, 0x00, 0x74, 0x2f, 0xe5, 0xa3,
+    0xe0, 0x26, 0xb3, 0x02, 0xcb, 0x5d, 0x00, 0x2f, 0x96, 0x85, 0xdd, 0x9c,
+    0xcd, 0x14, 0x00, 0x0e, 0xe0, 0x6f, 0xb6, 0xac, 0xc4, 0x0d, 0x7c, 0xf7,
+    0xc2, 0x27, 0x7f, 0x68, 0x7e, 0xe8, 0x4c, 0x5a, 0x5e, 0x79, 0x3b, 0xff,
+    0x73, 0x7d, 0xa4, 0x1f, 0x6d, 0x65, 0x27, 0xe1, 0x3f, 0x16, 0x51, 0x8d,
+    0x2f, 0xa6, 0xc5, 0xc0, 0x63, 0x59, 0x9e, 0x8e, 0xa3, 0x42, 0x4e, 0x76,
+    0xfe, 0xaf, 0x3f, 0x44, 0x6c, 0x1c, 0xb9, 0x2a, 0x0c, 0xdc, 0x18, 0x74,
+    0xb7, 0xf2, 0xfb, 0xa2, 0x39, 0x51, 0xb6, 0xd1, 0xcb, 0x0e, 0xd2, 0x0d,
+    0x75, 0xb9, 0x5a, 0x2a, 0xa5, 0x35, 0xbb, 0x4c, 0x21, 0xd5, 0x56, 0x98,
+    0xbb, 0x7e, 0xf9, 0x55, 0x1e, 0x85, 0xe5, 0xab, 0xd3, 0xe1, 0xe5, 0x76,
+    0x2f, 0x8b, 0x5f, 0x75, 0xe9, 0x99, 0x60, 0x7c, 0x29, 0xcb, 0xdb, 0xf4,
+    0x79, 0x42, 0x3f, 0xe4, 0xbe, 0xf6, 0xdd, 0xfe, 0xfa, 0x81, 0x41, 0x5d,
+    0xc2, 0xd7, 0x20, 0xae, 0x9f, 0x14, 0xc4, 0x1a, 0x81, 0x2d, 0x65, 0x29,
+    0xd0, 0xe3, 0x49, 0x11, 0x6f, 0x58, 0x95, 0x10, 0x03, 0xad, 0x39, 0xd0,
+    0x33, 0x6d, 0x25, 0x89, 0x81, 0xce, 0x4c, 0xcf, 0x4c, 0x13, 0x75, 0xba,
+    0x9b, 0x64, 0x2e, 0xab, 0x58, 0x17, 0x44, 0x78, 0x0c, 0xaf, 0xd9, 0xbd,
+    0x0d, 0xa1, 0x46, 0x67, 0xf6, 0xc2, 0xb2, 0x92, 0x06, 0xd0, 0xa5, 0x77,
+    0x71, 0x3c, 0xfd, 0xe8, 0x77, 0x95, 0x55, 0x87, 0x60, 0x32, 0x57, 0x64,
+    0x03, 0x0e, 0xc0, 0xe3, 0x08, 0x5a, 0x8c, 0x2a, 0x38, 0xd0, 0x13, 0xdf,
+    0xad, 0x05, 0x05, 0xae, 0xe0, 0xc1, 0xa1, 0xca, 0xbe, 0x9a, 0x7c, 0xc9,
+    0x23, 0x5a, 0x3a, 0xce, 0x10, 0xd4, 0x26, 0xa9, 0x49, 0x74, 0x0e, 0x2f,
+    0x1d, 0x97, 0x75, 0xbb, 0x80, 0x2b, 0x51, 0x30, 0xeb, 0x06, 0x9b, 0x67,
+    0x59, 0x67, 0xfa, 0xa7, 0xea, 0xa3, 0xe8, 0xb2, 0xde, 0x48, 0x12, 0x0a,
+    0xf9, 0x0c, 0x81, 0xaf, 0xca, 0xee, 0x57, 0x12, 0xbf, 0xab, 0x5c, 0x6e,
+    0x21, 0x84, 0x87, 0xcd, 0x41, 0x33, 0x84, 0x4b, 0x36, 0x0c, 0xbd, 0x80,
+    0x55, 0x12, 0x56, 0x89, 0xc7, 0x72, 0xae, 0x88, 0xeb, 0x35, 0xad, 0xa5,
+    0xc9, 0xfb, 0x05, 0xa4, 0xa0, 0x31, 0xf3, 0x2b, 0xa9, 0xec, 0x81, 0xe9,
+    0x8b, 0x13, 0x67, 0x37, 0x3a, 0xed, 0x0a, 0xf7, 0x50, 0x66, 0xc5, 0x1d,
+    0xa1, 0x42, 0x53, 0x3c, 0x99, 0xd0, 0xcf, 0x49, 0xd7, 0x19, 0xfd, 0x23,
+    0x43, 0xca, 0x3d, 0x87, 0x63, 0x6b, 0x15, 0x09, 0x7a, 0xa6, 0x18, 0x96,
+    0x02, 0xdf, 0xbb, 0xf2, 0x24, 0xf1, 0xe8, 0x8c, 0x0b, 0xac, 0x88, 0x82,
+    0x26, 0x58, 0xe2, 0x9b, 0xb6, 0x12, 0x87, 0x1f, 0xd1, 0x34, 0xdb, 0x4f,
+    0x45, 0xdf, 0x8f, 0x60, 0xe5, 0x87, 0xe5, 0x35, 0x7c, 0xa5, 0x51, 0xc4,
+    0xab, 0x49, 0xa6, 0x59, 0x7e, 0x72, 0xec, 0x78, 0x93, 0xa9, 0x80, 0x6e,
+    0xc9, 0xa8, 0xf5, 0xb5, 0x79, 0xf2, 0x88, 0x9b, 0x14, 0x5b, 0xdb, 0x35,
+    0x39, 0xc8, 0xff, 0xf6, 0x83, 0x3d, 0x17, 0x0e, 0xd0, 0xf8, 0x36, 0xd6,
+    0x4a, 0x64, 0x25, 0x05, 0xc5, 0xc7, 0xc2, 0x13, 0xe2, 0x0a, 0xe5, 0xb8,
+    0x30, 0xeb, 0xbf, 0xfa, 0xba, 0x0c, 0x75, 0x74, 0x12, 0x98, 0x67, 0xd9,
+    0x9d, 0xf8, 0xee, 0xd2, 0xaf, 0xa4, 0xa5, 0x93, 0x48, 0xa4, 0x32, 0xfb,
+    0x88, 0x5d, 0x6d, 0xf4, 0x94, 0xf7, 0x20, 0xfb, 0xa2, 0x3a, 0xe2, 0x9d,
+    0x60, 0xdb, 0x76, 0x4e, 0xb4, 0x4a, 0x0c, 0x78, 0x0c, 0x34, 0xf0, 0x33,
+    0xb9, 0x60, 0xf0, 0xb9, 0x93, 0x8e, 0x45, 0x3a, 0x04, 0x60, 0x7e, 0x51,
+    0x1b, 0x9b, 0x80, 0xe6, 0x61, 0xc2, 0xe8, 0x80, 0x44, 0x1b, 0x27, 0x81,
+    0xd2, 0xf9, 0x91, 0x02, 0x92, 0xc7, 0xc9, 0x83, 0x6a, 0x25, 0xa3, 0x19,
+    0xf4, 0xd1, 0xd4, 0x0a, 0x3a, 0x9f, 0xc5, 0x11, 0x83, 0x18, 0x15, 0x43,
+    0xb6, 0x02, 0x54, 0x56, 0x16, 0x79, 0x87, 0x7d, 0xf6, 0x8b, 0x09, 0x9c,
+    0xa8, 0x61, 0x90, 0xb8, 0x33, 0xbe, 0xcf, 0xf7, 0xaf, 0xdf, 0x67, 0xcb,
+    0x99, 0x35, 0xf8, 0xd0, 0x1e, 0x31, 0xc6, 0x2d, 0x10, 0x42, 0x31, 0xda,
+    0xe1, 0x24, 0xec, 0x5f, 0xc5, 0x58, 0xaa, 0x03, 0x76, 0x81, 0xab, 0x2c,
+    0x54, 0x03, 0xe7, 0x58, 0x53, 0x38, 0xd0, 0x53, 0xcc, 0xf6, 0x19, 0x76,
+    0xf0, 0x97, 0xa2, 0xf7, 0xfd, 0x1c, 0x96, 0x64, 0x66, 0xf0, 0x07, 0x29,
+    0x67, 0x91, 0x5a, 0xde, 0xfb, 0xda, 0x65, 0x79, 0x85, 0x19, 0x1a, 0xa5,
+    0xe7, 0x2c, 0x00, 0x4c, 0x25, 0xc9, 0x16, 0x97, 0xa3, 0x50, 0x49, 0x24,
+    0x53, 0x4d, 0x9a, 0xed, 0xcb, 0x05, 0x63, 0xf9, 0xa7, 0x67, 0xe9, 0x0f,
+    0xfa, 0xc5, 0x30, 0xb9, 0xb8, 0xc2, 0xbd, 0x32, 0x6e, 0x33, 0xf6, 0x31,
+    0x2e, 0x81, 0x0f, 0x7a, 0xa5, 0xcf, 0x94, 0x4b, 0xa2, 0xf0, 0x51, 0x92,
+    0x56, 0x63, 0xef, 0x1b, 0x4c, 0xa2, 0x39, 0x90, 0x9b, 0xc1, 0xa1, 0x8a,
+    0xe9, 0x69, 0xe1, 0xc3, 0x5f, 0x66, 0xeb, 0xa0, 0xaf, 0x3f, 0x3e, 0x42,
+    0x62, 0x30, 0x58, 0xdf, 0x48, 0x10, 0x00, 0xe3, 0x89, 0x29, 0x84, 0x08,
+    0x16, 0xb6, 0xa1, 0x52, 0x21, 0x48, 0x3e, 0xf8, 0x60, 0xe7, 0x28, 0x03,
+    0x15, 0x3b, 0x71, 0x6e, 0x30, 0x66, 0xbc, 0x86, 0x7f, 0xad, 0x6b, 0x95,
+    0x97, 0x00, 0x00, 0x00, 0x97, 0x7a, 0xcb, 0xaf, 0x60, 0x47, 0x29, 0x2c,
+    0x00, 0x01, 0xe7, 0x05, 0xb4, 0x4d, 0x00, 0x00, 0xc9, 0xb7, 0xa6, 0xea,
+    0xb1, 0xc4, 0x67, 0xfb, 0x02, 0x00, 0x00, 0x00, 0x00, 0x04, 0x59, 0x5a,
+};
+
+inline constexpr uint8_t kCrc32Lc0Lp4Pb4[] = {
+    0xfd, 0x37, 0x7a, 0x58, 0x5a, 0x00, 0x00, 0x01, 0x69, 0x22, 0xde, 0x36,
+    0x02, 0x00, 0x21, 0x01, 0x16, 0x00, 0x00, 0x00, 0x74, 0x2f, 0xe5, 0xa3,
+    0xe0, 0x26, 0xb3, 0x03, 0xdb, 0xd8, 0x00, 0x2f, 0x96, 0x85, 0xc3, 0x73,
+    0x09, 0xb8, 0xc8, 0x72, 0x37, 0x9a, 0x4c, 0x83, 0x02, 0x99, 0xe4, 0xda,
+    0x62, 0x3b, 0x26, 0xa7, 0x91, 0x3a, 0x6d, 0x72, 0x39, 0x14, 0x16, 0x0e,
+    0x79, 0xf0, 0x9e, 0x73, 0x2f, 0x29, 0x34, 0x9b, 0x30, 0x4b, 0xf2, 0xcd,
+    0x99, 0x5c, 0xdd, 0x52, 0xc2, 0x05, 0x33, 0x79, 0xdc, 0xb7, 0x5c, 0xd6,
+    0xaa, 0x6e, 0x7d, 0x44, 0x22, 0x3c, 0x4e, 0x94, 0xce, 0xab, 0xc7, 0x75,
+    0x75, 0x72, 0x9b, 0x81, 0xdb, 0xb0, 0x84, 0xe2, 0x88, 0x2d, 0x31, 0x04,
+    0x89, 0xe7, 0x5d, 0x7c, 0xae, 0x71, 0x86, 0xc4, 0x1b, 0x63, 0x9f, 0xdc,
+    0x3b, 0x4e, 0x0d, 0xba, 0xd8, 0x60, 0xa4, 0x51, 0x30, 0x13, 0x19, 0xd6,
+    0x66, 0xc7, 0x8c, 0x1e, 0x9e, 0xfa, 0x2c, 0x79, 0xc8, 0x12, 0xe6, 0xca,
+    0x9a, 0x9f, 0x64, 0x90, 0x78, 0x7c, 0xe7, 0xf8, 0x91, 0xdf, 0x0c, 0x4f,
+    0xd3, 0xb6, 0x28, 0x86, 0x9a, 0x07, 0x59, 0xa1, 0xd7, 0xcc, 0x59, 0x06,
+    0x7a, 0x81, 0xc1, 0x17, 0xb4, 0x12, 0xd6, 0x92, 0xc0, 0x87, 0x34, 0x94,
+    0x9f, 0x5b, 0xa9, 0x8c, 0x76, 0x57, 0xca, 0xee, 0xbb, 0x4b, 0xe4, 0xd3,
+    0xf6, 0x4c, 0xc0, 0xf3, 0x9e, 0x37, 0x6c, 0xb9, 0x9a, 0x7a, 0xfb, 0xbe,
+    0x1a, 0x0c, 0x6d, 0x96, 0x08, 0xfa, 0xf8, 0xed, 0xfa, 0x1f, 0xa4, 0xc4,
+    0x53, 0xf6, 0x59, 0x18, 0x1b, 0xad, 0xc7, 0x70, 0xc3, 0x93, 0x00, 0x2f,
+    0x25, 0x5c, 0xae, 0x4a, 0x26, 0xbd, 0x5f, 0x49, 0x1d, 0x32, 0x15, 0x90,
+    0x61, 0x1c, 0x26, 0x96, 0x5e, 0x6b, 0xc0, 0xe9, 0x96, 0x1c, 0xb7, 0xfc,
+    0x20, 0xdf, 0xe8, 0xbb, 0x84, 0x2b, 0xf2, 0x23, 0x74, 0x10, 0x12, 0x72,
+    0x5f, 0x90, 0x1a, 0x20, 0x83, 0x38, 0xd5, 0xb5, 0x7b, 0xad, 0xc0, 0x14,
+    0xd7, 0x53, 0x37, 0x5e, 0x11, 0xf4, 0xd6, 0x2e, 0xb8, 0x67, 0xb3, 0x73,
+    0x3d, 0x2c, 0x5c, 0x6f, 0xe6, 0x19, 0x55, 0xca, 0x8d, 0xe0, 0x63, 0x00,
+    0xeb, 0x52, 0xbc, 0xe3, 0x7f, 0x9b, 0x2e, 0x2b, 0x45, 0x7a, 0x30, 0xb8,
+    0xfa, 0xf3, 0x56, 0x1b, 0x17, 0xbd, 0xe0, 0xe8, 0xff, 0x27, 0xd0, 0x88,
+    0x34, 0xd5, 0xef, 0x8d, 0xd2, 0xcf, 0x06, 0x40, 0x7f, 0x46, 0x72, 0x29,
+    0x46, 0xf5, 0xee, 0x47, 0x45, 0xd3, 0x2d, 0x21, 0x57, 0xb1, 0xe9, 0x82,
+    0x55, 0xa5, 0x8e, 0xa0, 0xd0, 0x16, 0x23, 0x9f, 0x04, 0x57, 0xee, 0x0f,
+    0xa0, 0x98, 0xf6, 0x1a, 0x28, 0xdf, 0x58, 0x3f, 0xde, 0xe3, 0x6e, 0x83,
+    0x87, 0x70, 0x0a, 0x9c, 0xc2, 0xea, 0xa7, 0x38, 0x88, 0x05, 0x36, 0x29,
+    0x11, 0xa0, 0x7f, 0xcb, 0x9e, 0x63, 0x81, 0x6d, 0xd0, 0xcc, 0x1d, 0x48,
+    0xfe, 0xb0, 0xe5, 0xcd, 0x55, 0x5b, 0x6a, 0x0b, 0xce, 0xaf, 0xe6, 0xcb,
+    0x44, 0x82, 0xbe, 0xa9, 0xf0, 0x52, 0xc7, 0xde, 0xf6, 0xe1, 0xb5, 0xa5,
+    0x7c, 0xa9, 0x83, 0x94, 0x1b, 0x18, 0x6e, 0xb9, 0x8a, 0x20, 0xd7, 0x2e,
+    0x81, 0x21, 0xe0, 0x79, 0xeb, 0x45, 0x0e, 0x23, 0x45, 0x5e, 0x8a, 0xad,
+    0xd0, 0xe8, 0xa7, 0x22, 0x4d, 0x54, 0x03, 0xf4, 0x0b, 0x72, 0xb0, 0x98,
+    0xe5, 0x90, 0xe9, 0x47, 0x6c, 0xc4, 0xfb, 0x39, 0x14, 0x51, 0xf0, 0x82,
+    0xd3, 0x92, 0x67, 0xa1, 0x9f, 0x22, 0x9c, 0x43, 0x79, 0xa9, 0x0d, 0xfe,
+    0x73, 0x65, 0xe1, 0xfe, 0x08, 0x48, 0xc6, 0xce, 0xe7, 0xe5, 0x05, 0x2b,
+    0x1b, 0x0d, 0x21, 0x89, 0x2e, 0x59, 0xe5, 0xa9, 0x60, 0xf7, 0x90, 0x5a,
+    0xf4, 0x69, 0xab, 0x83, 0xd2, 0x0a, 0x5a, 0x56, 0x3f, 0x5b, 0x00, 0x62,
+    0x62, 0xe0, 0x6c, 0xab, 0x25, 0x58, 0x51, 0xd6, 0xab, 0xfc, 0x99, 0x43,
+    0x1a, 0x7b, 0x86, 0x13, 0xe0, 0xc8, 0x42, 0x01, 0x7d, 0xef, 0x54, 0x76,
+    0x09, 0x9b, 0xb0, 0xa8, 0x5d, 0x1b, 0x44, 0x81, 0xef, 0x2d, 0x35, 0x3a,
+    0xcd, 0x9b, 0xeb, 0x79, 0x03, 0xb6, 0xcd, 0xf8, 0x09, 0x27, 0x73, 0x3c,
+    0xb2, 0x93, 0xce, 0x0d, 0x89, 0xff, 0x7b, 0x71, 0xf8, 0xf1, 0x94, 0x54,
+    0xf3, 0x7d, 0xe8, 0xde, 0x8f, 0x3d, 0xb8, 0x21, 0x35, 0x48, 0x0c, 0xfb,
+    0x97, 0x3f, 0xf1, 0x28, 0x6d, 0xa8, 0xb9, 0x75, 0x97, 0x6c, 0xae, 0xb2,
+    0x77, 0xbc, 0x0e, 0x38, 0xa3, 0xff, 0x8d, 0x08, 0xb3, 0x4a, 0x3c, 0x6f,
+    0xa4, 0xbd, 0xf6, 0xa4, 0x96, 0xd8, 0x22, 0x89, 0xc1, 0x5a, 0x74, 0xd6,
+    0x19, 0x6a, 0x1b, 0x81, 0x06, 0xb9, 0x69, 0xe4, 0xd8, 0xd6, 0xa8, 0xf8,
+    0x27, 0x09, 0x13, 0x00, 0x35, 0xf9, 0x97, 0x46, 0x61, 0x84, 0x1e, 0xa0,
+    0x0f, 0xa8, 0x64, 0x67, 0xb8, 0x1f, 0xc5, 0x70, 0xaa, 0xcb, 0xdc, 0x5e,
+    0x1d, 0xc6, 0x94, 0x77, 0xde, 0x23, 0x5d, 0xad, 0xe0, 0xac, 0xcb, 0xff,
+    0x13, 0xa4, 0x42, 0x1f, 0xb3, 0xc9, 0x46, 0x73, 0xd6, 0x82, 0x93, 0x15,
+    0x94, 0xa7, 0x69, 0x5f, 0x96, 0xb3, 0x64, 0x7a, 0xb8, 0x79, 0x58, 0xf4,
+    0xdd, 0xf6, 0x04, 0x6c, 0x1b, 0x8a, 0xc3, 0xc3, 0xd4, 0x8c, 0x05, 0xcf,
+    0x48, 0xb2, 0xd6, 0x87, 0x45, 0x7f, 0x00, 0x48, 0x1c, 0xd6, 0x61, 0x19,
+    0xbe, 0xca, 0x76, 0x75, 0xbd, 0x06, 0xa7, 0x9e, 0x3b, 0x8e, 0x0e, 0xd7,
+    0x2e, 0xa1, 0x0e, 0x58, 0x2c, 0x5f, 0x72, 0xe6, 0xf2, 0x73, 0x73, 0xac,
+    0x08, 0x38, 0xe0, 0x78, 0x28, 0x34, 0x2d, 0xe2, 0x18, 0x72, 0x40, 0xcd,
+    0xea, 0xec, 0x5b, 0xb8, 0x16, 0xd4, 0x84, 0x32, 0x21, 0x35, 0xcc, 0xac,
+    0xdd, 0xca, 0x92, 0x3b, 0xb8, 0x5f, 0x9d, 0x12, 0x69, 0x9c, 0x7a, 0x01,
+    0x98, 0xd7, 0x33, 0xee, 0xba, 0x3e, 0xef, 0x38, 0x9b, 0x23, 0x98, 0x72,
+    0x93, 0x86, 0x6c, 0x77, 0x2b, 0x51, 0xff, 0x0b, 0x78, 0x5f, 0x2a, 0x98,
+    0x2d, 0x07, 0x77, 0x9d, 0xf3, 0xa3, 0xa8, 0xde, 0x75, 0x34, 0x75, 0x79,
+    0x6e, 0xac, 0x32, 0x70, 0x35, 0xee, 0xd8, 0x8e, 0x72, 0x33, 0xb0, 0x56,
+    0xec, 0xfe, 0x40, 0x1a, 0xc4, 0xeb, 0xa2, 0x71, 0xd0, 0xeb, 0xd9, 0xe1,
+    0x4b, 0x57, 0x37, 0x0d, 0xf1, 0x14, 0xb8, 0x2f, 0x78, 0xe5, 0xba, 0xe3,
+    0xa2, 0x22, 0x7e, 0xbd, 0x1c, 0xf5, 0x9b, 0x17, 0xbd, 0x7b, 0x0e, 0x2d,
+    0xf1, 0x66, 0x8f, 0x3f, 0x11, 0x5c, 0x97, 0xe2, 0x19, 0x17, 0xaf, 0xfd,
+    0x91, 0x00, 0xd5, 0x3e, 0xa9, 0x77, 0x00, 0x2c, 0xee, 0x5a, 0x44, 0xe6,
+    0x6a, 0xc0, 0x82, 0x67, 0x6c, 0x58, 0x89, 0xb4, 0xcf, 0xd6, 0xe2, 0x1f,
+    0xb4, 0x21, 0x9e, 0x50, 0xd0, 0x35, 0x46, 0xf0, 0x31, 0x7e, 0xcf, 0x94,
+    0x39, 0x8a, 0xa5, 0x4b, 0x22, 0x1e, 0xcb, 0xe4, 0xd2, 0x47, 0x6b, 0x20,
+    0xa5, 0xfc, 0x58, 0x93, 0x30, 0xa7, 0x64, 0xe0, 0xf4, 0x8a, 0x00, 0x25,
+    0x9e, 0x11, 0x69, 0x1f, 0x2e, 0x9e, 0x5b, 0x76, 0x7a, 0x88, 0x41, 0x9c,
+    0x6b, 0x4e, 0x17, 0x26, 0xdc, 0x53, 0x76, 0xa2, 0x85, 0x34, 0x62, 0x11,
+    0xbf, 0x37, 0x1a, 0x1f, 0xa9, 0xc6, 0x6b, 0x40, 0xf9, 0xc7, 0x48, 0xb0,
+    0x67, 0xb1, 0xa3, 0xd9, 0x1a, 0xb1, 0x18, 0xf6, 0x3e, 0x22, 0x31, 0x58,
+    0xa8, 0x3f, 0x64, 0x0d, 0xb7, 0xdd, 0x1e, 0xc4, 0xef, 0xea, 0x68, 0xe4,
+    0x20, 0x41, 0xf5, 0x61, 0xb5, 0xf5, 0xf1, 0xdd, 0x94, 0x1e, 0x46, 0x24,
+    0x1d, 0x30, 0xe5, 0x28, 0xc6, 0x58, 0x8a, 0xcd, 0xe4, 0x00, 0x00, 0x00,
+    0xc8, 0x20, 0x50, 0xf3, 0x00, 0x01, 0xf3, 0x07, 0xb4, 0x4d, 0x00, 0x00,
+    0x24, 0xa4, 0x21, 0x08, 0x3e, 0x30, 0x0d, 0x8b, 0x02, 0x00, 0x00, 0x00,
+    0x00, 0x01, 0x59, 0x5a,
+};
+
+inline constexpr uint8_t kNoCheckLc4Lp0Pb0[] = {
+    0xfd, 0x37, 0x7a, 0x58, 0x5a, 0x00, 0x00, 0x00, 0xff, 0x12, 0xd9, 0x41,
+    0x02, 0x00, 0x21, 0x01, 0x16, 0x00, 0x00, 0x00, 0x74, 0x2f, 0xe5, 0xa3,
+    0xe0, 0x26, 0xb3, 0x03, 0x53, 0x04, 0x00, 0x2f, 0x97, 0x3a, 0xcd, 0x26,
+    0x3b, 0xad, 0xc9, 0xf2, 0xbf, 0x8f, 0xf9, 0xce, 0xab, 0xc2, 0x1f, 0xf1,
+    0x05, 0x56, 0xac, 0xbd, 0x2e, 0x28, 0xa1, 0xcf, 0x5f, 0x64, 0x15, 0xee,
+    0xba, 0xca, 0xe6, 0x4a, 0xa7, 0x0d, 0x48, 0xd0, 0x6e, 0x7e, 0x50, 0x02,
+    0x87, 0x88, 0x62, 0xf9, 0xba, 0x11, 0x67, 0x22, 0xd4, 0x96, 0xe4, 0xf6,
+    0x4b, 0xc6, 0xa5, 0xb7, 0x01, 0xce, 0x11, 0xb5, 0xf2, 0x9a, 0xa4, 0xf3,
+    0x5b, 0xcb, 0xd1, 0xde, 0xc4, 0x9f, 0x6a, 0x67, 0x70, 0xac, 0xf6, 0xde,
+    0x93, 0x0c, 0x3e, 0x42, 0xc5, 0xcd, 0xe7, 0x43, 0x1c, 0x21, 0x48, 0x3d,
+    0xbc, 0x7e, 0xbf, 0x40, 0xfb, 0xef, 0xb7, 0x49, 0xf9, 0xbb, 0x86, 0xf3,
+    0x0d, 0x47, 0xa4, 0x4a, 0x8a, 0x25, 0x8f, 0x36, 0xa8, 0x5b, 0x66, 0xc9,
+    0x91, 0x0f, 0xee, 0x38, 0x72, 0xb4, 0xf6, 0x9f, 0xab, 0xf0, 0x35, 0xaf,
+    0x7a, 0xf9, 0x5b, 0xd0, 0xdb, 0xec, 0xba, 0x5e, 0x09, 0xbb, 0x0d, 0x8a,
+    0x25, 0xf8, 0x61, 0x17, 0x31, 0xb1, 0xeb, 0x56, 0xf5, 0xd1, 0xc6, 0x3e,
+    0x64, 0x4e, 0xe8, 0xe5, 0x29, 0x91, 0xd9, 0x96, 0x32, 0x3d, 0xe1, 0xa8,
+    0xf4, 0x23, 0xb7, 0x15, 0x05, 0x78, 0xb5, 0xb2, 0xa8, 0xf3, 0xc5, 0x1e,
+    0xac, 0xff, 0xe7, 0x6c, 0x68, 0xad, 0x7d, 0xb9, 0x33, 0x5f, 0x9f, 0x61,
+    0x30, 0xd7, 0x3e, 0x68, 0xf0, 0xdd, 0x0a, 0xc3, 0xa9, 0x67, 0xa5, 0x0c,
+    0x91, 0xa4, 0xd5, 0xd1, 0xb0, 0x6a, 0xad, 0x5d, 0xed, 0x77, 0x91, 0xf0,
+    0xf6, 0x64, 0xf6, 0xf3, 0x51, 0x2b, 0xde, 0xd6, 0x62, 0x48, 0x75, 0xee,
+    0xc6, 0x8b, 0x79, 0x33, 0xde, 0xde, 0x5a, 0x11, 0x2d, 0x61, 0xe0, 0x97,
+    0x6a, 0x79, 0xaa, 0xe2, 0x9d, 0xf6, 0x24, 0xfb, 0xcb, 0x89, 0xd5, 0xfd,
+    0xcd, 0x5f, 0x9b, 0xe5, 0xa1, 0x56, 0x64, 0xe0, 0x7f, 0xc8, 0xe7, 0x8d,
+    0x85, 0x90, 0xd8, 0x4d, 0x2e, 0x27, 0x16, 0x73, 0x48, 0x47, 0xd5, 0xc6,
+    0x07, 0xdb, 0x32, 0x33, 0x3b, 0x02, 0x39, 0x5f, 0x4a, 0xf0, 0x3e, 0x61,
+    0x97, 0x6f, 0x5e, 0x82, 0x7c, 0xf9, 0x61, 0xe0, 0x22, 0x83, 0x02, 0x07,
+    0x4a, 0xc6, 0xfe, 0x2e, 0x8d, 0x5b, 0xe2, 0x96, 0xa8, 0xb2, 0x21, 0x73,
+    0x15, 0xff, 0x69, 0xc3, 0xe2, 0x7b, 0x50, 0x3a, 0x13, 0xb3, 0x94, 0xd0,
+    0x0a, 0xb0, 0x72, 0x2c, 0xa0, 0xf2, 0x16, 0x01, 0x24, 0x5d, 0xa6, 0xef,
+    0x96, 0xa3, 0x2d, 0x1f, 0x56, 0x98, 0x34, 0xbb, 0x7c, 0x32, 0xea, 0xf7,
+    0xb0, 0xbc, 0x75, 0xd1, 0xb9, 0xc6, 0x71, 0x38, 0x75, 0x5b, 0x46, 0xf9,
+    0x81, 0x89, 0x62, 0x18, 0x56, 0x13, 0xce, 0xb0, 0xf9, 0x10, 0xd2, 0xeb,
+    0x95, 0xa0, 0xbc, 0x35, 0x94, 0x96, 0xff, 0x69, 0xe1, 0xa3, 0xf3, 0xe1,
+    0xd3, 0x36, 0x8b, 0x2c, 0xc3, 0xb7, 0x10, 0x48, 0x47, 0xec, 0xe9, 0x5d,
+    0xa3, 0xc5, 0x54, 0x4a, 0x3d, 0x7e, 0x6f, 0x95, 0x04, 0xf2, 0x14, 0x03,
+    0xc6, 0x14, 0xe1, 0x7c, 0x45, 0x83, 0x1c, 0x6a, 0x52, 0x84, 0xc1, 0x99,
+    0x27, 0xf8, 0x1d, 0x33, 0x3d, 0x4b, 0x47, 0x61, 0xe4, 0xaa, 0xad, 0x5a,
+    0xfa, 0x3e, 0x7c, 0xb0, 0x1e, 0xcd, 0x1b, 0xc4, 0x24, 0x31, 0x39, 0x5e,
+    0x74, 0x45, 0x8f, 0xfb, 0x3e, 0xd3, 0x2d, 0x5e, 0x5c, 0x5b, 0xdc, 0xd1,
+    0xd0, 0x69, 0xdf, 0x41, 0x0d, 0x96, 0xc2, 0xaa, 0xde, 0x51, 0x63, 0xd7,
+    0x0f, 0xc3, 0xb1, 0x24, 0x8c, 0x6a, 0x22, 0x7d, 0x28, 0x6a, 0xcb, 0x5e,
+    0xa2, 0xf3, 0x51, 0x91, 0x25, 0x21, 0x3f, 0x11, 0x7c, 0x91, 0x2a, 0x38,
+    0xad, 0x1f, 0x78, 0xa2, 0x0a, 0xed, 0x78, 0x6a, 0xfa, 0xd9, 0x6b, 0xe3,
+    0x05, 0xee, 0x62, 0x01, 0xa9, 0x7d, 0xfa, 0x66, 0x20, 0x6f, 0x32, 0x47,
+    0x74, 0xd5, 0x2d, 0x7c, 0x90, 0xb9, 0x07, 0xd8, 0xb9, 0x48, 0x95, 0xf6,
+    0x7b, 0x05, 0x70, 0xfd, 0xd4, 0x37, 0xc4, 0x09, 0x9a, 0x27, 0x1a, 0xb8,
+    0x1e, 0x84, 0x8c, 0x27, 0x3b, 0x73, 0xf5, 0x7d, 0xbd, 0x90, 0xbd, 0x36,
+    0xc4, 0xbd, 0x54, 0x68, 0x94, 0x8c, 0x0c, 0x53, 0x68, 0x3a, 0x0e, 0x4e,
+    0x93, 0x1f, 0xa5, 0xb3, 0xfe, 0xd2, 0xaf, 0xa6, 0x2b, 0x06, 0x44, 0xb4,
+    0xa0, 0x5c, 0x44, 0x7c, 0xe5, 0x09, 0xd2, 0x7b, 0x10, 0xa3, 0x2c, 0x78,
+    0xdb, 0xbe, 0x9a, 0xf4, 0xd2, 0x46, 0xb2, 0x98, 0xd5, 0xa0, 0xf0, 0xd9,
+    0x45, 0xd6, 0xbb, 0x1c, 0x2b, 0xdf, 0x97, 0xba, 0x91, 0xcf, 0xa6, 0x8e,
+    0x1c, 0xe4, 0xa1, 0x2a, 0xf4, 0x67, 0x13, 0xdc, 0x83, 0x04, 0x6a, 0x72,
+    0x95, 0x26, 0x12, 0x9a, 0x79, 0xa4, 0xcf, 0x8c, 0x1a, 0xa9, 0x5c, 0x1d,
+    0x06, 0xb4, 0x01, 0x29, 0x01, 0x7d, 0x27, 0xfe, 0x4f, 0x5d, 0xe3, 0x24,
+    0x45, 0xd6, 0xb9, 0xf7, 0xd1, 0x10, 0x8a, 0xf8, 0xe6, 0x63, 0x5c, 0x6c,
+    0x56, 0xd9, 0x0d, 0x5a, 0xdb, 0x3d, 0x4a, 0x8c, 0x1d, 0x6c, 0x50, 0xbd,
+    0x61, 0x7f, 0xaf, 0xcf, 0x5f, 0xb1, 0x5a, 0x00, 0x46, 0xf1, 0x1f, 0x91,
+    0x56, 0x24, 0xb5, 0x51, 0xb2, 0xf7, 0x19, 0xbe, 0x29, 0x5f, 0x02, 0x33,
+    0xab, 0x57, 0xce, 0x9e, 0xb1, 0x11, 0x96, 0x03, 0xfd, 0x5f, 0x83, 0x82,
+    0x50, 0xa0, 0x56, 0x30, 0x9f, 0xac, 0xb8, 0x1b, 0x66, 0x9c, 0xc6, 0x9a,
+    0x71, 0x68, 0xf1, 0x31, 0x17, 0xc9, 0xa4, 0xab, 0x93, 0x1c, 0x94, 0x23,
+    0x00, 0xbd, 0xf0, 0x88, 0x13, 0xb1, 0xf0, 0xde, 0x04, 0xb8, 0x45, 0x19,
+    0x4d, 0xf5, 0x43, 0x62, 0xcc, 0x9e, 0x12, 0x9b, 0xc1, 0x8d, 0xcc, 0x38,
+    0xac, 0xb0, 0x7a, 0x3f, 0xeb, 0x14, 0xe1, 0x16, 0x76, 0x56, 0xe3, 0x3e,
+    0x75, 0x15, 0x79, 0xf8, 0x00, 0xc8, 0x64, 0x91, 0xdb, 0x32, 0x13, 0xa3,
+    0x00, 0x3d, 0xd1, 0x1b, 0x1e, 0xdf, 0x0b, 0x1f, 0x22, 0x8c, 0xb2, 0x87,
+    0x7f, 0x2f, 0xf5, 0x29, 0xcb, 0x80, 0x1b, 0xed, 0xb9, 0xa6, 0x50, 0x00,
+    0x2f, 0x93, 0x5b, 0x8e, 0x5b, 0xd8, 0x42, 0xd2, 0x39, 0x04, 0x39, 0xa3,
+    0x1f, 0x32, 0x9f, 0x1b, 0x32, 0xed, 0xcd, 0x68, 0xca, 0x0a, 0x02, 0x72,
+    0xfa, 0xbe, 0x30, 0x36, 0x83, 0x37, 0x0a, 0x83, 0x8b, 0xc1, 0x7a, 0xc5,
+    0x8f, 0x3b, 0x77, 0xcb, 0x78, 0x97, 0x95, 0xd0, 0x17, 0xba, 0xa0, 0xb7,
+    0x9c, 0x55, 0x57, 0xd9, 0x3a, 0x00, 0x00, 0x00, 0x00, 0x01, 0xe7, 0x06,
+    0xb4, 0x4d, 0x00, 0x00, 0x19, 0xcd, 0x06, 0xad, 0xa8, 0x00, 0x0a, 0xfc,
+    0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x59, 0x5a,
+};
+
+inline constexpr uint8_t kStoredChunk[] = {
+    0xfd, 0x37, 0x7a, 0x58, 0x5a, 0x00, 0x00, 0x01, 0x69, 0x22, 0xde, 0x36,
+    0x02, 0x00, 0x21, 0x01, 0x16, 0x00, 0x00, 0x00, 0x74, 0x2f, 0xe5, 0xa3,
+    0x01, 0x03, 0xff, 0x41, 0x96, 0x27, 0xc4, 0xf9, 0x95, 0xd9, 0x9c, 0xbf,
+    0x0f, 0x0a, 0x31, 0x23, 0xaf, 0x7d, 0xc4, 0xe2, 0xd2, 0xe2, 0xe3, 0xe9,
+    0x93, 0x50, 0x28, 0x2c, 0x75, 0x42, 0xb3, 0x4d, 0xe4, 0xf7, 0xef, 0xee,
+    0x56, 0xe1, 0xca, 0x31, 0xad, 0x99, 0x69, 0xb5, 0x3b, 0x7d, 0x10, 0x1b,
+    0x7a, 0xde, 0xb4, 0xe3, 0x61, 0x7a, 0x83, 0x28, 0xe0, 0x9f, 0x4b, 0x85,
+    0xfa, 0x28, 0x87, 0x38, 0x75, 0x49, 0x8f, 0x48, 0x20, 0xbf, 0x1e, 0x3d,
+    0x33, 0xef, 0x36, 0xad, 0x30, 0x05, 0x14, 0xc2, 0x59, 0x0c, 0xb3, 0x62,
+    0x9f, 0xab, 0x1d, 0xa6, 0xa6, 0xf1, 0x84, 0xd3, 0x33, 0x56, 0xdd, 0xf8,
+    0x1d, 0xeb, 0x7b, 0xe3, 0xb7, 0x56, 0xe7, 0x14, 0x23, 0x11, 0xee, 0xe0,
+    0x1a, 0x11, 0xa5, 0xe6, 0x1c, 0xc8, 0xdb, 0x99, 0xfe, 0x20, 0x37, 0x60,
+    0x6e, 0xf2, 0xfd, 0xb2, 0xb7, 0x10, 0x3a, 0x1e, 0xfe, 0xd3, 0xcd, 0x1e,
+    0xba, 0xe5, 0x8a, 0x3c, 0x13, 0x9f, 0x78, 0xce, 0x7e, 0x3d, 0xe6, 0x5f,
+    0xb0, 0xbd, 0xc3, 0x8c, 0xcc, 0x2c, 0x92, 0xe3, 0x5b, 0xb9, 0xda, 0x0c,
+    0x7b, 0xc6, 0xde, 0x4a, 0x51, 0xe4, 0x18, 0x26, 0xa4, 0x57, 0xa5, 0xc8,
+    0x35, 0xa7, 0xb8, 0x48, 0x3e, 0x4d, 0xb5, 0x10, 0x20, 0x84, 0x7d, 0x0e,
+    0x30, 0xd2, 0x2c, 0x46, 0x2d, 0xc8, 0x3c, 0x14, 0xce, 0x16, 0xc7, 0x25,
+    0x6f, 0xea, 0x6c, 0xf2, 0xcc, 0x45, 0x15, 0x53, 0x58, 0xa1, 0x8d, 0x68,
+    0x98, 0x36, 0xad, 0xeb, 0x91, 0xa1, 0x96, 0xbd, 0x30, 0xc0, 0x40, 0x2d,
+    0x43, 0x0f, 0x42, 0x4d, 0x5d, 0xc7, 0xac, 0x66, 0xcb, 0xa2, 0x55, 0x46,
+    0x64, 0xf1, 0xf1, 0x08, 0xe6, 0x74, 0xd2, 0x95, 0x26, 0x15, 0x24, 0xeb,
+    0x44, 0x84, 0x1a, 0x02, 0xad, 0x4f, 0x42, 0xc5, 0x93, 0xe9, 0x04, 0x83,
+    0x30, 0xce, 0x02, 0xd0, 0xf5, 0xaf, 0xdd, 0xb2, 0x7d, 0x4c, 0x8e, 0x9c,
+    0xe6, 0x6f, 0x5e, 0x81, 0xde, 0x35, 0x2e, 0x1a, 0x97, 0x89, 0x8e, 0x14,
+    0x64, 0x85, 0xe5, 0xcc, 0xb3, 0x1d, 0x97, 0xce, 0xaa, 0x4d, 0xfb, 0x30,
+    0x97, 0xa6, 0x86, 0x92, 0x01, 0xf1, 0x7a, 0x50, 0xfa, 0x50, 0x05, 0x2c,
+    0x12, 0x0d, 0x99, 0x8a, 0x03, 0xf9, 0xf5, 0xf4, 0xee, 0x13, 0x15, 0x88,
+    0xd3, 0xde, 0x0d, 0x94, 0x8c, 0x8f, 0x83, 0x61, 0x7a, 0x03, 0x52, 0x0d,
+    0xb6, 0x27, 0x82, 0xf1, 0x61, 0x41, 0x95, 0xe1, 0x70, 0x3f, 0xf0, 0x5e,
+    0x1e, 0x06, 0xcd, 0x70, 0xc0, 0x56, 0xfe, 0xcd, 0xbf, 0xcb, 0x72, 0x85,
+    0xf1, 0x0d, 0x42, 0x4a, 0x81, 0x31, 0xbd, 0x18, 0x41, 0xe3, 0xad, 0xd9,
+    0xf4, 0xd5, 0xda, 0x36, 0x02, 0x9b, 0x79, 0xc0, 0x98, 0xd2, 0x10, 0x21,
+    0x2b, 0x5a, 0x04, 0xfa, 0xe0, 0xef, 0xd1, 0x9f, 0x51, 0x6c, 0x9e, 0xdc,
+    0xab, 0x86, 0xbe, 0x72, 0x1f, 0xc3, 0x3f, 0xed, 0x2c, 0x0f, 0x9b, 0x0e,
+    0x2e, 0x1a, 0x37, 0xea, 0x41, 0x68, 0x34, 0x6f, 0x5b, 0xd2, 0xca, 0xfa,
+    0x3b, 0xc2, 0x2d, 0x29, 0x81, 0x7d, 0xb7, 0x16, 0x14, 0x44, 0xca, 0xa8,
+    0xab, 0x14, 0xb7, 0x9f, 0x19, 0x5c, 0x9c, 0x98, 0xb6, 0xe3, 0xea, 0x1f,
+    0x00, 0xc1, 0x2c, 0x8a, 0x5a, 0x21, 0x2c, 0x44, 0x6f, 0x26, 0x8a, 0xba,
+    0xb0, 0x3b, 0x6a, 0x03, 0xf3, 0x99, 0xd1, 0x10, 0x1e, 0xcc, 0xd2, 0xeb,
+    0x6b, 0x94, 0x9b, 0x4f, 0xb7, 0x48, 0x0b, 0xb0, 0xdc, 0xc1, 0x65, 0x71,
+    0x0c, 0x54, 0x46, 0xdd, 0xb9, 0x6b, 0xe3, 0x31, 0x6a, 0xd0, 0x4f, 0xb8,
+    0x9c, 0x9f, 0x3f, 0xcf, 0x89, 0x91, 0x87, 0x5c, 0x6c, 0xfc, 0x54, 0xfa,
+    0xac, 0xc9, 0xd2, 0xfa, 0xf6, 0x37, 0xcb, 0xec, 0x34, 0x25, 0x6c, 0x53,
+    0xf3, 0x4c, 0x31, 0xbc, 0x98, 0x90, 0xbb, 0x58, 0x7f, 0x5c, 0xfd, 0xd5,
+    0xdc, 0xb0, 0x0a, 0x06, 0x03, 0x46, 0x7e, 0xab, 0x6b, 0x10, 0x30, 0x65,
+    0x8c, 0xe0, 0xc2, 0x93, 0x6d, 0xfa, 0x30, 0xc1, 0x8f, 0xef, 0x6b, 0xd3,
+    0x7d, 0xfb, 0xc0, 0x12, 0x26, 0xc3, 0x6f, 0xde, 0xe1, 0x26, 0xcb, 0x8b,
+    0xb1, 0x8f, 0xcc, 0xc2, 0x26, 0xf4, 0xd6, 0x64, 0xf6, 0x64, 0x2e, 0xc7,
+    0x30, 0xe3, 0x5f, 0xd0, 0x9f, 0xe8, 0x81, 0x3b, 0xb9, 0xbf, 0x29, 0x1f,
+    0x39, 0xb2, 0x75, 0x70, 0x40, 0x9a, 0x74, 0x18, 0x96, 0x60, 0xee, 0xe8,
+    0x6b, 0x76, 0x2d, 0x79, 0xab, 0x57, 0x6d, 0xb6, 0xd3, 0x9f, 0x05, 0xb2,
+    0xcf, 0x36, 0x61, 0x06, 0x48, 0xb4, 0x80, 0xc7, 0x7c, 0xf1, 0x6b, 0xe1,
+    0x7b, 0x61, 0xef, 0x67, 0x6c, 0xae, 0x8e, 0x16, 0x23, 0xc7, 0x5c, 0x30,
+    0x3c, 0x3a, 0x58, 0x59, 0x87, 0x98, 0x66, 0x27, 0x68, 0x43, 0xf4, 0x90,
+    0x83, 0xde, 0x09, 0x5b, 0xcd, 0x39, 0x29, 0x50, 0xf2, 0x78, 0x5e, 0xbc,
+    0x89, 0xd9, 0x54, 0x8e, 0x95, 0x3f, 0x47, 0x21, 0x56, 0x77, 0x47, 0x77,
+    0x58, 0xe2, 0x03, 0x7a, 0x4e, 0xe8, 0x1e, 0x81, 0x1c, 0x6f, 0xc4, 0x3a,
+    0x2a, 0x2a, 0x04, 0xa9, 0xe0, 0x8d, 0x22, 0xea, 0xe0, 0xb0, 0xe3, 0xde,
+    0x62, 0x66, 0x8b, 0xf0, 0xc2, 0x68, 0x0b, 0xa1, 0x30, 0x3f, 0x9c, 0x82,
+    0x02, 0x68, 0xc2, 0xcf, 0x25, 0xc2, 0x70, 0xce, 0xa9, 0x53, 0xcc, 0xa4,
+    0x5b, 0xf7, 0xd6, 0x4d, 0x00, 0x6c, 0xdb, 0xe3, 0x89, 0xef, 0x83, 0x4e,
+    0x68, 0x50, 0xf2, 0x35, 0xd3, 0x1e, 0x29, 0xa3, 0xa0, 0x70, 0xbc, 0xbb,
+    0x08, 0x60, 0x83, 0x8d, 0x7d, 0x2e, 0xcd, 0xc4, 0x56, 0xb9, 0x52, 0xd0,
+    0x12, 0xb0, 0xd6, 0xc1, 0x63, 0xb8, 0x47, 0xf7, 0x47, 0x5f, 0xc7, 0x5e,
+    0xe2, 0x97, 0xe1, 0xcc, 0xe0, 0x1d, 0xe6, 0xd1, 0x8f, 0xfe, 0x34, 0xfa,
+    0xf6, 0x22, 0xd0, 0x5a, 0xa1, 0x83, 0xa9, 0xe6, 0xdd, 0x8f, 0x6c, 0xed,
+    0xa7, 0xcc, 0xa9, 0xb4, 0x7d, 0xb3, 0xd0, 0x10, 0xdb, 0x70, 0x34, 0x78,
+    0x17, 0xf5, 0x15, 0xea, 0xdd, 0x7d, 0x72, 0xa3, 0x7f, 0x7f, 0x18, 0x81,
+    0xe6, 0xb0, 0x2c, 0x93, 0xc4, 0x86, 0x30, 0x25, 0x67, 0x61, 0x37, 0x58,
+    0x44, 0x51, 0xcf, 0x0e, 0x16, 0x1c, 0xd1, 0xaf, 0x35, 0xec, 0x1a, 0x2b,
+    0x72, 0xe9, 0xeb, 0x23, 0xa1, 0x84, 0x66, 0x21, 0xad, 0x48, 0x65, 0x62,
+    0xc5, 0x7d, 0xb1, 0x73, 0x10, 0xda, 0x3c, 0xc5, 0xf1, 0x30, 0x03, 0xe5,
+    0xc9, 0xb6, 0xa1, 0x05, 0xc8, 0x61, 0xc2, 0x06, 0x29, 0x7a, 0x07, 0x20,
+    0xfe, 0x5c, 0xf5, 0xee, 0x57, 0xff, 0x1e, 0x6d, 0x7b, 0xca, 0x7a, 0x30,
+    0x6c, 0xc5, 0xc0, 0xe6, 0xf5, 0x2e, 0x25, 0xf0, 0x03, 0x09, 0xca, 0x98,
+    0xf7, 0x1e, 0xd6, 0x35, 0x3c, 0x96, 0xea, 0x4b, 0x55, 0x1c, 0x7f, 0x68,
+    0x25, 0x35, 0x59, 0x5a, 0x1c, 0x2d, 0x13, 0xfd, 0xa2, 0xdd, 0x84, 0xb4,
+    0xdf, 0x19, 0x6c, 0x54, 0xb3, 0x8c, 0xaf, 0x13, 0x86, 0x5b, 0x1d, 0xc4,
+    0x3d, 0xcc, 0x77, 0x65, 0x83, 0xc7, 0x38, 0xdb, 0x32, 0xf4, 0x56, 0x5a,
+    0x7a, 0xd5, 0xff, 0xca, 0x33, 0x09, 0x08, 0x33, 0x57, 0xa7, 0x89, 0x03,
+    0xa2, 0x5e, 0xeb, 0xaf, 0xd7, 0xbc, 0x56, 0x06, 0x1d, 0xda, 0x49, 0x36,
+    0x7f, 0x4a, 0xcf, 0x5e, 0x73, 0xf4, 0x90, 0x2b, 0x05, 0x59, 0xbd, 0xd1,
+    0xfd, 0x5b, 0x86, 0x74, 0x23, 0x7e, 0xad, 0xbb, 0x73, 0x4e, 0x5a, 0x2e,
+    0xe6, 0x4e, 0x3f, 0x9c, 0x29, 0xa8, 0xb8, 0x95, 0x5d, 0x80, 0x70, 0xd5,
+    0xbd, 0x9a, 0xc1, 0x15, 0xc6, 0xc0, 0xc8, 0x99, 0x3b, 0x12, 0xf5, 0x92,
+    0x25, 0x2d, 0x7f, 0x06, 0xa9, 0xd5, 0x11, 0xe1, 0x4b, 0x8d, 0x92, 0x73,
+    0x06, 0x4b, 0xdb, 0x65, 0x4a, 0x2f, 0xc5, 0x00, 0xb0, 0x7c, 0x48, 0x1f,
+    0x00, 0x01, 0x94, 0x08, 0x80, 0x08, 0x00, 0x00, 0xca, 0x2c, 0x98, 0x96,
+    0x3e, 0x30, 0x0d, 0x8b, 0x02, 0x00, 0x00, 0x00, 0x00, 0x01, 0x59, 0x5a,
+};
+
+inline constexpr uint8_t kTwoStreams[] = {
+    0xfd, 0x37, 0x7a, 0x58, 0x5a, 0x00, 0x00, 0x04, 0xe6, 0xd6, 0xb4, 0x46,
+    0x02, 0x00, 0x21, 0x01, 0x16, 0x00, 0x00, 0x00, 0x74, 0x2f, 0xe5, 0xa3,
+    0xe0, 0x26, 0xb3, 0x02, 0xcb, 0x5d, 0x00, 0x2f, 0x96, 0x85, 0xdd, 0x9c,
+    0xcd, 0x14, 0x00, 0x0e, 0xe0, 0x6f, 0xb6, 0xac, 0xc4, 0x0d, 0x7c, 0xf7,
+    0xc2, 0x27, 0x7f, 0x68, 0x7e, 0xe8, 0x4c, 0x5a, 0x5e, 0x79, 0x3b, 0xff,
+    0x73, 0x7d, 0xa4, 0x1f, 0x6d, 0x65, 0x27, 0xe1, 0x3f, 0x16, 0x51, 0x8d,
+    0x2f, 0xa6, 0xc5, 0xc0, 0x63, 0x59, 0x9e, 0x8e, 0xa3, 0x42, 0x4e, 0x76,
+    0xfe, 0xaf, 0x3f, 0x44, 0x6c, 0x1c, 0xb9, 0x2a, 0x0c, 0xdc, 0x18, 0x74,
+    0xb7, 0xf2, 0xfb, 0xa2, 0x39, 0x51, 0xb6, 0xd1, 0xcb, 0x0e, 0xd2, 0x0d,
+    0x75, 0xb9, 0x5a, 0x2a, 0xa5, 0x35, 0xbb, 0x4c, 0x21, 0xd5, 0x56, 0x98,
+    0xbb, 0x7e, 0xf9, 0x55, 0x1e, 0x85, 0xe5, 0xab, 0xd3, 0xe1, 0xe5, 0x76,
+    0x2f, 0x8b, 0x5f, 0x75, 0xe9, 0x99, 0x60, 0x7c, 0x29, 0xcb, 0xdb, 0xf4,
+    0x79, 0x42, 0x3f, 0xe4, 0xbe, 0xf6, 0xdd, 0xfe, 0xfa, 0x81, 0x41, 0x5d,
+    0xc2, 0xd7, 0x20, 0xae, 0x9f, 0x14, 0xc4, 0x1a, 0x81, 0x2d, 0x65, 0x29,
+    0xd0, 0xe3, 0x49, 0x11, 0x6f, 0x58, 0x95, 0x10, 0x03, 0xad, 0x39, 0xd0,
+    0x33, 0x6d, 0x25, 0x89, 0x81, 0xce, 0x4c, 0xcf, 0x4c, 0x13, 0x75, 0xba,
+    0x9b, 0x64, 0x2e, 0xab, 0x58, 0x17, 0x44, 0x78, 0x0c, 0xaf, 0xd9, 0xbd,
+    0x0d, 0xa1, 0x46, 0x67, 0xf6, 0xc2, 0xb2, 0x92, 0x06, 0xd0, 0xa5, 0x77,
+    0x71, 0x3c, 0xfd, 0xe8, 0x77, 0x95, 0x55, 0x87, 0x60, 0x32, 0x57, 0x64,
+    0x03, 0x0e, 0xc0, 0xe3, 0x08, 0x5a, 0x8c, 0x2a, 0x38, 0xd0, 0x13, 0xdf,
+    0xad, 0x05, 0x05, 0xae, 0xe0, 0xc1, 0xa1, 0xca, 0xbe, 0x9a, 0x7c, 0xc9,
+    0x23, 0x5a, 0x3a, 0xce, 0x10, 0xd4, 0x26, 0xa9, 0x49, 0x74, 0x0e, 0x2f,
+    0x1d, 0x97, 0x75, 0xbb, 0x80, 0x2b, 0x51, 0x30, 0xeb, 0x06, 0x9b, 0x67,
+    0x59, 0x67, 0xfa, 0xa7, 0xea, 0xa3, 0xe8, 0xb2, 0xde, 0x48, 0x12, 0x0a,
+    0xf9, 0x0c, 0x81, 0xaf, 0xca, 0xee, 0x57, 0x12, 0xbf, 0xab, 0x5c, 0x6e,
+    0x21, 0x84, 0x87, 0xcd, 0x41, 0x33, 0x84, 0x4b, 0x36, 0x0c, 0xbd, 0x80,
+    0x55, 0x12, 0x56, 0x89, 0xc7, 0x72, 0xae, 0x88, 0xeb, 0x35, 0xad, 0xa5,
+    0xc9, 0xfb, 0x05, 0xa4, 0xa0, 0x31, 0xf3, 0x2b, 0xa9, 0xec, 0x81, 0xe9,
+    0x8b, 0x13, 0x67, 0x37, 0x3a, 0xed, 0x0a, 0xf7, 0x50, 0x66, 0xc5, 0x1d,
+    0xa1, 0x42, 0x53, 0x3c, 0x99, 0xd0, 0xcf, 0x49, 0xd7, 0x19, 0xfd, 0x23,
+    0x43, 0xca, 0x3d, 0x87, 0x63, 0x6b, 0x15, 0x09, 0x7a, 0xa6, 0x18, 0x96,
+    0x02, 0xdf, 0xbb, 0xf2, 0x24, 0xf1, 0xe8, 0x8c, 0x0b, 0xac, 0x88, 0x82,
+    0x26, 0x58, 0xe2, 0x9b, 0xb6, 0x12, 0x87, 0x1f, 0xd1, 0x34, 0xdb, 0x4f,
+    0x45, 0xdf, 0x8f, 0x60, 0xe5, 0x87, 0xe5, 0x35, 0x7c, 0xa5, 0x51, 0xc4,
+    0xab, 0x49, 0xa6, 0x59, 0x7e, 0x72, 0xec, 0x78, 0x93, 0xa9, 0x80, 0x6e,
+    0xc9, 0xa8, 0xf5, 0xb5, 0x79, 0xf2, 0x88, 0x9b, 0x14, 0x5b, 0xdb, 0x35,
+    0x39, 0xc8, 0xff, 0xf6, 0x83, 0x3d, 0x17, 0x0e, 0xd0, 0xf8, 0x36, 0xd6,
+    0x4a, 0x64, 0x25, 0x05, 0xc5, 0xc7, 0xc2, 0x13, 0xe2, 0x0a, 0xe5, 0xb8,
+    0x30, 0xeb, 0xbf, 0xfa, 0xba, 0x0c, 0x75, 0x74, 0x12, 0x98, 0x67, 0xd9,
+    0x9d, 0xf8, 0xee, 0xd2, 0xaf, 0xa4, 0xa5, 0x93, 0x48, 0xa4, 0x32, 0xfb,
+    0x88, 0x5d, 0x6d, 0xf4, 0x94, 0xf7, 0x20, 0xfb, 0xa2, 0x3a, 0xe2, 0x9d,
+    0x60, 0xdb, 0x76, 0x4e, 0xb4, 0x4a, 0x0c, 0x78, 0x0c, 0x34, 0xf0, 0x33,
+    0xb9, 0x60, 0xf0, 0xb9, 0x93, 0x8e, 0x45, 0x3a, 0x04, 0x60, 0x7e, 0x51,
+    0x1b, 0x9b, 0x80, 0xe6, 0x61, 0xc2, 0xe8, 0x80, 0x44, 0x1b, 0x27, 0x81,
+    0xd2, 0xf9, 0x91, 0x02, 0x92, 0xc7, 0xc9, 0x83, 0x6a, 0x25, 0xa3, 0x19,
+    0xf4, 0xd1, 0xd4, 0x0a, 0x3a, 0x9f, 0xc5, 0x11, 0x83, 0x18, 0x15, 0x43,
+    0xb6, 0x02, 0x54, 0x56, 0x16, 0x79, 0x87, 0x7d, 0xf6, 0x8b, 0x09, 0x9c,
+    0xa8, 0x61, 0x90, 0xb8, 0x33, 0xbe, 0xcf, 0xf7, 0xaf, 0xdf, 0x67, 0xcb,
+    0x99, 0x35, 0xf8, 0xd0, 0x1e, 0x31, 0xc6, 0x2d, 0x10, 0x42, 0x31, 0xda,
+    0xe1, 0x24, 0xec, 0x5f, 0xc5, 0x58, 0xaa, 0x03, 0x76, 0x81, 0xab, 0x2c,
+    0x54, 0x03, 0xe7, 0x58, 0x53, 0x38, 0xd0, 0x53, 0xcc, 0xf6, 0x19, 0x76,
+    0xf0, 0x97, 0xa2, 0xf7, 0xfd, 0x1c, 0x96, 0x64, 0x66, 0xf0, 0x07, 0x29,
+    0x67, 0x91, 0x5a, 0xde, 0xfb, 0xda, 0x65, 0x79, 0x85, 0x19, 0x1a, 0xa5,
+    0xe7, 0x2c, 0x00, 0x4c, 0x25, 0xc9, 0x16, 0x97, 0xa3, 0x50, 0x49, 0x24,
+    0x53, 0x4d, 0x9a, 0xed, 0xcb, 0x05, 0x63, 0xf9, 0xa7, 0x67, 0xe9, 0x0f,
+    0xfa, 0xc5, 0x30, 0xb9, 0xb8, 0xc2, 0xbd, 0x32, 0x6e, 0x33, 0xf6, 0x31,
+    0x2e, 0x81, 0x0f, 0x7a, 0xa5, 0xcf, 0x94, 0x4b, 0xa2, 0xf0, 0x51, 0x92,
+    0x56, 0x63, 0xef, 0x1b, 0x4c, 0xa2, 0x39, 0x90, 0x9b, 0xc1, 0xa1, 0x8a,
+    0xe9, 0x69, 0xe1, 0xc3, 0x5f, 0x66, 0xeb, 0xa0, 0xaf, 0x3f, 0x3e, 0x42,
+    0x62, 0x30, 0x58, 0xdf, 0x48, 0x10, 0x00, 0xe3, 0x89, 0x29, 0x84, 0x08,
+    0x16, 0xb6, 0xa1, 0x52, 0x21, 0x48, 0x3e, 0xf8, 0x60, 0xe7, 0x28, 0x03,
+    0x15, 0x3b, 0x71, 0x6e, 0x30, 0x66, 0xbc, 0x86, 0x7f, 0xad, 0x6b, 0x95,
+    0x97, 0x00, 0x00, 0x00, 0x97, 0x7a, 0xcb, 0xaf, 0x60, 0x47, 0x29, 0x2c,
+    0x00, 0x01, 0xe7, 0x05, 0xb4, 0x4d, 0x00, 0x00, 0xc9, 0xb7, 0xa6, 0xea,
+    0xb1, 0xc4, 0x67, 0xfb, 0x02, 0x00, 0x00, 0x00, 0x00, 0x04, 0x59, 0x5a,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xfd, 0x37, 0x7a, 0x58,
+    0x5a, 0x00, 0x00, 0x01, 0x69, 0x22, 0xde, 0x36, 0x02, 0x00, 0x21, 0x01,
+    0x16, 0x00, 0x00, 0x00, 0x74, 0x2f, 0xe5, 0xa3, 0x01, 0x01, 0xff, 0x83,
+    0x59, 0xa7, 0xb2, 0xe4, 0x69, 0x75, 0x6c, 0xcf, 0xff, 0x65, 0xfa, 0xb0,
+    0x38, 0xa9, 0x23, 0x45, 0xbf, 0x08, 0x82, 0x02, 0x86, 0x46, 0xf4, 0xdb,
+    0x40, 0xcc, 0x8c, 0x3c, 0x32, 0xec, 0x7a, 0xd8, 0xe0, 0xa2, 0x4d, 0xa1,
+    0xa8, 0x9b, 0x81, 0x0e, 0x4f, 0xfe, 0x35, 0x84, 0x1b, 0x2c, 0x9a, 0x81,
+    0xe8, 0x81, 0x54, 0xe7, 0x72, 0xbc, 0xe6, 0x7d, 0xad, 0xa2, 0xfc, 0x8a,
+    0xe1, 0x07, 0x05, 0x1e, 0xfa, 0x40, 0x8c, 0x6d, 0x2d, 0xb8, 0x3d, 0x4c,
+    0xe8, 0x25, 0x71, 0xbd, 0xaf, 0x9d, 0xd2, 0x19, 0x5e, 0x7b, 0x50, 0x34,
+    0xf4, 0xdc, 0x8a, 0xa2, 0xd1, 0x2d, 0x64, 0xeb, 0x1c, 0x04, 0x63, 0x52,
+    0xb6, 0x3e, 0x0f, 0x93, 0xe3, 0x22, 0x77, 0x9a, 0xa4, 0x07, 0x91, 0x2e,
+    0x59, 0xb4, 0x13, 0x17, 0x27, 0x73, 0xfd, 0x25, 0x4b, 0x9d, 0xfb, 0x2d,
+    0x3e, 0x18, 0x50, 0xe0, 0x5f, 0xfa, 0xe4, 0x0d, 0x8f, 0x55, 0xc3, 0xbc,
+    0xde, 0xef, 0x12, 0x29, 0x49, 0x4d, 0x46, 0x86, 0x27, 0x64, 0x33, 0x23,
+    0xb3, 0xdf, 0x2e, 0x50, 0xe1, 0xb2, 0x63, 0x1c, 0x6f, 0x89, 0x14, 0xc6,
+    0xd0, 0x39, 0x63, 0x82, 0x6c, 0x3b, 0xe1, 0xec, 0x5d, 0xef, 0xfb, 0x45,
+    0x88, 0x19, 0x0a, 0x50, 0xd5, 0xde, 0x93, 0x7d, 0xde, 0x33, 0x02, 0xa5,
+    0x4d, 0x89, 0xf5, 0x86, 0xcc, 0x22, 0xd3, 0xd6, 0x3e, 0x4f, 0x48, 0x82,
+    0xa1, 0xa0, 0xee, 0x83, 0xcf, 0xb0, 0x2e, 0x54, 0x01, 0x0d, 0x27, 0xf4,
+    0xcb, 0x8c, 0x21, 0x06, 0xf4, 0xde, 0xe4, 0x74, 0x52, 0x4d, 0xf3, 0xa3,
+    0xaa, 0x00, 0x7a, 0x25, 0x29, 0x06, 0x85, 0x7a, 0xec, 0x33, 0xba, 0x3c,
+    0xca, 0x79, 0xb1, 0xda, 0x3c, 0x45, 0xaf, 0xb3, 0x1d, 0x16, 0x56, 0x37,
+    0xa8, 0x4a, 0x8a, 0x66, 0xde, 0xe5, 0xa7, 0xc3, 0x49, 0xbf, 0xc3, 0xa4,
+    0xb9, 0x65, 0x9b, 0x72, 0x79, 0x9c, 0x63, 0x30, 0x15, 0x50, 0x95, 0x77,
+    0xb1, 0x59, 0x83, 0xad, 0x8a, 0x61, 0x37, 0x27, 0x1b, 0xe1, 0xf8, 0x81,
+    0x0c, 0xf4, 0x6b, 0x54, 0xd4, 0x75, 0x35, 0x21, 0xc5, 0xab, 0x95, 0x0f,
+    0xde, 0x81, 0x51, 0xd3, 0xa0, 0xf6, 0xfa, 0xe6, 0xc1, 0x5d, 0x4e, 0xde,
+    0x7d, 0x8b, 0x57, 0x89, 0xdb, 0x04, 0x7c, 0x27, 0x22, 0xd8, 0xa3, 0xdf,
+    0x64, 0xb3, 0x20, 0x43, 0xce, 0x59, 0x09, 0x90, 0x1f, 0x82, 0x3a, 0xf4,
+    0x86, 0xe7, 0x09, 0xff, 0xba, 0xe1, 0x88, 0x1b, 0x0f, 0xf1, 0xd1, 0xaa,
+    0xe1, 0x12, 0xb1, 0x16, 0x93, 0xab, 0xbf, 0x09, 0xfd, 0x89, 0xa2, 0x90,
+    0x01, 0x26, 0x1b, 0xd4, 0xab, 0x3d, 0x1d, 0xc0, 0x11, 0x5b, 0xf9, 0xb4,
+    0xd7, 0xf2, 0x76, 0x19, 0x02, 0x2b, 0x4f, 0x75, 0x91, 0x68, 0x7e, 0x69,
+    0xfe, 0x46, 0x3c, 0x96, 0x8f, 0x7f, 0xa6, 0x69, 0x38, 0x09, 0x7c, 0x51,
+    0x5d, 0x4b, 0x48, 0xbe, 0xb6, 0x48, 0x0d, 0x16, 0x3d, 0x18, 0x26, 0x65,
+    0xc6, 0x0b, 0x08, 0x71, 0xbe, 0x5c, 0x16, 0x94, 0x2c, 0x39, 0xa2, 0x60,
+    0xf6, 0x9d, 0xe2, 0x0b, 0xf9, 0x33, 0x65, 0x1c, 0x7b, 0x42, 0x54, 0xd3,
+    0x15, 0x5e, 0x92, 0x50, 0xff, 0x57, 0x75, 0x6b, 0x78, 0xa3, 0xbb, 0xc1,
+    0xa3, 0x42, 0xf7, 0x6a, 0x16, 0xd5, 0x85, 0x63, 0xfb, 0x65, 0xd7, 0x8f,
+    0x75, 0x12, 0x9e, 0xe7, 0xba, 0xb2, 0x26, 0x3e, 0xfa, 0x0a, 0xe3, 0xaa,
+    0x1b, 0x2f, 0x0b, 0x72, 0xde, 0x3d, 0xb7, 0x22, 0xeb, 0x68, 0xed, 0x19,
+    0xdd, 0x24, 0x86, 0xb4, 0x50, 0xd4, 0xd3, 0xea, 0x8b, 0x50, 0x7b, 0xfd,
+    0x38, 0x29, 0xee, 0x9c, 0x5e, 0x75, 0x67, 0x86, 0x7a, 0x9c, 0x5b, 0x9c,
+    0x6d, 0x61, 0xd5, 0xef, 0xaa, 0x1a, 0x0e, 0x2b, 0xd0, 0xec, 0x51, 0x84,
+    0x97, 0x66, 0xef, 0xec, 0xc2, 0xd3, 0xdb, 0x00, 0x62, 0x05, 0x47, 0x7f,
+    0x00, 0x01, 0x94, 0x04, 0x80, 0x04, 0x00, 0x00, 0xaf, 0x38, 0x72, 0x5a,
+    0x3e, 0x30, 0x0d, 0x8b, 0x02, 0x00, 0x00, 0x00, 0x00, 0x01, 0x59, 0x5a,
+};
+
+inline constexpr uint8_t kBlocks[] = {
+    0xfd, 0x37, 0x7a, 0x58, 0x5a, 0x00, 0x00, 0x01, 0x69, 0x22, 0xde, 0x36,
+    0x03, 0xc0, 0x83, 0x04, 0x80, 0x20, 0x21, 0x01, 0x16, 0x00, 0x00, 0x00,
+    0xc7, 0x90, 0x58, 0xe5, 0xe0, 0x0f, 0xff, 0x01, 0xfb, 0x5d, 0x00, 0x2f,
+    0x96, 0x85, 0xdd, 0x9c, 0xcd, 0x14, 0x00, 0x0e, 0xe0, 0x6f, 0xb6, 0xac,
+    0xc4, 0x0d, 0x7c, 0xf7, 0xc2, 0x27, 0x7f, 0x68, 0x7e, 0xe8, 0x4c, 0x5a,
+    0x5e, 0x79, 0x3b, 0xff, 0x73, 0x7d, 0xa4, 0x1f, 0x6d, 0x65, 0x27, 0xe1,
+    0x3f, 0x16, 0x51, 0x8d, 0x2f, 0xa6, 0xc5, 0xc0, 0x63, 0x59, 0x9e, 0x8e,
+    0xa3, 0x42, 0x4e, 0x76, 0xfe, 0xaf, 0x3f, 0x44, 0x6c, 0x1c, 0xb9, 0x2a,
+    0x0c, 0xdc, 0x18, 0x74, 0xb7, 0xf2, 0xfb, 0xa2, 0x39, 0x51, 0xb6, 0xd1,
+    0xcb, 0x0e, 0xd2, 0x0d, 0x75, 0xb9, 0x5a, 0x2a, 0xa5, 0x35, 0xbb, 0x4c,
+    0x21, 0xd5, 0x56, 0x98, 0xbb, 0x7e, 0xf9, 0x55, 0x1e, 0x85, 0xe5, 0xab,
+    0xd3, 0xe1, 0xe5, 0x76, 0x2f, 0x8b, 0x5f, 0x75, 0xe9, 0x99, 0x60, 0x7c,
+    0x29, 0xcb, 0xdb, 0xf4, 0x79, 0x42, 0x3f, 0xe4, 0xbe, 0xf6, 0xdd, 0xfe,
+    0xfa, 0x81, 0x41, 0x5d, 0xc2, 0xd7, 0x20, 0xae, 0x9f, 0x14, 0xc4, 0x1a,
+    0x81, 0x2d, 0x65, 0x29, 0xd0, 0xe3, 0x49, 0x11, 0x6f, 0x58, 0x95, 0x10,
+    0x03, 0xad, 0x39, 0xd0, 0x33, 0x6d, 0x25, 0x89, 0x81, 0xce, 0x4c, 0xcf,
+    0x4c, 0x13, 0x75, 0xba, 0x9b, 0x64, 0x2e, 0xab, 0x58, 0x17, 0x44, 0x78,
+    0x0c, 0xaf, 0xd9, 0xbd, 0x0d, 0xa1, 0x46, 0x67, 0xf6, 0xc2, 0xb2, 0x92,
+    0x06, 0xd0, 0xa5, 0x77, 0x71, 0x3c, 0xfd, 0xe8, 0x77, 0x95, 0x55, 0x87,
+    0x60, 0x32, 0x57, 0x64, 0x03, 0x0e, 0xc0, 0xe3, 0x08, 0x5a, 0x8c, 0x2a,
+    0x38, 0xd0, 0x13, 0xdf, 0xad, 0x05, 0x05, 0xae, 0xe0, 0xc1, 0xa1, 0xca,
+    0xbe, 0x9a, 0x7c, 0xc9, 0x23, 0x5a, 0x3a, 0xce, 0x10, 0xd4, 0x26, 0xa9,
+    0x49, 0x74, 0x0e, 0x2f, 0x1d, 0x97, 0x75, 0xbb, 0x80, 0x2b, 0x51, 0x30,
+    0xeb, 0x06, 0x9b, 0x67, 0x59, 0x67, 0xfa, 0xa7, 0xea, 0xa3, 0xe8, 0xb2,
+    0xde, 0x48, 0x12, 0x0a, 0xf9, 0x0c, 0x81, 0xaf, 0xca, 0xee, 0x57, 0x12,
+    0xbf, 0xab, 0x5c, 0x6e, 0x21, 0x84, 0x87, 0xcd, 0x41, 0x33, 0x84, 0x4b,
+    0x36, 0x0c, 0xbd, 0x80, 0x55, 0x12, 0x56, 0x89, 0xc7, 0x72, 0xae, 0x88,
+    0xeb, 0x35, 0xad, 0xa5, 0xc9, 0xfb, 0x05, 0xa4, 0xa0, 0x31, 0xf3, 0x2b,
+    0xa9, 0xec, 0x81, 0xe9, 0x8b, 0x13, 0x67, 0x37, 0x3a, 0xed, 0x0a, 0xf7,
+    0x50, 0x66, 0xc5, 0x1d, 0xa1, 0x42, 0x53, 0x3c, 0x99, 0xd0, 0xcf, 0x49,
+    0xd7, 0x19, 0xfd, 0x23, 0x43, 0xca, 0x3d, 0x87, 0x63, 0x6b, 0x15, 0x09,
+    0x7a, 0xa6, 0x18, 0x96, 0x02, 0xdf, 0xbb, 0xf2, 0x24, 0xf1, 0xe8, 0x8c,
+    0x0b, 0xac, 0x88, 0x82, 0x26, 0x58, 0xe2, 0x9b, 0xb6, 0x12, 0x87, 0x1f,
+    0xd1, 0x34, 0xdb, 0x4f, 0x45, 0xdf, 0x8f, 0x60, 0xe5, 0x87, 0xe5, 0x35,
+    0x7c, 0xa5, 0x51, 0xc4, 0xab, 0x49, 0xa6, 0x59, 0x7e, 0x72, 0xec, 0x78,
+    0x93, 0xa9, 0x80, 0x6e, 0xc9, 0xa8, 0xf5, 0xb5, 0x79, 0xf2, 0x88, 0x9b,
+    0x14, 0x5b, 0xdb, 0x35, 0x39, 0xc8, 0xff, 0xf6, 0x83, 0x3d, 0x17, 0x0e,
+    0xd0, 0xf8, 0x36, 0xd6, 0x4a, 0x64, 0x25, 0x05, 0xc5, 0xc7, 0xc2, 0x13,
+    0xe2, 0x0a, 0xe5, 0xb8, 0x30, 0xeb, 0xbf, 0xfa, 0xba, 0x0c, 0x75, 0x74,
+    0x12, 0x98, 0x67, 0xd9, 0x9d, 0xf8, 0xee, 0xd2, 0xaf, 0xa4, 0xa5, 0x93,
+    0x48, 0xa4, 0x32, 0xfb, 0x88, 0x5d, 0x6d, 0xf4, 0x94, 0xf7, 0x20, 0xfb,
+    0xa2, 0x3a, 0xe2, 0x9d, 0x60, 0xdb, 0x76, 0x4e, 0xb4, 0x4a, 0x0c, 0x78,
+    0x0c, 0x34, 0xf0, 0x33, 0xb9, 0x60, 0xf0, 0xb9, 0x93, 0x8e, 0x45, 0x3a,
+    0x04, 0x60, 0x7e, 0x51, 0x1b, 0x9b, 0x80, 0xe6, 0x61, 0xc2, 0xe8, 0x80,
+    0x44, 0x1b, 0x27, 0x81, 0xd2, 0xf9, 0x91, 0x02, 0x92, 0xbc, 0x30, 0x54,
+    0xdd, 0x00, 0x00, 0x00, 0xaf, 0x68, 0x1a, 0x86, 0x03, 0xc0, 0x88, 0x04,
+    0x80, 0x20, 0x21, 0x01, 0x16, 0x00, 0x00, 0x00, 0x30, 0x6b, 0xb8, 0x1d,
+    0xe0, 0x0f, 0xff, 0x02, 0x00, 0x5d, 0x00, 0x34, 0x99, 0x02, 0xc1, 0xd1,
+    0xef, 0x66, 0x5c, 0xb0, 0x46, 0x79, 0xba, 0xb5, 0x38, 0x91, 0xce, 0x66,
+    0x18, 0x65, 0xf2, 0x85, 0xa8, 0x7c, 0xaf, 0xae, 0xf7, 0xf5, 0xda, 0x6b,
+    0x58, 0x67, 0x2b, 0x56, 0x21, 0x92, 0x0c, 0x41, 0x10, 0x9d, 0xf6, 0xae,
+    0x46, 0x22, 0xb6, 0x08, 0xab, 0x6a, 0x31, 0x6d, 0x17, 0xe6, 0xd7, 0x51,
+    0x65, 0x10, 0xae, 0xeb, 0xb6, 0xb2, 0xd7, 0x8e, 0x20, 0x1b, 0xc3, 0xb2,
+    0xf6, 0xa9, 0xa8, 0x0f, 0x77, 0x0a, 0x06, 0xb3, 0x41, 0x34, 0xbc, 0xb3,
+    0x37, 0x6e, 0x0c, 0x62, 0x23, 0xa5, 0x9c, 0xc1, 0x77, 0x77, 0x0c, 0xb6,
+    0x98, 0x9b, 0x44, 0xe2, 0x46, 0xc0, 0xaf, 0x36, 0xa4, 0xbd, 0x30, 0x93,
+    0x54, 0xd0, 0xc2, 0x85, 0xcf, 0x6c, 0xb7, 0x10, 0x90, 0x5a, 0xc0, 0x9e,
+    0xf2, 0x50, 0xfc, 0xc1, 0x94, 0x2c, 0xa5, 0xa9, 0x86, 0x6f, 0xd8, 0x95,
+    0x46, 0xdc, 0x6d, 0x10, 0xab, 0xc1, 0x12, 0xc3, 0x37, 0x2b, 0xc8, 0x45,
+    0x6e, 0xcd, 0x63, 0x30, 0x7f, 0x5f, 0x8f, 0x5c, 0x81, 0xf7, 0x64, 0x05,
+    0x36, 0x0c, 0xa6, 0x26, 0x57, 0x0f, 0x0f, 0x6c, 0x38, 0xca, 0x81, 0x3b,
+    0xb1, 0xa1, 0xf5, 0x3f, 0x15, 0x75, 0xbd, 0x96, 0xec, 0x80, 0xc9, 0xee,
+    0xa5, 0x23, 0xed, 0x9e, 0x66, 0x7b, 0x70, 0x99, 0xf6, 0xe0, 0xb7, 0x1a,
+    0xc4, 0x37, 0x8b, 0x63, 0x19, 0x5d, 0xf0, 0x4b, 0x3d, 0xfd, 0xd4, 0x6c,
+    0x83, 0x99, 0x3c, 0x03, 0x53, 0x40, 0x0c, 0x22, 0x96, 0xd7, 0xaa, 0x3d,
+    0xaa, 0x2f, 0xd4, 0x3d, 0x30, 0xb1, 0xa0, 0xf2, 0x9b, 0xd3, 0x00, 0x55,
+    0x1e, 0x29, 0xf6, 0x96, 0xc7, 0xf7, 0xba, 0xf0, 0x18, 0x88, 0xdc, 0x52,
+    0x93, 0x60, 0x2c, 0x98, 0x3f, 0x2b, 0x58, 0xf1, 0x77, 0x20, 0xb9, 0x91,
+    0x61, 0xb6, 0x8b, 0xfd, 0x82, 0x9f, 0x40, 0x15, 0x90, 0x60, 0x64, 0x98,
+    0x54, 0xd1, 0x2a, 0x07, 0x86, 0x68, 0x80, 0xec, 0x93, 0x6e, 0x8c, 0x0a,
+    0x29, 0xa7, 0x40, 0xc8, 0x02, 0x86, 0xd4, 0x02, 0x4a, 0xa4, 0xf6, 0xf5,
+    0x6a, 0xe3, 0x5c, 0xc1, 0x43, 0xe4, 0x4e, 0x96, 0xaf, 0xa9, 0x5e, 0x45,
+    0xc0, 0x7a, 0xb1, 0x71, 0x75, 0x3c, 0xbe, 0xa8, 0xd6, 0x48, 0xd5, 0xd2,
+    0x01, 0xb4, 0xed, 0xd1, 0x60, 0x7b, 0xa4, 0x14, 0x75, 0xb9, 0x0b, 0xc9,
+    0x29, 0x73, 0x90, 0x8d, 0x7d, 0x94, 0x81, 0x88, 0x9e, 0x97, 0x81, 0xc5,
+    0xd9, 0xdc, 0x4f, 0x1a, 0xac, 0x5f, 0xc1, 0x26, 0x57, 0x17, 0xbf, 0x52,
+    0x58, 0x59, 0x8f, 0x6f, 0xe7, 0x6f, 0xae, 0x54, 0x66, 0x6d, 0x49, 0xc6,
+    0xc9, 0xaa, 0x9d, 0x70, 0x36, 0x20, 0x8d, 0x1e, 0xa7, 0xe3, 0xe4, 0x13,
+    0x09, 0x8e, 0x41, 0x0e, 0xc9, 0x27, 0x61, 0xb7, 0xe6, 0xc3, 0xb5, 0xf4,
+    0x6b, 0x87, 0x47, 0xc8, 0x53, 0x6e, 0x33, 0x4e, 0x6a, 0xaf, 0x40, 0x13,
+    0xef, 0x40, 0x9a, 0xce, 0x03, 0xa6, 0xf4, 0x0c, 0x11, 0x5d, 0x68, 0x05,
+    0x7a, 0xab, 0xd2, 0x5a, 0x6d, 0x15, 0xa8, 0x92, 0xa7, 0x91, 0x9d, 0x0a,
+    0xc8, 0x28, 0x9d, 0x1d, 0xc2, 0xf6, 0x62, 0x95, 0xdc, 0x23, 0xcb, 0x58,
+    0x26, 0xbd, 0x61, 0x4a, 0xd0, 0x7f, 0xb0, 0x73, 0x13, 0xd7, 0xbc, 0x55,
+    0x20, 0xd4, 0xf5, 0x9d, 0x08, 0x1f, 0xc1, 0x88, 0x71, 0xb0, 0x3e, 0x07,
+    0x13, 0x2d, 0xfd, 0x5e, 0x56, 0x84, 0xcc, 0x95, 0x24, 0x1d, 0x7d, 0x81,
+    0x0c, 0x10, 0x7d, 0x54, 0x66, 0xc7, 0xd1, 0x5e, 0xab, 0x74, 0x8d, 0xac,
+    0x5f, 0xfe, 0xa3, 0x4b, 0x42, 0x36, 0xbc, 0xa4, 0xab, 0xca, 0x7f, 0x17,
+    0xbd, 0x93, 0x3a, 0xb0, 0x31, 0x04, 0x0d, 0xd9, 0x64, 0x97, 0x95, 0xf5,
+    0x39, 0x54, 0xa1, 0x64, 0xcb, 0xb8, 0xe2, 0x3e, 0xa3, 0xcc, 0xf5, 0x45,
+    0x20, 0x6c, 0x53, 0x00, 0x56, 0xe0, 0xa6, 0x7b, 0x03, 0xc0, 0xc3, 0x02,
+    0xb4, 0x0d, 0x21, 0x01, 0x16, 0x00, 0x00, 0x00, 0x36, 0xeb, 0x15, 0xa7,
+    0xe0, 0x06, 0xb3, 0x01, 0x3b, 0x5d, 0x00, 0x18, 0x8d, 0x02, 0x44, 0x65,
+    0xd8, 0x52, 0x56, 0x6f, 0xf0, 0x79, 0xbe, 0xb0, 0x8b, 0x3c, 0x5e, 0x49,
+    0xd7, 0xc2, 0x0c, 0x49, 0x05, 0x41, 0x39, 0x92, 0x38, 0xf5, 0x91, 0x0c,
+    0xf6, 0x5c, 0xac, 0xfa, 0xe6, 0x66, 0xf6, 0x3e, 0x0d, 0x49, 0x37, 0xe4,
+    0xba, 0xe5, 0x1b, 0x0a, 0x94, 0x05, 0xa7, 0x47, 0x3b, 0x09, 0xb1, 0x37,
+    0x3e, 0x87, 0x15, 0xca, 0x52, 0x49, 0x87, 0x44, 0x3e, 0xec, 0x03, 0x52,
+    0x3f, 0x0c, 0xbf, 0x56, 0xb3, 0xde, 0xb6, 0x75, 0x83, 0x9b, 0x05, 0x42,
+    0x70, 0x52, 0xcd, 0xe5, 0xb4, 0x44, 0xd0, 0xc3, 0x6b, 0x1f, 0xb5, 0x12,
+    0x2f, 0x2d, 0x5b, 0xdb, 0x6d, 0x09, 0x16, 0x4b, 0x99, 0x9c, 0x2d, 0xce,
+    0x61, 0xdf, 0x64, 0xa5, 0x87, 0x72, 0xba, 0x88, 0x93, 0xa1, 0xf7, 0x1e,
+    0xaf, 0xb0, 0xb5, 0xec, 0x72, 0x5d, 0x73, 0xfb, 0xc1, 0x31, 0xdd, 0x90,
+    0xd1, 0x50, 0x72, 0x29, 0x9f, 0xfd, 0x34, 0x96, 0x16, 0x7f, 0xaf, 0x8b,
+    0x6c, 0x6c, 0xe7, 0x3f, 0x12, 0xc8, 0x92, 0xe8, 0xcc, 0x3f, 0x3b, 0x09,
+    0x16, 0xfe, 0x22, 0x0e, 0xd5, 0x56, 0x40, 0x71, 0x6a, 0xf4, 0xb1, 0xfe,
+    0x51, 0x5e, 0x3c, 0x03, 0xb8, 0xb8, 0x66, 0x3f, 0x05, 0xc0, 0x99, 0xe4,
+    0xf2, 0x5d, 0xb4, 0xc9, 0x59, 0xf7, 0xdd, 0xe8, 0x3e, 0x4d, 0x9d, 0x2b,
+    0xfb, 0x54, 0x0f, 0xd9, 0x2b, 0x76, 0x85, 0xa1, 0xfb, 0x04, 0x37, 0x89,
+    0x11, 0xa2, 0xde, 0x85, 0xfc, 0x69, 0x15, 0x38, 0x4a, 0x2a, 0xf4, 0xb8,
+    0x11, 0x3c, 0x26, 0xcf, 0xba, 0x67, 0x10, 0x9c, 0xf4, 0x19, 0xc7, 0x46,
+    0xb6, 0xe6, 0x6b, 0x47, 0xb4, 0x9f, 0xcc, 0xe7, 0x9e, 0x6f, 0x5d, 0xc5,
+    0xb2, 0x31, 0xa6, 0x2e, 0xf6, 0xb1, 0x92, 0x88, 0xb7, 0x36, 0x18, 0xfe,
+    0xeb, 0x0d, 0x9e, 0x96, 0x4f, 0xb5, 0xfe, 0x64, 0xde, 0x23, 0xf1, 0x9e,
+    0x25, 0x37, 0x96, 0xdf, 0x80, 0x1e, 0x7a, 0x31, 0x77, 0x0c, 0x2b, 0xf1,
+    0xce, 0xc4, 0xd4, 0x01, 0xb9, 0x5f, 0x73, 0xfc, 0xf2, 0x08, 0xfb, 0xfb,
+    0xf2, 0xab, 0x79, 0x32, 0x79, 0x8b, 0x42, 0x68, 0x48, 0x70, 0x41, 0xfc,
+    0xd4, 0xce, 0xe6, 0x40, 0xfe, 0x9c, 0xab, 0xa2, 0xb9, 0x3d, 0xa2, 0x76,
+    0xa5, 0x94, 0xe0, 0x9d, 0x54, 0xd0, 0xed, 0x26, 0xe2, 0x80, 0x00, 0x00,
+    0x71, 0x3c, 0x7c, 0xf7, 0x00, 0x03, 0x97, 0x04, 0x80, 0x20, 0x9c, 0x04,
+    0x80, 0x20, 0xd7, 0x02, 0xb4, 0x0d, 0x00, 0x00, 0x87, 0x62, 0xe6, 0xae,
+    0x23, 0xd3, 0x54, 0x5d, 0x04, 0x00, 0x00, 0x00, 0x00, 0x01, 0x59, 0x5a,
+};
+
+} // namespace XzVectors
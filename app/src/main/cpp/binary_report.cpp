@@ -0,0 +1,102 @@
+#include "binary_report.hpp"
+#include "scan.hpp"
+#include <cstring>
+
+namespace BinaryReport {
+
+size_t Encode(const Scan::Report &report, std::span<char> out) {
+  size_t strings_size = 0;
+  for (auto &result : report.results)
+    strings_size += strlen(result.detector->name()) + 1 +
+                    result.finding.summary.size() + 1;
+  size_t records_offset = sizeof(Header);
+  size_t strings_offset =
+      records_offset + report.results.size() * sizeof(Record);
+  size_t total_size = strings_offset + strings_size;
+  if (out.size() < total_size)
+    return total_size;
+
+  Header header{};
+  memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.header_size = sizeof(Header);
+  header.total_size = total_size;
+  header.record_count = report.results.size();
+  header.record_size = sizeof(Record);
+  header.records_offset = records_offset;
+  header.strings_offset = strings_offset;
+  header.strings_size = strings_size;
+  header.generation = report.generation;
+  header.wall_ns = report.wall_ns;
+  memcpy(out.data(), &header, sizeof(header));
+
+  char *records = out.data() + records_offset;
+  char *strings = out.data() + strings_offset;
+  uint32_t used = 0;
+  auto add_string = [&](std::string_view s, uint32_t &offset,
+                        uint32_t &length) {
+    offset = used;
+    length = s.size();
+    memcpy(strings + used, s.data(), s.size());
+    strings[used + s.size()] = '\0';
+    used += s.size() + 1;
+  };
+  for (auto &result : report.results) {
+    Record record{};
+    add_string(result.detector->name(), record.name_offset,
+               record.name_length);
+    add_string(result.finding.summary, record.summary_offset,
+               record.summary_length);
+    record.flags = result.finding.detected ? uint32_t{Record::kDetected} : 0;
+    record.wall_ns = result.wall_ns;
+    record.cpu_ns = result.cpu_ns;
+    memcpy(records, &record, sizeof(record));
+    records += sizeof(record);
+  }
+  return total_size;
+}
+
+bool View::Parse(std::span<const char> data) {
+  if (data.size() < sizeof(Header))
+    return false;
+  memcpy(&header_, data.data(), sizeof(Header));
+  if (memcmp(header_.magic, kMagic, sizeof(kMagic)) != 0 ||
+      header_.version != kVersion || header_.header_size < sizeof(Header) ||
+      header_.total_size > data.size() ||
+      header_.record_size < sizeof(Record))
+    return false;
+  // Bounds in 64 bits, so that no field can wrap them.
+  uint64_t records_end = uint64_t{header_.records_offset} +
+                         uint64_t{header_.record_count} * header_.record_size;
+  uint64_t strings_end =
+      uint64_t{header_.strings_offset} + header_.strings_size;
+  if (header_.records_offset < header_.header_size ||
+      records_end > header_.total_size || strings_end > header_.total_size)
+    return false;
+  data_ = data.first(header_.total_size);
+  return true;
+}
+
+Record View::record(size_t index) const {
+  Record record;
+  memcpy(&record,
+         data_.data() + header_.records_offset + index * header_.record_size,
+         sizeof(record));
+  return record;
+}
+
+std::string_view View::String(uint32_t offset, uint32_t length) const {
+  if (uint64_t{offset} + length > header_.strings_size)
+    return {};
+  return {data_.data() + header_.strings_offset + offset, length};
+}
+
+std::string_view View::name(const Record &record) const {
+  return String(record.name_offset, record.name_length);
+}
+
+std::string_view View::summary(const Record &record) const {
+  return String(record.summary_offset, record.summary_length);
+}
+
+} // namespace BinaryReport
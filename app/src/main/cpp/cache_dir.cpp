@@ -0,0 +1,72 @@
+#include "cache_dir.hpp"
+#include <cerrno>
+#include <cstdio>
+#include <fcntl.h>
+#include <mutex>
+#include <unistd.h>
+
+namespace Cache {
+
+namespace {
+
+std::mutex dir_mutex;
+std::string dir;
+
+bool WriteFully(int fd, const void *buffer, size_t size) {
+  auto *in = static_cast<const char *>(buffer);
+  while (size > 0) {
+    ssize_t n = write(fd, in, size);
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n <= 0)
+      return false;
+    in += n;
+    size -= n;
+  }
+  return true;
+}
+
+} // namespace
+
+void SetDir(std::string_view path) {
+  std::lock_guard lock(dir_mutex);
+  dir = path;
+}
+
+std::string Path(std::string_view name) {
+  std::lock_guard lock(dir_mutex);
+  if (dir.empty())
+    return {};
+  std::string path = dir;
+  path += '/';
+  path += name;
+  return path;
+}
+
+bool Store(const std::string &path,
+           std::initializer_list<std::span<const char>> parts) {
+  std::string temporary = path + '.' + std::to_string(getpid());
+  int fd = open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC,
+                0600);
+  if (fd < 0)
+    return false;
+  bool written = true;
+  for (auto part : parts)
+    written = written && WriteFully(fd, part.data(), part.size());
+  if (close(fd) != 0 || !written ||
+      rename(temporary.c_str(), path.c_str()) != 0) {
+    unlink(temporary.c_str());
+    return false;
+  }
+  return true;
+}
+
+void AppendHex(std::string &out, std::string_view bytes) {
+  static constexpr char kHex[] = "0123456789abcdef";
+  for (unsigned char c : bytes) {
+    out += kHex[c >> 4];
+    out += kHex[c & 0xf];
+  }
+}
+
+} // namespace Cache
@@ -0,0 +1,262 @@
+#include "detector.hpp"
+#include "elf_util.h"
+#include "instrument.hpp"
+#include "logging.h"
+#include "map_snapshot.hpp"
+#include "solist.hpp"
+#include "solist_snapshot.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <ctime>
+
+namespace Detectors {
+
+namespace {
+
+struct Registration {
+  int order;
+  Factory factory;
+};
+
+// Function-local so that registering from static initializers of other
+// translation units does not depend on their order.
+std::vector<Registration> &Registrations() {
+  static std::vector<Registration> registrations;
+  return registrations;
+}
+
+// Held for a whole run, by any scheduler.
+std::mutex run_mutex;
+
+uint64_t ThreadCpuNs() {
+  timespec ts;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+  return ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+uint64_t WallNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+} // namespace
+
+Inputs::Inputs() = default;
+
+Inputs::~Inputs() = default;
+
+std::span<const VirtualMap::MapRegion> Inputs::maps() {
+  std::call_once(maps_once_, [this] { maps_ok_ = VirtualMap::RefreshMaps(); });
+  if (!maps_ok_)
+    return {};
+  return VirtualMap::Maps();
+}
+
+bool Inputs::linker() {
+  std::call_once(linker_once_, [this] { linker_ok_ = SoList::Ready(); });
+  return linker_ok_;
+}
+
+const SoList::Snapshot &Inputs::soinfos() {
+  std::call_once(soinfos_once_, [this] {
+    soinfos_ = std::make_unique<SoList::Snapshot>();
+    if (linker())
+      *soinfos_ = SoList::Capture();
+  });
+  return *soinfos_;
+}
+
+const SandHook::ElfImg *Inputs::libc() {
+  std::call_once(libc_once_,
+                 [this] { libc_ = SandHook::ElfImg::Shared("libc.so"); });
+  return libc_.get();
+}
+
+void Inputs::Prepare(uint32_t mask) {
+  if ((mask & kMaps) == kMaps)
+    maps();
+  if ((mask & kSoInfos) == kSoInfos)
+    soinfos();
+  else if ((mask & kLinker) == kLinker)
+    linker();
+  if ((mask & kLibc) == kLibc)
+    libc();
+}
+
+bool Register(int order, Factory factory) {
+  Registrations().push_back({order, factory});
+  return true;
+}
+
+std::span<Detector *const> Registered() {
+  struct Instances {
+    std::vector<std::unique_ptr<Detector>> owned;
+    std::vector<Detector *> detectors;
+  };
+  // Never destroyed: the detached scan worker and the Monitor thread may still
+  // run the detectors when the process exits.
+  static const Instances &instances = *new Instances([] {
+    auto &registrations = Registrations();
+    std::vector<std::pair<int, std::unique_ptr<Detector>>> made;
+    for (auto &registration : registrations)
+      made.emplace_back(registration.order, registration.factory());
+    std::sort(made.begin(), made.end(), [](auto &a, auto &b) {
+      if (a.first != b.first)
+        return a.first < b.first;
+      return strcmp(a.second->name(), b.second->name()) < 0;
+    });
+    Instances instances;
+    for (auto &[order, detector] : made) {
+      instances.detectors.push_back(detector.get());
+      instances.owned.push_back(std::move(detector));
+    }
+    return instances;
+  }());
+  return instances.detectors;
+}
+
+size_t Scheduler::DefaultThreads() {
+  // The detectors are few and mostly wait on the kernel, so more workers
+  // than detectors would only idle.
+  return std::clamp<size_t>(std::thread::hardware_concurrency(), 1, 4);
+}
+
+Scheduler::Scheduler(size_t threads) {
+  threads = std::max<size_t>(threads, 1);
+  for (size_t i = 0; i < threads; i++)
+    workers_.push_back(std::make_unique<Worker>());
+  // Worker 0 is the thread calling Run().
+  for (size_t i = 1; i < threads; i++)
+    threads_.emplace_back(&Scheduler::Work, this, i);
+}
+
+Scheduler::~Scheduler() {
+  {
+    std::lock_guard lock(mutex_);
+    stop_ = true;
+  }
+  wake_.notify_all();
+  for (auto &thread : threads_)
+    thread.join();
+}
+
+bool Scheduler::Take(size_t self, std::function<void()> &task) {
+  if (queued_.load(std::memory_order_acquire) == 0)
+    return false;
+  for (size_t i = 0; i < workers_.size(); i++) {
+    auto &worker = *workers_[(self + i) % workers_.size()];
+    std::lock_guard lock(worker.mutex);
+    if (worker.tasks.empty())
+      continue;
+    // The own queue is used as a stack, the others are stolen from in the
+    // order they were filled.
+    if (i == 0) {
+      task = std::move(worker.tasks.back());
+      worker.tasks.pop_back();
+    } else {
+      task = std::move(worker.tasks.front());
+      worker.tasks.pop_front();
+    }
+    queued_.fetch_sub(1, std::memory_order_release);
+    return true;
+  }
+  return false;
+}
+
+void Scheduler::Work(size_t self) {
+  std::function<void()> task;
+  for (;;) {
+    if (Take(self, task)) {
+      task();
+      std::lock_guard lock(mutex_);
+      if (--pending_ == 0)
+        done_.notify_all();
+      continue;
+    }
+    std::unique_lock lock(mutex_);
+    wake_.wait(lock, [this] { return stop_ || queued_.load() > 0; });
+    if (stop_)
+      return;
+  }
+}
+
+std::vector<Result> Scheduler::Run(std::span<Detector *const> detectors) {
+  std::lock_guard run_lock(run_mutex);
+  return RunLocked(detectors);
+}
+
+bool Scheduler::TryRun(std::span<Detector *const> detectors,
+                       std::vector<Result> &results) {
+  std::unique_lock run_lock(run_mutex, std::try_to_lock);
+  if (!run_lock.owns_lock())
+    return false;
+  results = RunLocked(detectors);
+  return true;
+}
+
+std::vector<Result>
+Scheduler::RunLocked(std::span<Detector *const> detectors) {
+  Inputs inputs;
+  std::vector<Result> results(detectors.size());
+
+  // Inputs declared more than once are computed while the detectors that
+  // do not need them start.
+  uint32_t declared = 0;
+  uint32_t shared = 0;
+  for (auto *detector : detectors) {
+    shared |= declared & detector->inputs();
+    declared |= detector->inputs();
+  }
+  std::vector<std::function<void()>> tasks;
+  for (auto input : {kMaps, kSoInfos, kLibc}) {
+    if ((shared & input) == input)
+      tasks.emplace_back([&inputs, input] { inputs.Prepare(input); });
+  }
+  for (size_t i = 0; i < detectors.size(); i++) {
+    tasks.emplace_back([&, i] {
+      auto &result = results[i];
+      result.detector = detectors[i];
+      INSTRUMENT_NAMED_SCOPE(detectors[i]->name());
+      uint64_t wall = WallNs();
+      uint64_t cpu = ThreadCpuNs();
+      result.finding = detectors[i]->Run(inputs);
+      result.cpu_ns = ThreadCpuNs() - cpu;
+      result.wall_ns = WallNs() - wall;
+    });
+  }
+
+  // Workers take their own tasks from the back, so the queues are filled in
+  // reverse for the inputs to be computed first.
+  {
+    std::lock_guard lock(mutex_);
+    pending_ = tasks.size();
+    for (size_t i = tasks.size(); i-- > 0;) {
+      auto &worker = *workers_[i % workers_.size()];
+      std::lock_guard worker_lock(worker.mutex);
+      worker.tasks.push_back(std::move(tasks[i]));
+    }
+    queued_.store(tasks.size(), std::memory_order_release);
+  }
+  wake_.notify_all();
+
+  std::function<void()> task;
+  while (Take(0, task)) {
+    task();
+    std::lock_guard lock(mutex_);
+    --pending_;
+  }
+  std::unique_lock lock(mutex_);
+  done_.wait(lock, [this] { return pending_ == 0; });
+  return results;
+}
+
+std::vector<Result> RunAll() {
+  // Never destroyed, like the detectors: a detached worker may be in Run()
+  // when the process exits.
+  static Scheduler &scheduler = *new Scheduler;
+  return scheduler.Run(Registered());
+}
+
+} // namespace Detectors
@@ -18,7 +18,12 @@
  * Copyright (C) 2021 LSPosed Contributors
  */
 #include "elf_util.h"
+#include "instrument.hpp"
+#include "mini_debug_info.hpp"
+#include <algorithm>
 #include <cassert>
+#include <cerrno>
+#include <cstddef>
 #include <cstring>
 #include <fcntl.h>
 #include <malloc.h>
@@ -28,113 +33,434 @@
 
 using namespace SandHook;
 
-template <typename T>
-inline constexpr auto offsetOf(ElfW(Ehdr) * head, ElfW(Off) off) {
-  return reinterpret_cast<std::conditional_t<std::is_pointer_v<T>, T, T *>>(
-      reinterpret_cast<uintptr_t>(head) + off);
+namespace {
+
+struct LoadedModule {
+  std::string path;
+  void *base;
+  const ElfW(Phdr) *phdr;
+  ElfW(Half) phnum;
+};
+
+// Images handed out by ElfImg::Shared(), validated against the load and
+// unload counters of the dynamic linker.
+struct Registry {
+  struct Entry {
+    std::string query;
+    std::shared_ptr<const ElfImg> image;
+    void *base;
+  };
+
+  std::mutex mutex;
+  std::vector<Entry> entries;
+  unsigned long long adds = 0;
+  unsigned long long subs = 0;
+  bool has_counters = false;
+};
+
+Registry &GetRegistry() {
+  static Registry registry;
+  return registry;
+}
+
+// Reads dlpi_adds and dlpi_subs, which count the modules ever loaded and
+// unloaded, from the first module. Older linkers do not report them.
+bool LoadCounters(unsigned long long &adds, unsigned long long &subs) {
+  struct Counters {
+    unsigned long long adds, subs;
+    bool valid;
+  } counters{0, 0, false};
+  dl_iterate_phdr(
+      [](struct dl_phdr_info *info, size_t size, void *data) -> int {
+        auto *counters = reinterpret_cast<Counters *>(data);
+        if (size >= offsetof(struct dl_phdr_info, dlpi_subs) +
+                        sizeof(info->dlpi_subs)) {
+          counters->adds = info->dlpi_adds;
+          counters->subs = info->dlpi_subs;
+          counters->valid = true;
+        }
+        return 1;
+      },
+      &counters);
+  adds = counters.adds;
+  subs = counters.subs;
+  return counters.valid;
+}
+
+std::vector<LoadedModule> LoadedModules() {
+  std::vector<LoadedModule> modules;
+  dl_iterate_phdr(
+      [](struct dl_phdr_info *info, size_t, void *data) -> int {
+        if (info->dlpi_name != nullptr && info->dlpi_name[0] != '\0') {
+          reinterpret_cast<std::vector<LoadedModule> *>(data)->push_back(
+              {info->dlpi_name, reinterpret_cast<void *>(info->dlpi_addr),
+               info->dlpi_phdr, info->dlpi_phnum});
+        }
+        return 0;
+      },
+      &modules);
+  return modules;
+}
+
+} // namespace
+
+std::shared_ptr<const ElfImg> ElfImg::Shared(std::string_view elf) {
+  auto &registry = GetRegistry();
+  std::lock_guard lock(registry.mutex);
+
+  unsigned long long adds, subs;
+  bool has_counters = LoadCounters(adds, subs);
+  bool unchanged = has_counters && registry.has_counters &&
+                   adds == registry.adds && subs == registry.subs;
+  if (unchanged) {
+    for (auto &entry : registry.entries) {
+      if (entry.query == elf)
+        return entry.image;
+    }
+  }
+
+  auto modules = LoadedModules();
+  if (!unchanged) {
+    // Drop the images of modules that were unloaded or moved.
+    std::erase_if(registry.entries, [&](const Registry::Entry &entry) {
+      return std::none_of(modules.begin(), modules.end(),
+                          [&](const LoadedModule &module) {
+                            return module.path == entry.image->elf &&
+                                   module.base == entry.base;
+                          });
+    });
+    registry.adds = adds;
+    registry.subs = subs;
+    registry.has_counters = has_counters;
+  }
+
+  // Same match as findModuleBase().
+  std::string query(elf);
+  auto module = std::find_if(modules.begin(), modules.end(),
+                             [&](const LoadedModule &module) {
+                               return strstr(module.path.c_str(),
+                                             query.c_str()) != nullptr;
+                             });
+  if (module == modules.end())
+    return nullptr;
+
+  std::shared_ptr<const ElfImg> image;
+  for (auto &entry : registry.entries) {
+    if (entry.image->elf == module->path && entry.base == module->base) {
+      image = entry.image;
+      if (entry.query == elf)
+        return image;
+    }
+  }
+  if (image == nullptr)
+    image.reset(
+        new ElfImg(module->path, module->base, module->phdr, module->phnum));
+  registry.entries.push_back({std::move(query), image, module->base});
+  return image;
 }
 
 ElfImg::ElfImg(std::string_view base_name) : elf(base_name) {
+  INSTRUMENT_SCOPE("ElfImg(name)");
   if (!findModuleBase()) {
     base = nullptr;
     return;
   }
+  Load();
+}
 
-  // load elf
-  int fd = open(elf.data(), O_RDONLY);
-  if (fd < 0) {
-    // LOGE("failed to open %s", elf.data());
-    return;
-  }
+ElfImg::ElfImg(std::string_view path, void *base, const ElfW(Phdr) * phdr,
+               ElfW(Half) phnum)
+    : elf(path), base(base), phdr_(phdr), phnum_(phnum) {
+  INSTRUMENT_SCOPE("ElfImg(module)");
+  Load();
+}
+
+namespace {
 
-  size = lseek(fd, 0, SEEK_END);
-  if (size <= 0) {
-    // LOGE("lseek() failed for %s", elf.data());
+bool ReadFully(int fd, void *buffer, size_t size, off_t offset) {
+  auto *out = static_cast<char *>(buffer);
+  while (size > 0) {
+    INSTRUMENT_SYSCALL();
+    ssize_t n = pread(fd, out, size, offset);
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n <= 0)
+      return false;
+    out += n;
+    size -= n;
+    offset += n;
   }
+  return true;
+}
 
-  header = reinterpret_cast<decltype(header)>(
-      mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0));
+// The descriptor of the NT_GNU_BUILD_ID note in \p section.
+void ReadBuildId(int fd, const ElfW(Shdr) & section, std::string &build_id) {
+  if (section.sh_size < sizeof(ElfW(Nhdr)) || section.sh_size > 256)
+    return;
+  std::vector<char> note(section.sh_size);
+  if (!ReadFully(fd, note.data(), note.size(), section.sh_offset))
+    return;
+  ElfW(Nhdr) header;
+  memcpy(&header, note.data(), sizeof(header));
+  // The name "GNU" is padded to 4 bytes.
+  size_t desc = sizeof(header) + ((header.n_namesz + 3) & ~3u);
+  if (header.n_type == NT_GNU_BUILD_ID && header.n_namesz == 4 &&
+      memcmp(note.data() + sizeof(header), "GNU", 4) == 0 &&
+      desc <= note.size() && header.n_descsz <= note.size() - desc)
+    build_id.assign(note.data() + desc, header.n_descsz);
+}
 
-  close(fd);
+} // namespace
 
-  section_header = offsetOf<decltype(section_header)>(header, header->e_shoff);
+void ElfImg::Load() {
+  // Only the headers are read; sections are mapped when needed.
+  INSTRUMENT_SYSCALL();
+  int fd = open(elf.data(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    // LOGE("failed to open %s", elf.data());
+    return;
+  }
 
-  auto shoff = reinterpret_cast<uintptr_t>(section_header);
-  char *section_str =
-      offsetOf<char *>(header, section_header[header->e_shstrndx].sh_offset);
+  ElfW(Ehdr) header;
+  std::vector<ElfW(Shdr)> sections;
+  std::vector<char> section_str;
+  bool valid = ReadFully(fd, &header, sizeof(header), 0) &&
+               memcmp(header.e_ident, ELFMAG, SELFMAG) == 0 &&
+               header.e_shentsize == sizeof(ElfW(Shdr)) &&
+               header.e_shstrndx < header.e_shnum;
+  if (valid) {
+    sections.resize(header.e_shnum);
+    valid = ReadFully(fd, sections.data(), sections.size() * sizeof(ElfW(Shdr)),
+                      header.e_shoff);
+  }
+  if (valid) {
+    auto &names = sections[header.e_shstrndx];
+    // Terminated in case the table is not.
+    section_str.resize(names.sh_size + 1);
+    valid = ReadFully(fd, section_str.data(), names.sh_size, names.sh_offset);
+  }
+  if (!valid) {
+    close(fd);
+    return;
+  }
 
-  for (int i = 0; i < header->e_shnum; i++, shoff += header->e_shentsize) {
-    auto *section_h = (ElfW(Shdr) *)shoff;
-    char *sname = section_h->sh_name + section_str;
-    auto entsize = section_h->sh_entsize;
-    switch (section_h->sh_type) {
+  const ElfW(Shdr) *dynsym = nullptr;
+  const ElfW(Shdr) *strtab = nullptr;
+  const ElfW(Shdr) *hash = nullptr;
+  const ElfW(Shdr) *gnu_hash = nullptr;
+  for (auto &section : sections) {
+    const char *sname = section.sh_name < section_str.size()
+                            ? section_str.data() + section.sh_name
+                            : "";
+    switch (section.sh_type) {
     case SHT_DYNSYM: {
-      if (bias == -4396) {
-        dynsym = section_h;
-        dynsym_offset = section_h->sh_offset;
-        dynsym_start = offsetOf<decltype(dynsym_start)>(header, dynsym_offset);
-      }
+      if (bias == -4396)
+        dynsym = &section;
       break;
     }
     case SHT_SYMTAB: {
       if (strcmp(sname, ".symtab") == 0) {
-        symtab = section_h;
-        symtab_offset = section_h->sh_offset;
-        symtab_size = section_h->sh_size;
-        symtab_count = symtab_size / entsize;
-        symtab_start = offsetOf<decltype(symtab_start)>(header, symtab_offset);
+        symtab_offset = section.sh_offset;
+        symtab_size = section.sh_size;
+        symtab_count = symtab_size / section.sh_entsize;
       }
       break;
     }
     case SHT_STRTAB: {
-      if (bias == -4396) {
-        strtab = section_h;
-        symstr_offset = section_h->sh_offset;
-        strtab_start = offsetOf<decltype(strtab_start)>(header, symstr_offset);
-      }
+      if (bias == -4396)
+        strtab = &section;
       if (strcmp(sname, ".strtab") == 0) {
-        symstr_offset_for_symtab = section_h->sh_offset;
+        symstr_offset_for_symtab = section.sh_offset;
+        symstr_size_for_symtab = section.sh_size;
       }
       break;
     }
     case SHT_PROGBITS: {
+      if (strcmp(sname, ".gnu_debugdata") == 0) {
+        debugdata_offset_ = section.sh_offset;
+        debugdata_size_ = section.sh_size;
+      }
       if (strtab == nullptr || dynsym == nullptr)
         break;
       if (bias == -4396) {
-        bias = (off_t)section_h->sh_addr - (off_t)section_h->sh_offset;
+        bias = (off_t)section.sh_addr - (off_t)section.sh_offset;
       }
       break;
     }
+    case SHT_NOTE: {
+      if (strcmp(sname, ".note.gnu.build-id") == 0)
+        ReadBuildId(fd, section, build_id_);
+      break;
+    }
     case SHT_HASH: {
-      auto *d_un = offsetOf<ElfW(Word)>(header, section_h->sh_offset);
-      nbucket_ = d_un[0];
-      bucket_ = d_un + 2;
-      chain_ = bucket_ + nbucket_;
+      hash = &section;
       break;
     }
     case SHT_GNU_HASH: {
-      auto *d_buf = reinterpret_cast<ElfW(Word) *>(((size_t)header) +
-                                                   section_h->sh_offset);
-      gnu_nbucket_ = d_buf[0];
-      gnu_symndx_ = d_buf[1];
-      gnu_bloom_size_ = d_buf[2];
-      gnu_shift2_ = d_buf[3];
-      gnu_bloom_filter_ =
-          reinterpret_cast<decltype(gnu_bloom_filter_)>(d_buf + 4);
-      gnu_bucket_ = reinterpret_cast<decltype(gnu_bucket_)>(gnu_bloom_filter_ +
-                                                            gnu_bloom_size_);
-      gnu_chain_ = gnu_bucket_ + gnu_nbucket_ - gnu_symndx_;
+      gnu_hash = &section;
       break;
     }
     }
   }
+
+  // The loaded image already holds the dynamic tables, which saves mapping
+  // them again from the file.
+  if (!LoadDynamicTables() && dynsym != nullptr && strtab != nullptr) {
+    dynsym_start = static_cast<ElfW(Sym) *>(
+        MapSection(fd, dynsym->sh_offset, dynsym->sh_size));
+    strtab_start = static_cast<const char *>(
+        MapSection(fd, strtab->sh_offset, strtab->sh_size));
+    if (hash != nullptr)
+      SetSysvHash(static_cast<ElfW(Word) *>(
+          MapSection(fd, hash->sh_offset, hash->sh_size)));
+    if (gnu_hash != nullptr)
+      SetGnuHash(static_cast<ElfW(Word) *>(
+          MapSection(fd, gnu_hash->sh_offset, gnu_hash->sh_size)));
+  }
+  close(fd);
+}
+
+bool ElfImg::LoadDynamicTables() {
+  if (phdr_ == nullptr)
+    return false;
+  auto load_bias = reinterpret_cast<uintptr_t>(base);
+  const ElfW(Dyn) *dynamic = nullptr;
+  for (size_t i = 0; i < phnum_; i++) {
+    if (phdr_[i].p_type == PT_DYNAMIC)
+      dynamic = reinterpret_cast<const ElfW(Dyn) *>(load_bias +
+                                                    phdr_[i].p_vaddr);
+  }
+  if (dynamic == nullptr)
+    return false;
+
+  uintptr_t symbols = 0, strings = 0, hash = 0, gnu_hash = 0;
+  for (auto *entry = dynamic; entry->d_tag != DT_NULL; entry++) {
+    // glibc relocates these pointers in place, bionic leaves them relative
+    // to the load bias.
+    uintptr_t ptr = entry->d_un.d_ptr;
+    if (ptr < load_bias)
+      ptr += load_bias;
+    switch (entry->d_tag) {
+    case DT_SYMTAB:
+      symbols = ptr;
+      break;
+    case DT_STRTAB:
+      strings = ptr;
+      break;
+    case DT_HASH:
+      hash = ptr;
+      break;
+    case DT_GNU_HASH:
+      gnu_hash = ptr;
+      break;
+    }
+  }
+  if (symbols == 0 || strings == 0 || (hash == 0 && gnu_hash == 0))
+    return false;
+
+  dynsym_start = reinterpret_cast<ElfW(Sym) *>(symbols);
+  strtab_start = reinterpret_cast<const char *>(strings);
+  if (hash != 0)
+    SetSysvHash(reinterpret_cast<ElfW(Word) *>(hash));
+  if (gnu_hash != 0)
+    SetGnuHash(reinterpret_cast<ElfW(Word) *>(gnu_hash));
+  return true;
+}
+
+void ElfImg::SetSysvHash(ElfW(Word) * d_un) {
+  if (d_un == nullptr)
+    return;
+  nbucket_ = d_un[0];
+  bucket_ = d_un + 2;
+  chain_ = bucket_ + nbucket_;
+}
+
+void ElfImg::SetGnuHash(ElfW(Word) * d_buf) {
+  if (d_buf == nullptr)
+    return;
+  gnu_nbucket_ = d_buf[0];
+  gnu_symndx_ = d_buf[1];
+  gnu_bloom_size_ = d_buf[2];
+  gnu_shift2_ = d_buf[3];
+  gnu_bloom_filter_ = reinterpret_cast<decltype(gnu_bloom_filter_)>(d_buf + 4);
+  gnu_bucket_ = reinterpret_cast<decltype(gnu_bucket_)>(gnu_bloom_filter_ +
+                                                        gnu_bloom_size_);
+  gnu_chain_ = gnu_bucket_ + gnu_nbucket_ - gnu_symndx_;
+}
+
+void *ElfImg::MapSection(int fd, ElfW(Off) offset, ElfW(Off) size) const {
+  if (size == 0)
+    return nullptr;
+  static const size_t page_size = sysconf(_SC_PAGESIZE);
+  ElfW(Off) start = offset & ~(page_size - 1);
+  size_t length = offset + size - start;
+  INSTRUMENT_SYSCALL();
+  void *map = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, start);
+  if (map == MAP_FAILED)
+    return nullptr;
+  mappings_.push_back({map, length});
+  return static_cast<char *>(map) + (offset - start);
+}
+
+bool ElfImg::MapSymtab() const {
+  std::call_once(symtab_once_, [this] {
+    if (symtab_count == 0 || symstr_offset_for_symtab == 0) {
+      LoadMiniDebugInfo();
+      return;
+    }
+    INSTRUMENT_SYSCALL();
+    int fd = open(elf.data(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+      return;
+    auto *symbols = static_cast<const ElfW(Sym) *>(
+        MapSection(fd, symtab_offset, symtab_size));
+    auto *strings = static_cast<const char *>(
+        MapSection(fd, symstr_offset_for_symtab, symstr_size_for_symtab));
+    close(fd);
+    if (symbols != nullptr && strings != nullptr) {
+      symtab_start = symbols;
+      symtab_strings_ = strings;
+    }
+  });
+  return symtab_start != nullptr;
+}
+
+void ElfImg::LoadMiniDebugInfo() const {
+  if (debugdata_size_ == 0)
+    return;
+  MiniDebugInfo::Symtab symtab;
+  std::pair<void *, size_t> mapping{};
+  if (!MiniDebugInfo::LoadCached(build_id_, symtab, mapping)) {
+    INSTRUMENT_SYSCALL();
+    int fd = open(elf.data(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+      return;
+    std::vector<char> xz(debugdata_size_);
+    bool read = ReadFully(fd, xz.data(), xz.size(), debugdata_offset_);
+    close(fd);
+    if (!read || !MiniDebugInfo::Decompress(xz, debugdata_) ||
+        !MiniDebugInfo::FindSymtab(debugdata_, symtab)) {
+      debugdata_ = {};
+      return;
+    }
+    // The cached copy only holds the symbols worth resolving, in clean pages,
+    // so it replaces the decompressed image once written.
+    MiniDebugInfo::StoreCached(build_id_, symtab);
+    if (MiniDebugInfo::LoadCached(build_id_, symtab, mapping))
+      debugdata_ = {};
+  }
+  if (mapping.first != nullptr)
+    mappings_.push_back(mapping);
+  symtab_start = symtab.symbols.data();
+  symtab_strings_ = symtab.strings.data();
+  symtab_count = symtab.symbols.size();
 }
 
 ElfW(Addr) ElfImg::ElfLookup(std::string_view name, uint32_t hash) const {
   if (nbucket_ == 0)
     return 0;
 
-  char *strings = (char *)strtab_start;
+  const char *strings = strtab_start;
 
   for (auto n = bucket_[hash % nbucket_]; n != 0; n = chain_[n]) {
     auto *sym = dynsym_start + n;
@@ -158,7 +484,7 @@ ElfW(Addr) ElfImg::GnuLookup(std::string_view name, uint32_t hash) const {
   if ((mask & bloom_word) == mask) {
     auto sym_index = gnu_bucket_[hash % gnu_nbucket_];
     if (sym_index >= gnu_symndx_) {
-      char *strings = (char *)strtab_start;
+      const char *strings = strtab_start;
       do {
         auto *sym = dynsym_start + sym_index;
         if (((gnu_chain_[sym_index] ^ hash) >> 1) == 0 &&
@@ -171,68 +497,114 @@ ElfW(Addr) ElfImg::GnuLookup(std::string_view name, uint32_t hash) const {
   return 0;
 }
 
-ElfW(Addr) ElfImg::LinearLookup(std::string_view name) const {
-  if (symtabs_.empty()) {
-    symtabs_.reserve(symtab_count);
-    if (symtab_start != nullptr && symstr_offset_for_symtab != 0) {
-      for (ElfW(Off) i = 0; i < symtab_count; i++) {
-        unsigned int st_type = ELF_ST_TYPE(symtab_start[i].st_info);
-        const char *st_name = offsetOf<const char *>(
-            header, symstr_offset_for_symtab + symtab_start[i].st_name);
-        if ((st_type == STT_FUNC || st_type == STT_OBJECT) &&
-            symtab_start[i].st_size) {
-          symtabs_.emplace(st_name, &symtab_start[i]);
-        }
-      }
-    }
-  }
+const SymbolIndex &ElfImg::SymtabIndex(bool name_order) const {
+  // Shared images are searched from several threads.
+  std::call_once(symtab_index_once_, [this] {
+    if (MapSymtab())
+      symtab_index_.Build(symtab_start, symtab_count, symtab_strings_);
+  });
+  if (name_order)
+    std::call_once(name_order_once_,
+                   [this] { symtab_index_.BuildNameOrder(); });
+  return symtab_index_;
+}
 
-  if (auto i = symtabs_.find(name); i != symtabs_.end()) {
-    return i->second->st_value;
+ElfW(Addr) ElfImg::LinearLookup(std::string_view name, uint32_t hash) const {
+  if (auto *sym = SymtabIndex().Find(name, hash); sym != nullptr) {
+    return sym->st_value;
   } else {
     return 0;
   }
 }
 
 std::string_view ElfImg::LinearLookupByPrefix(std::string_view name) const {
-  if (symtabs_.empty()) {
-    symtabs_.reserve(symtab_count);
-    if (symtab_start != nullptr && symstr_offset_for_symtab != 0) {
-      for (ElfW(Off) i = 0; i < symtab_count; i++) {
-        unsigned int st_type = ELF_ST_TYPE(symtab_start[i].st_info);
-        const char *st_name = offsetOf<const char *>(
-            header, symstr_offset_for_symtab + symtab_start[i].st_name);
-        if ((st_type == STT_FUNC || st_type == STT_OBJECT) &&
-            symtab_start[i].st_size) {
-          symtabs_.emplace(st_name, &symtab_start[i]);
-        }
-      }
+  auto &index = SymtabIndex(true);
+  auto matches = index.FindPrefix(name);
+  return matches.empty() ? "" : index.name(matches.front());
+}
+
+std::vector<std::string_view>
+ElfImg::findSymbolNamesByPrefix(std::string_view prefix) const {
+  auto &index = SymtabIndex(true);
+  std::vector<std::string_view> names;
+  for (uint32_t symbol : index.FindPrefix(prefix)) {
+    if (names.empty() || names.back() != index.name(symbol))
+      names.push_back(index.name(symbol));
+  }
+  return names;
+}
+
+ElfW(Addr) ElfImg::getLocalSymbAddress(std::string_view name) const {
+  if (base == nullptr)
+    return 0;
+  auto &index = SymtabIndex(true);
+  for (uint32_t symbol : index.FindPrefix(name)) {
+    // Skip longer names merely sharing the prefix.
+    auto suffix = index.name(symbol).substr(name.size());
+    if (suffix.empty() || suffix.starts_with(".llvm.")) {
+      return static_cast<ElfW(Addr)>((uintptr_t)base +
+                                     index.symbol(symbol).st_value - bias);
     }
   }
+  return 0;
+}
 
-  auto size = name.size();
-  for (auto symtab : symtabs_) {
-    if (symtab.first.size() < size)
-      continue;
+size_t ElfImg::resolveAll(std::span<const SymbolRequest> requests,
+                          std::span<ElfW(Addr)> addresses) const {
+  assert(addresses.size() >= requests.size());
+  std::vector<size_t> pending;
+  for (size_t i = 0; i < requests.size(); i++) {
+    auto &request = requests[i];
+    ElfW(Addr) offset = GnuLookup(request.name, request.gnu_hash);
+    if (offset == 0)
+      offset = ElfLookup(request.name, request.elf_hash);
+    addresses[i] = offset;
+    if (offset == 0)
+      pending.push_back(i);
+  }
 
-    if (symtab.first.substr(0, size) == name) {
-      return symtab.first;
+  if (!pending.empty() && MapSymtab()) {
+    const char *strings = symtab_strings_;
+    // Until found under its exact name, a local symbol keeps the first
+    // suffixed match.
+    std::vector<bool> exact(requests.size());
+    size_t remaining = pending.size();
+    for (ElfW(Off) i = 0; i < symtab_count && remaining > 0; i++) {
+      if (!SymbolIndex::Indexed(symtab_start[i]))
+        continue;
+      const char *st_name = strings + symtab_start[i].st_name;
+      for (size_t k : pending) {
+        auto name = requests[k].name;
+        if (exact[k] || strncmp(st_name, name.data(), name.size()) != 0)
+          continue;
+        if (st_name[name.size()] == '\0') {
+          exact[k] = true;
+          remaining--;
+          addresses[k] = symtab_start[i].st_value;
+        } else if (requests[k].local && addresses[k] == 0 &&
+                   strncmp(st_name + name.size(), ".llvm.", 6) == 0) {
+          addresses[k] = symtab_start[i].st_value;
+        }
+      }
     }
   }
 
-  return "";
+  size_t resolved = 0;
+  for (size_t i = 0; i < requests.size(); i++) {
+    if (addresses[i] != 0 && base != nullptr) {
+      addresses[i] = static_cast<ElfW(Addr)>((uintptr_t)base + addresses[i] -
+                                             bias);
+      resolved++;
+    } else {
+      addresses[i] = 0;
+    }
+  }
+  return resolved;
 }
 
 ElfImg::~ElfImg() {
-  // open elf file local
-  if (buffer) {
-    free(buffer);
-    buffer = nullptr;
-  }
-  // use mmap
-  if (header) {
-    munmap(header, size);
-  }
+  for (auto [map, length] : mappings_)
+    munmap(map, length);
 }
 
 ElfW(Addr) ElfImg::getSymbOffset(std::string_view name, uint32_t gnu_hash,
@@ -245,7 +617,7 @@ ElfW(Addr) ElfImg::getSymbOffset(std::string_view name, uint32_t gnu_hash,
     // LOGD("found %s %p in %s in dynsym by elfhash", name.data(),
     // reinterpret_cast<void *>(offset), elf.data());
     return offset;
-  } else if (offset = LinearLookup(name); offset > 0) {
+  } else if (offset = LinearLookup(name, gnu_hash); offset > 0) {
     // LOGD("found %s %p in %s in symtab by linear lookup", name.data(),
     // reinterpret_cast<void *>(offset), elf.data());
     return offset;
@@ -267,6 +639,8 @@ bool ElfImg::findModuleBase() {
         if (strstr(info->dlpi_name, self->elf.data())) {
           self->elf = info->dlpi_name;
           self->base = reinterpret_cast<void *>(info->dlpi_addr);
+          self->phdr_ = info->dlpi_phdr;
+          self->phnum_ = info->dlpi_phnum;
           return 1;
         }
         return 0;
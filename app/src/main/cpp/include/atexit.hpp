@@ -15,6 +15,10 @@
 #include <memory>
 #include <sstream>
 
+namespace SandHook {
+class ElfImg;
+}
+
 namespace Atexit {
 
 inline size_t page_size() {
@@ -126,5 +130,6 @@ private:
 };
 
 AtexitArray *findAtexitArray();
+AtexitArray *findAtexitArray(const SandHook::ElfImg &libc);
 
 } // namespace Atexit
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+namespace Scan {
+struct Report;
+}
+
+/// \brief A compact encoding of a Scan::Report that Java reads in place from
+/// a direct ByteBuffer and host tools read from a file.
+///
+/// Layout, little-endian with every field naturally aligned:
+///   Header | Record * record_count | string pool
+/// Strings are referenced by offset and length into the pool, and each is
+/// followed by a NUL for C readers. Readers step through records by
+/// record_size and ignore what follows the fields they know, so that fields
+/// can be appended without a new major version.
+namespace BinaryReport {
+
+static_assert(std::endian::native == std::endian::little,
+              "the report is written in native byte order");
+
+constexpr char kMagic[4] = {'D', 'R', 'P', 'T'};
+constexpr uint16_t kVersion = 1;
+
+struct Header {
+  char magic[4];
+  uint16_t version;
+  uint16_t header_size;
+  uint32_t total_size;
+  uint32_t record_count;
+  uint32_t record_size;
+  uint32_t records_offset;
+  uint32_t strings_offset;
+  uint32_t strings_size;
+  uint64_t generation;
+  /// \brief Wall time of the whole scan.
+  uint64_t wall_ns;
+};
+static_assert(sizeof(Header) == 48);
+
+/// \brief The result of one detector.
+struct Record {
+  enum Flags : uint32_t {
+    kDetected = 1 << 0,
+  };
+
+  uint32_t name_offset;
+  uint32_t name_length;
+  uint32_t summary_offset;
+  uint32_t summary_length;
+  uint32_t flags;
+  uint32_t reserved;
+  uint64_t wall_ns;
+  uint64_t cpu_ns;
+};
+static_assert(sizeof(Record) == 40);
+
+/// \brief Encodes \p report into \p out if it fits.
+/// \return The size of the encoding, whether or not it was written.
+size_t Encode(const Scan::Report &report, std::span<char> out);
+
+/// \brief A validated encoding, read in place.
+class View {
+public:
+  /// \return false if \p data is not a complete report of a known major
+  /// version, or if any offset in it is out of bounds.
+  bool Parse(std::span<const char> data);
+
+  const Header &header() const { return header_; }
+  size_t size() const { return header_.record_count; }
+
+  /// \brief The fields of record \p index known to this reader.
+  Record record(size_t index) const;
+
+  std::string_view name(const Record &record) const;
+  std::string_view summary(const Record &record) const;
+
+private:
+  std::string_view String(uint32_t offset, uint32_t length) const;
+
+  std::span<const char> data_;
+  Header header_{};
+};
+
+} // namespace BinaryReport
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <initializer_list>
+#include <span>
+#include <string>
+#include <string_view>
+
+/// \brief The app-private directory where results that only change with an
+/// OS update, such as decompressed symbol tables, are kept across starts.
+namespace Cache {
+
+/// \brief Sets the directory, such as the cache directory of the app.
+/// Nothing is cached until it is set.
+void SetDir(std::string_view dir);
+
+/// \return The path of \p name in the directory, or an empty string if no
+/// directory is set.
+std::string Path(std::string_view name);
+
+/// \brief Writes the concatenation of \p parts to \p path, aside and then
+/// renamed, so that a reader never sees a partial file.
+bool Store(const std::string &path,
+           std::initializer_list<std::span<const char>> parts);
+
+/// \brief Appends the lowercase hex of \p bytes, such as a build-id, to
+/// \p out.
+void AppendHex(std::string &out, std::string_view bytes);
+
+} // namespace Cache
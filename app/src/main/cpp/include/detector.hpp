@@ -0,0 +1,177 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace SandHook {
+class ElfImg;
+}
+
+namespace SoList {
+class Snapshot;
+}
+
+namespace VirtualMap {
+struct MapRegion;
+}
+
+/// \brief Detectors that declare the inputs they read, so that a run shares
+/// each input between them and runs them in parallel.
+namespace Detectors {
+
+/// \brief The inputs a detector may read, as bits of \ref Detector::inputs.
+enum Input : uint32_t {
+  /// \brief The maps, refreshed once per run by VirtualMap::RefreshMaps().
+  kMaps = 1 << 0,
+  /// \brief SoList initialized against the linker.
+  kLinker = 1 << 1,
+  /// \brief A snapshot of the soinfo list. Implies #kLinker.
+  kSoInfos = 1 << 2 | kLinker,
+  /// \brief The image of libc.
+  kLibc = 1 << 3,
+};
+
+/// \brief The inputs of one run, each computed by the first detector asking
+/// for it while the others asking wait for it.
+class Inputs {
+public:
+  Inputs();
+  ~Inputs();
+
+  /// \brief The regions of the maps, empty if they could not be read.
+  std::span<const VirtualMap::MapRegion> maps();
+
+  /// \return false if the soinfo list cannot be read.
+  bool linker();
+
+  /// \brief The soinfo list, empty if the linker is not resolved.
+  const SoList::Snapshot &soinfos();
+
+  /// \return nullptr if libc is not found.
+  const SandHook::ElfImg *libc();
+
+  /// \brief Computes the inputs of \p mask ahead of the detectors.
+  void Prepare(uint32_t mask);
+
+private:
+  std::once_flag maps_once_, linker_once_, soinfos_once_, libc_once_;
+  bool maps_ok_ = false;
+  bool linker_ok_ = false;
+  std::unique_ptr<SoList::Snapshot> soinfos_;
+  std::shared_ptr<const SandHook::ElfImg> libc_;
+};
+
+/// \brief What a detector found.
+struct Finding {
+  bool detected = false;
+  /// \brief A line of the report, omitted if empty.
+  std::string summary;
+};
+
+class Detector {
+public:
+  virtual ~Detector() = default;
+
+  /// \brief A short static name, for logs and timings.
+  virtual const char *name() const = 0;
+
+  /// \brief The \ref Input bits of everything \ref Run reads from \p inputs.
+  virtual uint32_t inputs() const = 0;
+
+  /// \brief Whether the detector is cheap enough to run periodically in the
+  /// background, see Monitor.
+  virtual bool cheap() const { return true; }
+
+  /// \brief Runs the detection. Detectors may run concurrently with each
+  /// other, never with themselves.
+  virtual Finding Run(Inputs &inputs) = 0;
+};
+
+/// \brief The finding of one detector and what it cost. The time spent
+/// computing an input is counted by the detector that asked for it first.
+struct Result {
+  const Detector *detector;
+  Finding finding;
+  uint64_t wall_ns;
+  uint64_t cpu_ns;
+};
+
+using Factory = std::unique_ptr<Detector> (*)();
+
+/// \brief Adds a detector to those \ref Registered returns, ordered by
+/// \p order and then by name, whatever the order of static initialization.
+bool Register(int order, Factory factory);
+
+/// \brief One instance of every registered detector.
+std::span<Detector *const> Registered();
+
+/// \brief Runs detectors on a small pool of threads. Each worker takes tasks
+/// from the back of its own queue and steals from the front of the others,
+/// so a long detector only keeps one worker busy.
+class Scheduler {
+public:
+  /// \param threads The number of workers, counting the thread calling
+  /// \ref Run, so that 1 runs the detectors serially on it.
+  explicit Scheduler(size_t threads = DefaultThreads());
+  ~Scheduler();
+
+  Scheduler(const Scheduler &) = delete;
+  Scheduler &operator=(const Scheduler &) = delete;
+
+  /// \brief Runs \p detectors on fresh inputs, of which those declared by
+  /// more than one detector are computed as tasks of their own. Runs of all
+  /// schedulers are serialized, since detectors keep state between runs.
+  /// \return The results in the order of \p detectors.
+  std::vector<Result> Run(std::span<Detector *const> detectors);
+
+  /// \brief \ref Run, unless another run is in progress.
+  /// \return false, leaving \p results alone, if one is.
+  bool TryRun(std::span<Detector *const> detectors,
+              std::vector<Result> &results);
+
+  size_t threads() const { return workers_.size(); }
+
+  static size_t DefaultThreads();
+
+private:
+  struct Worker {
+    std::mutex mutex;
+    std::deque<std::function<void()>> tasks;
+  };
+
+  std::vector<Result> RunLocked(std::span<Detector *const> detectors);
+  bool Take(size_t self, std::function<void()> &task);
+  void Work(size_t self);
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+  std::vector<std::thread> threads_;
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::condition_variable done_;
+  std::atomic<size_t> queued_ = 0;
+  size_t pending_ = 0;
+  bool stop_ = false;
+};
+
+/// \brief Runs every registered detector on a shared \ref Scheduler.
+std::vector<Result> RunAll();
+
+} // namespace Detectors
+
+/// \brief Registers \p type, default constructed, at position \p order of the
+/// report. Use it once in the translation unit defining the detector.
+#define REGISTER_DETECTOR(type, order)                                         \
+  [[maybe_unused]] static const bool type##_registered =                       \
+      ::Detectors::Register(                                                   \
+          order, []() -> std::unique_ptr<::Detectors::Detector> {              \
+            return std::make_unique<type>();                                   \
+          })
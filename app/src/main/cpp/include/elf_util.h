@@ -20,25 +20,41 @@
 #ifndef SANDHOOK_ELF_UTIL_H
 #define SANDHOOK_ELF_UTIL_H
 
+#include "symbol_index.hpp"
 #include <link.h>
-#include <linux/elf.h>
+#include <memory>
+#include <mutex>
+#include <span>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <sys/types.h>
-#include <unordered_map>
+#include <vector>
 
 #define SHT_GNU_HASH 0x6ffffff6
 
 namespace SandHook {
+struct SymbolRequest;
+
 class ElfImg {
 public:
   ElfImg(std::string_view elf);
 
-  constexpr ElfW(Addr) getSymbOffset(std::string_view name) const {
+  /// \brief The image of the loaded module whose path contains \p elf,
+  /// shared by all callers until that module is unloaded or reloaded at
+  /// another base, so that it is parsed and indexed once per load.
+  /// \return nullptr if no such module is loaded.
+  static std::shared_ptr<const ElfImg> Shared(std::string_view elf);
+
+  ElfImg(const ElfImg &) = delete;
+
+  ElfImg &operator=(const ElfImg &) = delete;
+
+  ElfW(Addr) getSymbOffset(std::string_view name) const {
     return getSymbOffset(name, GnuHash(name), ElfHash(name));
   }
 
-  constexpr ElfW(Addr) getSymbAddress(std::string_view name) const {
+  ElfW(Addr) getSymbAddress(std::string_view name) const {
     ElfW(Addr) offset = getSymbOffset(name);
     if (offset > 0 && base != nullptr) {
       return static_cast<ElfW(Addr)>((uintptr_t)base + offset - bias);
@@ -47,22 +63,75 @@ public:
     }
   }
 
+  /// \brief The lexicographically first .symtab name starting with \p prefix.
   std::string_view findSymbolNameByPrefix(std::string_view prefix) const {
     return LinearLookupByPrefix(prefix);
   }
 
-  template <typename T>
-  constexpr T getSymbAddress(std::string_view name) const {
+  /// \brief Every distinct .symtab name starting with \p prefix, in
+  /// lexicographic order.
+  std::vector<std::string_view>
+  findSymbolNamesByPrefix(std::string_view prefix) const;
+
+  /// \brief Address of the local symbol \p name, which LTO may have renamed
+  /// to name.llvm.<hash>, in a single prefix search of .symtab.
+  ElfW(Addr) getLocalSymbAddress(std::string_view name) const;
+
+  template <typename T> T getLocalSymbAddress(std::string_view name) const {
+    return reinterpret_cast<T>(getLocalSymbAddress(name));
+  }
+
+  template <typename T> T getSymbAddress(std::string_view name) const {
     return reinterpret_cast<T>(getSymbAddress(name));
   }
 
+  /// \brief Resolves a batch of symbols into \p addresses, 0 for those not
+  /// found: the dynamic tables are probed for every request first, then a
+  /// single pass over .symtab resolves the rest, without building its index.
+  /// \return The number of symbols resolved.
+  size_t resolveAll(std::span<const SymbolRequest> requests,
+                    std::span<ElfW(Addr)> addresses) const;
+
   bool isValid() const { return base != nullptr; }
 
   const std::string name() const { return elf; }
 
+  /// \brief The GNU build-id of the file, empty if it has none.
+  std::string_view buildId() const { return build_id_; }
+
+  constexpr static uint32_t ElfHash(std::string_view name);
+
+  constexpr static uint32_t GnuHash(std::string_view name);
+
   ~ElfImg();
 
 private:
+  /// \brief Loads the module \p path already found at \p base.
+  ElfImg(std::string_view path, void *base, const ElfW(Phdr) * phdr,
+         ElfW(Half) phnum);
+
+  /// \brief Reads the ELF and section headers, and finds the dynamic tables.
+  void Load();
+
+  /// \brief Points the dynamic tables at the loaded image through its
+  /// PT_DYNAMIC segment.
+  bool LoadDynamicTables();
+
+  void SetSysvHash(ElfW(Word) * d_un);
+
+  void SetGnuHash(ElfW(Word) * d_buf);
+
+  /// \brief Maps the pages holding [offset, offset + size) of the file.
+  void *MapSection(int fd, ElfW(Off) offset, ElfW(Off) size) const;
+
+  /// \brief Maps .symtab and .strtab on first use, or the symbol table of
+  /// .gnu_debugdata if the image is stripped.
+  bool MapSymtab() const;
+
+  /// \brief Points the symbol table at the MiniDebugInfo of the image,
+  /// cached or decompressed.
+  void LoadMiniDebugInfo() const;
+
   ElfW(Addr) getSymbOffset(std::string_view name, uint32_t gnu_hash,
                            uint32_t elf_hash) const;
 
@@ -70,35 +139,40 @@ private:
 
   ElfW(Addr) GnuLookup(std::string_view name, uint32_t hash) const;
 
-  ElfW(Addr) LinearLookup(std::string_view name) const;
+  ElfW(Addr) LinearLookup(std::string_view name, uint32_t hash) const;
 
   std::string_view LinearLookupByPrefix(std::string_view name) const;
 
-  constexpr static uint32_t ElfHash(std::string_view name);
-
-  constexpr static uint32_t GnuHash(std::string_view name);
+  const SymbolIndex &SymtabIndex(bool name_order = false) const;
 
   bool findModuleBase();
 
   std::string elf;
   void *base = nullptr;
-  char *buffer = nullptr;
-  off_t size = 0;
+  const ElfW(Phdr) *phdr_ = nullptr;
+  ElfW(Half) phnum_ = 0;
   off_t bias = -4396;
-  ElfW(Ehdr) *header = nullptr;
-  ElfW(Shdr) *section_header = nullptr;
-  ElfW(Shdr) *symtab = nullptr;
-  ElfW(Shdr) *strtab = nullptr;
-  ElfW(Shdr) *dynsym = nullptr;
-  ElfW(Sym) *symtab_start = nullptr;
+  /// \brief The dynamic symbol table, in the loaded image when its
+  /// PT_DYNAMIC could be read, else mapped from the file.
   ElfW(Sym) *dynsym_start = nullptr;
-  ElfW(Sym) *strtab_start = nullptr;
-  ElfW(Off) symtab_count = 0;
-  ElfW(Off) symstr_offset = 0;
-  ElfW(Off) symstr_offset_for_symtab = 0;
+  const char *strtab_start = nullptr;
+  /// \brief File ranges of .symtab and .strtab, mapped by #MapSymtab().
   ElfW(Off) symtab_offset = 0;
-  ElfW(Off) dynsym_offset = 0;
   ElfW(Off) symtab_size = 0;
+  ElfW(Off) symstr_offset_for_symtab = 0;
+  ElfW(Off) symstr_size_for_symtab = 0;
+  /// \brief File range of .gnu_debugdata, and the GNU build-id that keys
+  /// its cached symbol table.
+  ElfW(Off) debugdata_offset_ = 0;
+  ElfW(Off) debugdata_size_ = 0;
+  std::string build_id_;
+  mutable ElfW(Off) symtab_count = 0;
+  mutable const ElfW(Sym) *symtab_start = nullptr;
+  mutable const char *symtab_strings_ = nullptr;
+  /// \brief The decompressed MiniDebugInfo, when it could not be cached.
+  mutable std::vector<char> debugdata_;
+  mutable std::once_flag symtab_once_;
+  mutable std::vector<std::pair<void *, size_t>> mappings_;
 
   uint32_t nbucket_{};
   uint32_t *bucket_ = nullptr;
@@ -112,7 +186,11 @@ private:
   uint32_t *gnu_bucket_;
   uint32_t *gnu_chain_;
 
-  mutable std::unordered_map<std::string_view, ElfW(Sym) *> symtabs_;
+  /// \brief Index of .symtab, built by the first lookup missing .dynsym, or
+  /// sorted by name by the first prefix search.
+  mutable SymbolIndex symtab_index_;
+  mutable std::once_flag symtab_index_once_;
+  mutable std::once_flag name_order_once_;
 };
 
 constexpr uint32_t ElfImg::ElfHash(std::string_view name) {
@@ -127,12 +205,23 @@ constexpr uint32_t ElfImg::ElfHash(std::string_view name) {
 }
 
 constexpr uint32_t ElfImg::GnuHash(std::string_view name) {
-  uint32_t h = 5381;
-  for (unsigned char p : name) {
-    h += (h << 5) + p;
-  }
-  return h;
+  return SymbolIndex::Hash(name);
 }
+
+/// \brief A symbol for ElfImg::resolveAll(). Both hashes are computed at
+/// compile time for requests declared constexpr.
+struct SymbolRequest {
+  constexpr SymbolRequest(std::string_view name, bool local = false)
+      : name(name), gnu_hash(ElfImg::GnuHash(name)),
+        elf_hash(ElfImg::ElfHash(name)), local(local) {}
+
+  std::string_view name;
+  uint32_t gnu_hash;
+  uint32_t elf_hash;
+  /// \brief Whether the symbol is local, so that LTO may have renamed it to
+  /// name.llvm.<hash>.
+  bool local;
+};
 } // namespace SandHook
 
 #endif // SANDHOOK_ELF_UTIL_H
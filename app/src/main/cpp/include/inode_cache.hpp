@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <sys/types.h>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace VirtualMap {
+
+/// \brief Remembers whether the file mapped as (dev, inode, path) still
+/// resolves to the mapped inode on disk.
+///
+/// Entries are reference counted by the mappings using them: a file mapped
+/// several times is checked once, and its entry is dropped when the last
+/// mapping goes away, so a library reloaded from a replaced file is checked
+/// again under its new key. A file replaced under its path by a mount, such
+/// as a bind mount, keeps its key, so every entry is checked again when the
+/// mount table changes. Pending checks are resolved in batches with statx
+/// through io_uring where the platform allows it, and one stat() per file
+/// otherwise.
+class InodeCache {
+public:
+  enum class State : uint8_t { kPending, kConsistent, kInconsistent };
+
+  struct Entry {
+    State state = State::kPending;
+    uint32_t refs = 0;
+  };
+
+  struct Stats {
+    /// \brief Calls to Acquire().
+    size_t lookups = 0;
+    /// \brief Lookups answered by an existing entry.
+    size_t hits = 0;
+    /// \brief Entries dropped after their last mapping was released.
+    size_t evictions = 0;
+    /// \brief Synchronous stat() calls.
+    size_t stat_calls = 0;
+    /// \brief io_uring_enter() calls, each covering a batch of statx.
+    size_t uring_submits = 0;
+    /// \brief Files checked through io_uring.
+    size_t uring_statx = 0;
+    /// \brief poll() calls on the mount table.
+    size_t mount_polls = 0;
+    /// \brief Mount table changes, each making every entry pending.
+    size_t invalidations = 0;
+
+    size_t syscalls() const {
+      return stat_calls + uring_submits + mount_polls;
+    }
+  };
+
+  InodeCache();
+  ~InodeCache();
+
+  InodeCache(const InodeCache &) = delete;
+  void operator=(const InodeCache &) = delete;
+
+  /// \brief Takes a reference on the entry of a mapped file. New entries are
+  /// pending until the next #Flush(). The pointer is stable until the entry
+  /// is released for the last time.
+  const Entry *Acquire(dev_t dev, ino_t inode, std::string_view path);
+
+  /// \brief The entry of a file acquired before, or nullptr.
+  const Entry *Find(dev_t dev, ino_t inode, std::string_view path) const;
+
+  /// \brief Drops a reference taken by #Acquire().
+  void Release(dev_t dev, ino_t inode, std::string_view path);
+
+  /// \brief Makes every entry pending if the mount table changed since the
+  /// previous call, or since the cache was created.
+  /// \return Whether it changed.
+  bool InvalidateOnMountChange();
+
+  /// \brief Checks every pending entry.
+  void Flush();
+
+  const Stats &stats() const { return stats_; }
+
+  size_t size() const { return entries_.size(); }
+
+private:
+  struct Key {
+    dev_t dev;
+    ino_t inode;
+    std::string path;
+  };
+  struct KeyView {
+    dev_t dev;
+    ino_t inode;
+    std::string_view path;
+  };
+  struct KeyHash {
+    using is_transparent = void;
+    size_t operator()(const KeyView &key) const;
+    size_t operator()(const Key &key) const {
+      return (*this)(KeyView{key.dev, key.inode, key.path});
+    }
+  };
+  struct KeyEqual {
+    using is_transparent = void;
+    template <typename A, typename B>
+    bool operator()(const A &a, const B &b) const {
+      return a.dev == b.dev && a.inode == b.inode &&
+             std::string_view(a.path) == std::string_view(b.path);
+    }
+  };
+  using Map = std::unordered_map<Key, Entry, KeyHash, KeyEqual>;
+
+  struct Ring;
+
+  void StatSync(Map::value_type &entry);
+
+  Map entries_;
+  std::vector<Map::value_type *> pending_;
+  std::unique_ptr<Ring> ring_;
+  // /proc/self/mountinfo, which polls with POLLPRI once after each change.
+  int mountinfo_ = -1;
+  Stats stats_;
+};
+
+} // namespace VirtualMap
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <string>
+
+/// \brief Scoped instrumentation of the hot paths of the detectors, built in
+/// with -DDEMO_INSTRUMENTATION and compiled out otherwise.
+///
+/// Each INSTRUMENT_SCOPE site keeps a histogram of its wall time and the
+/// totals of what its scopes cost on their thread: syscalls and bytes read
+/// through the counted wrappers, heap allocations and page faults. Scopes
+/// nest, and a scope includes the costs of those it encloses.
+namespace Instrument {
+
+/// \brief One line with the counters of every site that ran, or an empty
+/// string if built without instrumentation.
+std::string Summary();
+
+} // namespace Instrument
+
+#ifdef DEMO_INSTRUMENTATION
+
+#include <atomic>
+#include <cstdint>
+
+namespace Instrument {
+
+/// \brief What the calling thread did so far, counted at the call sites.
+struct Counters {
+  uint64_t syscalls;
+  uint64_t proc_bytes;
+  uint64_t allocations;
+};
+
+inline thread_local Counters counters{};
+
+class Site {
+public:
+  static constexpr int kBuckets = 24;
+
+  explicit Site(const char *name);
+
+  const char *name() const { return name_; }
+
+  /// \brief Records a scope of \p wall_ns that cost \p delta and
+  /// \p page_faults.
+  void Record(uint64_t wall_ns, const Counters &delta, uint64_t page_faults);
+
+private:
+  friend std::string Summary();
+
+  const char *name_;
+  Site *next_;
+  std::atomic<uint64_t> count_ = 0;
+  std::atomic<uint64_t> wall_ns_ = 0;
+  std::atomic<uint64_t> syscalls_ = 0;
+  std::atomic<uint64_t> proc_bytes_ = 0;
+  std::atomic<uint64_t> allocations_ = 0;
+  std::atomic<uint64_t> page_faults_ = 0;
+  /// \brief Bucket i counts scopes of less than 2^(i+1) microseconds, the
+  /// last one all longer scopes.
+  std::atomic<uint64_t> histogram_[kBuckets] = {};
+};
+
+/// \brief The site of \p name, created on first use, for names only known
+/// at run time such as those of detectors. \p name must outlive it.
+Site &SiteNamed(const char *name);
+
+class Scope {
+public:
+  explicit Scope(Site &site);
+  ~Scope();
+
+  Scope(const Scope &) = delete;
+  Scope &operator=(const Scope &) = delete;
+
+private:
+  Site &site_;
+  uint64_t wall_ns_;
+  Counters counters_;
+  uint64_t page_faults_;
+};
+
+} // namespace Instrument
+
+#define INSTRUMENT_CONCAT_(a, b) a##b
+#define INSTRUMENT_CONCAT(a, b) INSTRUMENT_CONCAT_(a, b)
+
+/// \brief Instruments the rest of the enclosing block as \p name.
+#define INSTRUMENT_SCOPE(name)                                                 \
+  static ::Instrument::Site INSTRUMENT_CONCAT(instrument_site_,               \
+                                              __LINE__)(name);                 \
+  ::Instrument::Scope INSTRUMENT_CONCAT(instrument_scope_, __LINE__)(         \
+      INSTRUMENT_CONCAT(instrument_site_, __LINE__))
+
+/// \brief Like INSTRUMENT_SCOPE for a name only known at run time.
+#define INSTRUMENT_NAMED_SCOPE(name)                                           \
+  ::Instrument::Scope INSTRUMENT_CONCAT(instrument_scope_, __LINE__)(         \
+      ::Instrument::SiteNamed(name))
+
+/// \brief Counts a syscall made by the calling thread.
+#define INSTRUMENT_SYSCALL() (::Instrument::counters.syscalls++)
+
+/// \brief Counts \p bytes read from /proc by the calling thread.
+#define INSTRUMENT_PROC_READ(bytes)                                            \
+  (::Instrument::counters.proc_bytes += (bytes))
+
+#else
+
+#define INSTRUMENT_SCOPE(name)
+#define INSTRUMENT_NAMED_SCOPE(name)
+#define INSTRUMENT_SYSCALL() ((void)0)
+#define INSTRUMENT_PROC_READ(bytes) ((void)0)
+
+#endif
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string_view>
+#include <sys/types.h>
+
+namespace ProcFs {
+
+/// \brief What a \ref LineReader reads: a file, or the contents of one held
+/// in memory, so that the parsers can be run on recorded or synthetic /proc
+/// files off the device.
+class Source {
+public:
+  /// \brief The file at \p path. Implicit, as most readers read a file.
+  Source(const char *path) : path_(path) {}
+
+  /// \brief \p contents, which must outlive the readers of the source.
+  static Source Memory(std::string_view contents) {
+    Source source(nullptr);
+    source.contents_ = contents;
+    return source;
+  }
+
+  /// \brief The path of the file, or nullptr for contents in memory.
+  const char *path() const { return path_; }
+  std::string_view contents() const { return contents_; }
+
+private:
+  const char *path_;
+  std::string_view contents_;
+};
+
+/// \brief Reads a text file, typically under /proc, in large chunks and hands
+/// out its lines as views into a reusable buffer.
+///
+/// Lines are returned without their trailing newline. A returned view is only
+/// valid until the next call to #Next() or #Rewind(). Contents in memory are
+/// copied into the buffer like reads from a file, so that the parse costs
+/// the same apart from the syscalls.
+class LineReader {
+public:
+  /// \brief Size of a single read() request, and the initial buffer size.
+  static constexpr size_t kChunkSize = 64 * 1024;
+
+  explicit LineReader(Source source);
+  ~LineReader();
+
+  LineReader(const LineReader &) = delete;
+  void operator=(const LineReader &) = delete;
+
+  /// \brief Whether the underlying file could be opened.
+  bool ok() const { return fd_ >= 0 || memory_.data() != nullptr; }
+
+  /// \brief Fetches the next line.
+  /// \return false once the end of the file is reached or on read errors.
+  bool Next(std::string_view &line);
+
+  /// \brief Restarts reading from the beginning of the file, keeping the
+  /// descriptor and the buffer. For /proc files this yields fresh content.
+  bool Rewind();
+
+  /// \brief Total number of bytes read from the file so far.
+  size_t bytes_read() const { return bytes_read_; }
+
+private:
+  bool Fill();
+  ssize_t Read(char *into, size_t size);
+
+  int fd_ = -1;
+  std::string_view memory_;
+  size_t memory_offset_ = 0;
+  std::unique_ptr<char[]> buffer_;
+  size_t capacity_ = 0;
+  size_t begin_ = 0;
+  size_t end_ = 0;
+  size_t bytes_read_ = 0;
+  bool eof_ = false;
+};
+
+} // namespace ProcFs
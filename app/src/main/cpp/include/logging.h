@@ -1,31 +1,111 @@
 #pragma once
 
-#include <android/log.h>
 #include <errno.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <memory>
+
+#ifdef __ANDROID__
+#include <android/log.h>
+#else
+// Host builds (benchmarks) log with the logcat priorities.
+enum {
+  ANDROID_LOG_VERBOSE = 2,
+  ANDROID_LOG_DEBUG,
+  ANDROID_LOG_INFO,
+  ANDROID_LOG_WARN,
+  ANDROID_LOG_ERROR,
+  ANDROID_LOG_FATAL,
+};
+#endif
 
 #ifndef LOG_TAG
 #define LOG_TAG "Demo"
 #endif
 
-#ifndef NDEBUG
-#define LOGD(...) logging::log(ANDROID_LOG_DEBUG, LOG_TAG, __VA_ARGS__)
-#define LOGV(...) logging::log(ANDROID_LOG_VERBOSE, LOG_TAG, __VA_ARGS__)
+// Messages below this priority are compiled out, arguments included. CMake
+// sets it from DEMO_LOG_MIN_PRIORITY.
+#ifndef LOG_MIN_PRIORITY
+#ifdef NDEBUG
+#define LOG_MIN_PRIORITY ANDROID_LOG_INFO
 #else
-#define LOGD(...)
-#define LOGV(...)
+#define LOG_MIN_PRIORITY ANDROID_LOG_VERBOSE
 #endif
-#define LOGI(...) logging::log(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
-#define LOGW(...) logging::log(ANDROID_LOG_WARN, LOG_TAG, __VA_ARGS__)
-#define LOGE(...) logging::log(ANDROID_LOG_ERROR, LOG_TAG, __VA_ARGS__)
-#define LOGF(...) logging::log(ANDROID_LOG_FATAL, LOG_TAG, __VA_ARGS__)
+#endif
+
+#define LOG_AT(prio, ...)                                                      \
+  do {                                                                         \
+    if constexpr ((prio) >= LOG_MIN_PRIORITY)                                  \
+      logging::log(prio, LOG_TAG, __VA_ARGS__);                                \
+  } while (0)
+
+#define LOGD(...) LOG_AT(ANDROID_LOG_DEBUG, __VA_ARGS__)
+#define LOGV(...) LOG_AT(ANDROID_LOG_VERBOSE, __VA_ARGS__)
+#define LOGI(...) LOG_AT(ANDROID_LOG_INFO, __VA_ARGS__)
+#define LOGW(...) LOG_AT(ANDROID_LOG_WARN, __VA_ARGS__)
+#define LOGE(...) LOG_AT(ANDROID_LOG_ERROR, __VA_ARGS__)
+#define LOGF(...) LOG_AT(ANDROID_LOG_FATAL, __VA_ARGS__)
 #define PLOGE(fmt, args...)                                                    \
   LOGE(fmt " failed with %d: %s", ##args, errno, strerror(errno))
 
+/// \brief Asynchronous logging: messages are formatted on the calling thread
+/// into a ring buffer of its own, without locks, and written to the sink by
+/// a background thread.
+///
+/// Messages of one thread keep their order; those of different threads may
+/// be written out of order. A thread whose ring is full writes the pending
+/// messages out itself, so none are lost.
 namespace logging {
-inline void log(int prio, const char *tag, const char *fmt, ...) {
-  va_list ap;
-  va_start(ap, fmt);
-  __android_log_vprint(prio, tag, fmt, ap);
-  va_end(ap);
-}
+
+/// \brief Where the background thread writes messages. Only that thread, or
+/// one calling #Flush(), calls it, never two at once.
+class Sink {
+public:
+  virtual ~Sink() = default;
+
+  virtual void Write(int prio, const char *tag, const char *message) = 0;
+};
+
+#ifdef __ANDROID__
+class LogcatSink : public Sink {
+public:
+  void Write(int prio, const char *tag, const char *message) override;
+};
+#endif
+
+/// \brief Writes "<priority letter>/<tag>: <message>" lines to a stream.
+class StreamSink : public Sink {
+public:
+  explicit StreamSink(FILE *stream, bool owned = false)
+      : stream_(stream), owned_(owned) {}
+  ~StreamSink() override;
+
+  /// \brief A sink appending to the file at \p path, or nullptr if it cannot
+  /// be opened.
+  static std::unique_ptr<StreamSink> Open(const char *path);
+
+  void Write(int prio, const char *tag, const char *message) override;
+
+private:
+  FILE *stream_;
+  bool owned_;
+};
+
+/// \brief Logcat on Android. On a host, the file named by $DEMO_LOG_FILE if
+/// set, stderr otherwise.
+std::unique_ptr<Sink> DefaultSink();
+
+/// \brief Replaces the sink, after writing the pending messages to the
+/// previous one. A null sink discards messages.
+void SetSink(std::unique_ptr<Sink> sink);
+
+/// \brief Writes every pending message before returning. Fatal messages and
+/// exit() flush by themselves.
+void Flush();
+
+void log(int prio, const char *tag, const char *fmt, ...)
+    __attribute__((format(printf, 3, 4)));
+
 } // namespace logging
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "vmap.hpp"
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace VirtualMap {
+
+/// \brief A region kept by \ref MapSnapshot. Its path points into the path
+/// pool of the snapshot generation that holds it.
+struct MapRegion {
+  uintptr_t start;
+  uintptr_t end;
+  uintptr_t offset;
+  dev_t dev;
+  ino_t inode;
+  std::string_view path;
+  uint8_t perms;
+  bool is_private;
+  /// \brief Result of the last check run on this region, or nullptr if it was
+  /// found clean. Carried over while the region stays unchanged.
+  const char *verdict = nullptr;
+
+  bool SameMapping(const MapRegion &other) const {
+    return start == other.start && end == other.end &&
+           offset == other.offset && dev == other.dev &&
+           inode == other.inode && path == other.path;
+  }
+
+  MapInfo ToOwned() const {
+    return {start, end, perms, is_private, offset, dev, inode,
+            std::string(path)};
+  }
+};
+
+/// \brief Regions that differ between two consecutive refreshes.
+///
+/// Pointers to current regions stay valid until the next refresh, and those
+/// to previous regions until the one after it.
+struct MapDelta {
+  /// \brief Regions new to the current snapshot.
+  std::vector<MapRegion *> added;
+  /// \brief Regions of the previous snapshot that are gone.
+  std::vector<const MapRegion *> removed;
+  /// \brief (previous, current) pairs of the same mapping whose permissions or
+  /// sharing changed.
+  std::vector<std::pair<const MapRegion *, MapRegion *>> changed;
+
+  bool empty() const {
+    return added.empty() && removed.empty() && changed.empty();
+  }
+
+  void clear() {
+    added.clear();
+    removed.clear();
+    changed.clear();
+  }
+};
+
+/// \brief Keeps the last scan of a maps file, sorted by address as the kernel
+/// prints it, and reports what changed on each refresh.
+///
+/// Both generations are double buffered, so a steady-state refresh costs one
+/// parse of the file and no allocations.
+class MapSnapshot {
+public:
+  explicit MapSnapshot(ProcFs::Source maps = "/proc/self/maps")
+      : scanner_(maps) {}
+
+  /// \brief Rescans the file and fills \p delta with the differences to the
+  /// previous scan. The first refresh reports every region as added.
+  bool Refresh(MapDelta &delta);
+
+  std::vector<MapRegion> &regions() { return current_.regions; }
+  const std::vector<MapRegion> &regions() const { return current_.regions; }
+
+  /// \brief Number of completed refreshes.
+  size_t generation() const { return generation_; }
+
+private:
+  struct Generation {
+    std::vector<MapRegion> regions;
+    std::string paths;
+    std::vector<size_t> path_offsets;
+  };
+
+  bool Load(Generation &into);
+
+  MapsScanner scanner_;
+  Generation current_;
+  Generation previous_;
+  size_t generation_ = 0;
+};
+
+} // namespace VirtualMap
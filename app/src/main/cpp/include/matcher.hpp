@@ -0,0 +1,63 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace Matcher {
+
+/// \brief Finds every occurrence of a fixed set of byte patterns in one pass
+/// over a text.
+///
+/// The patterns are compiled into an Aho-Corasick automaton whose failure
+/// links are folded into a dense transition table over the bytes that occur
+/// in the patterns, so scanning costs one table lookup per input byte
+/// whatever the number of patterns.
+class AhoCorasick {
+public:
+  AhoCorasick() = default;
+  /// \param ignore_case Whether ASCII letters match regardless of case.
+  explicit AhoCorasick(std::span<const std::string_view> patterns,
+                       bool ignore_case = false);
+
+  /// \brief Calls \p visitor with (pattern index, end offset) for every
+  /// occurrence in \p text, in order of their end offset. The visitor returns
+  /// false to stop the scan.
+  /// \return false if the visitor stopped the scan.
+  template <typename Visitor>
+  bool Scan(std::string_view text, Visitor &&visitor) const {
+    if (classes_ == 0)
+      return true;
+    uint32_t state = 0;
+    for (size_t i = 0; i < text.size(); i++) {
+      state = next_[state * classes_ +
+                    class_of_[static_cast<unsigned char>(text[i])]];
+      for (uint32_t k = output_begin_[state]; k < output_begin_[state + 1];
+           k++) {
+        if (!visitor(outputs_[k], i + 1))
+          return false;
+      }
+    }
+    return true;
+  }
+
+  /// \brief Whether any pattern occurs in \p text.
+  bool Matches(std::string_view text) const {
+    return !Scan(text, [](uint32_t, size_t) { return false; });
+  }
+
+  size_t size() const { return patterns_; }
+
+private:
+  std::array<uint8_t, 256> class_of_{};
+  uint32_t classes_ = 0;
+  uint32_t patterns_ = 0;
+  std::vector<uint32_t> next_;
+  std::vector<uint32_t> output_begin_;
+  std::vector<uint32_t> outputs_;
+};
+
+} // namespace Matcher
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <link.h>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/// \brief Symbols of MiniDebugInfo, the xz-compressed ELF that stripped
+/// images keep in .gnu_debugdata with the .symtab entries missing from
+/// .dynsym, such as the static variables of the linker.
+///
+/// Decompressing it takes milliseconds, so the symbol table is cached in
+/// Cache::Path() under the build-id of the image and mapped from there
+/// afterwards.
+namespace SandHook::MiniDebugInfo {
+
+/// \brief A symbol table and the string table its names are offsets into.
+struct Symtab {
+  std::span<const ElfW(Sym)> symbols;
+  std::span<const char> strings;
+};
+
+/// \brief Decompresses the xz stream \p xz into \p elf.
+/// \return false if it is corrupt or not compressed the way MiniDebugInfo
+/// is, see Xz::Decode().
+bool Decompress(std::span<const char> xz, std::vector<char> &elf);
+
+/// \brief Finds the .symtab of the ELF file held in \p elf.
+bool FindSymtab(std::span<const char> elf, Symtab &symtab);
+
+/// \brief Maps the table cached for the image with \p build_id.
+/// \param mapping Set to the mapping backing \p symtab, which the caller
+/// unmaps.
+bool LoadCached(std::string_view build_id, Symtab &symtab,
+                std::pair<void *, size_t> &mapping);
+
+/// \brief Caches the symbols of \p symtab worth resolving for the image with
+/// \p build_id. Failures are ignored, the table is decompressed again next
+/// time.
+void StoreCached(std::string_view build_id, const Symtab &symtab);
+
+} // namespace SandHook::MiniDebugInfo
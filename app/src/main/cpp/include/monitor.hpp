@@ -0,0 +1,44 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+/// \brief Runs the cheap detectors periodically on a low-priority thread, to
+/// catch injections made after the app started.
+///
+/// The interval doubles up to Options::max_interval while the findings stay
+/// the same, and drops back to Options::min_interval when they change, at
+/// which point a full scan is requested from Scan. It is also stretched so
+/// that the thread never uses more than Options::cpu_budget of a CPU.
+namespace Monitor {
+
+struct Options {
+  std::chrono::milliseconds min_interval{250};
+  std::chrono::milliseconds max_interval{8000};
+  /// \brief The fraction of one CPU the thread may use, averaged per tick.
+  double cpu_budget = 0.002;
+};
+
+struct Stats {
+  uint64_t ticks;
+  /// \brief Ticks skipped because a scan was running.
+  uint64_t skipped;
+  /// \brief Ticks whose findings differed from those of the previous one.
+  uint64_t changes;
+  /// \brief CPU time of the monitor thread.
+  uint64_t cpu_ns;
+  std::chrono::milliseconds interval;
+};
+
+/// \brief Starts the thread, or updates its options if already running.
+void Start(const Options &options = {});
+
+/// \brief Stops the thread and waits for it, at most for one tick. Ticks
+/// never wait for a scan.
+void Stop();
+
+bool Running();
+
+Stats GetStats();
+
+} // namespace Monitor
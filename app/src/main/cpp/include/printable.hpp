@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace Printable {
+
+/// \brief A run of printable ASCII characters (0x20 to 0x7e), as an offset
+/// into the scanned buffer and a length.
+struct Run {
+  size_t offset;
+  size_t length;
+};
+
+enum class Kernel {
+  /// \brief The widest kernel the CPU supports.
+  kAuto,
+  kScalar,
+  /// \brief SSE2 on x86, NEON on ARM; 16 bytes per step.
+  kVector128,
+  /// \brief AVX2 on x86-64; 32 bytes per step.
+  kVector256,
+};
+
+/// \brief The kernel kAuto resolves to on this CPU.
+Kernel BestKernel();
+
+const char *KernelName(Kernel kernel);
+
+/// \brief Finds the runs of printable characters of a buffer.
+///
+/// The buffer is classified a page at a time into a bitmap by a vector kernel
+/// handling 16 or 32 bytes per step, and the runs are then read off the
+/// bitmap 64 bytes at a time. Runs are written into caller-provided storage,
+/// so finding them does not allocate. #Next() resumes where the previous
+/// call stopped.
+class RunFinder {
+public:
+  RunFinder(const char *data, size_t size, size_t min_length,
+            Kernel kernel = Kernel::kAuto);
+
+  /// \brief Fills \p out with the next runs of at least the minimum length.
+  /// \return The number of runs written, 0 once the buffer is exhausted.
+  size_t Next(std::span<Run> out);
+
+private:
+  /// \brief Sets bit i of bits[i / 64] for each printable data[i], for
+  /// size <= kChunkSize.
+  using Classifier = void (*)(const char *data, size_t size, uint64_t *bits);
+
+  static constexpr size_t kChunkSize = 4096;
+
+  const char *data_;
+  size_t size_;
+  size_t min_length_;
+  size_t position_ = 0;
+  Classifier classify_;
+};
+
+} // namespace Printable
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "detector.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// \brief Runs the detectors on a worker thread of their own, so that callers
+/// such as the UI thread never wait on procfs or ELF parsing.
+///
+/// Requests made while a scan is pending are coalesced into it. The last
+/// report is published without locks: reading it again costs no scan and
+/// never blocks the worker.
+namespace Scan {
+
+struct Report {
+  /// \brief The number of the scan, from 1.
+  uint64_t generation;
+  /// \brief Wall time of the whole scan.
+  uint64_t wall_ns;
+  std::vector<Detectors::Result> results;
+  /// \brief The summaries of the results, one per line.
+  std::string text;
+};
+
+/// \brief Called on the worker thread after each report is published.
+using Listener = void (*)(const Report &report);
+
+void SetListener(Listener listener);
+
+/// \brief Asks for a scan that starts after this call.
+/// \return The generation of the report that answers the request, which is
+/// that of a scan already waiting to start if there is one.
+uint64_t Request();
+
+/// \brief Blocks until the report of generation \p ticket is published.
+void Wait(uint64_t ticket);
+
+/// \brief The generation of the last published report, 0 if none.
+uint64_t Completed();
+
+/// \brief Pins the last published report, which is not reused while pinned.
+/// Pinning takes no lock; a pin should be short, since the worker needs a
+/// free slot to publish.
+class Pinned {
+public:
+  Pinned();
+  ~Pinned();
+
+  Pinned(const Pinned &) = delete;
+  Pinned &operator=(const Pinned &) = delete;
+
+  /// \return false if no report was published yet.
+  explicit operator bool() const { return slot_ != nullptr; }
+  const Report *operator->() const;
+  const Report &operator*() const;
+
+private:
+  struct ReportSlot *slot_ = nullptr;
+};
+
+} // namespace Scan
@@ -1,25 +1,159 @@
-#include <stdio.h>
+#pragma once
+
+#include "instrument.hpp"
+#include "line_reader.hpp"
+#include "matcher.hpp"
+#include <cstdint>
+#include <span>
 #include <string>
-#include <unistd.h>
+#include <string_view>
+#include <vector>
 
 namespace StatsMap {
+
+/// \brief Bits selecting the attributes of an smaps entry to parse. Lines of
+/// fields left out of the mask are skipped without parsing their value.
+enum SmapsField : uint32_t {
+  kSize = 1u << 0,
+  kKernelPageSize = 1u << 1,
+  kMMUPageSize = 1u << 2,
+  kRss = 1u << 3,
+  kPss = 1u << 4,
+  kPssDirty = 1u << 5,
+  kSharedClean = 1u << 6,
+  kSharedDirty = 1u << 7,
+  kPrivateClean = 1u << 8,
+  kPrivateDirty = 1u << 9,
+  kReferenced = 1u << 10,
+  kAnonymous = 1u << 11,
+  kLazyFree = 1u << 12,
+  kAnonHugePages = 1u << 13,
+  kShmemPmdMapped = 1u << 14,
+  kFilePmdMapped = 1u << 15,
+  kSharedHugetlb = 1u << 16,
+  kPrivateHugetlb = 1u << 17,
+  kSwap = 1u << 18,
+  kSwapPss = 1u << 19,
+  kLocked = 1u << 20,
+  kVmFlags = 1u << 21,
+  kAllFields = (1u << 22) - 1,
+};
+
+/// \brief Two-letter VmFlags mnemonics, in the order of their bits in
+/// \ref SmapsEntry::vm_flags. See show_smap_vma_flags() in
+/// fs/proc/task_mmu.c for their meaning.
+inline constexpr std::string_view kVmFlagNames[] = {
+    "rd", "wr", "ex", "sh", "mr", "mw", "me", "ms", "gd", "pf", "dw", "lo",
+    "io", "sr", "rr", "dc", "de", "ac", "nr", "ht", "sf", "nl", "ar", "wf",
+    "dd", "sd", "mm", "hg", "nh", "mg", "um", "uw", "ss", "sl", "bt", "mt"};
+
+/// \brief The bit of a VmFlags mnemonic, e.g. VmFlag("ex").
+constexpr uint64_t VmFlag(std::string_view name) {
+  for (size_t i = 0; i < std::size(kVmFlagNames); i++) {
+    if (kVmFlagNames[i] == name)
+      return uint64_t{1} << i;
+  }
+  return 0;
+}
+
+/// \brief One entry of /proc/self/smaps. Sizes are in kB, and -1 when the
+/// field is absent or was not requested.
 struct SmapsEntry {
+  uintptr_t start = 0;
+  uintptr_t end = 0;
   int64_t size_kb = -1;
+  int64_t kernel_page_size_kb = -1;
+  int64_t mmu_page_size_kb = -1;
+  int64_t rss_kb = -1;
+  int64_t pss_kb = -1;
+  int64_t pss_dirty_kb = -1;
+  int64_t shared_clean_kb = -1;
+  int64_t shared_dirty_kb = -1;
+  int64_t private_clean_kb = -1;
   int64_t private_dirty_kb = -1;
+  int64_t referenced_kb = -1;
+  int64_t anonymous_kb = -1;
+  int64_t lazy_free_kb = -1;
+  int64_t anon_huge_pages_kb = -1;
+  int64_t shmem_pmd_mapped_kb = -1;
+  int64_t file_pmd_mapped_kb = -1;
+  int64_t shared_hugetlb_kb = -1;
+  int64_t private_hugetlb_kb = -1;
   int64_t swap_kb = -1;
+  int64_t swap_pss_kb = -1;
+  int64_t locked_kb = -1;
+  /// \brief Bit set of \ref kVmFlagNames.
+  uint64_t vm_flags = 0;
   std::string pathname;
 };
+
 struct SmapsParserState {
   bool parsed_header = false;
   SmapsEntry current_entry{};
 };
 
-template <typename T> static bool ParseSmaps(FILE *f, T callback);
-static inline const char *FindNthToken(const char *line, size_t n, size_t size);
+enum class SmapsLine { kHeader, kAttribute, kMalformed };
+
+/// \brief Parses one attribute line of an smaps file into the current entry
+/// of \p state. Header lines are only recognised, and left to
+/// #StartSmapsEntry() once the previous entry has been consumed.
+SmapsLine ParseSmapsLine(std::string_view line, uint32_t fields,
+                         SmapsParserState *state);
 
+/// \brief Resets the current entry of \p state from a header line.
+bool StartSmapsEntry(std::string_view line, SmapsParserState *state);
+
+/// \brief Parses an smaps file, calling \p callback with every entry. The
+/// entry is reused for the next one once the callback returns.
 template <typename T>
-static bool ParseSmapsLine(char *line, size_t size, SmapsParserState *state,
-                           T callback);
+bool ParseSmaps(ProcFs::LineReader &reader, uint32_t fields, T &&callback) {
+  INSTRUMENT_SCOPE("ParseSmaps");
+  SmapsParserState state;
+  std::string_view line;
+  while (reader.Next(line)) {
+    switch (ParseSmapsLine(line, fields, &state)) {
+    case SmapsLine::kHeader:
+      if (state.parsed_header)
+        callback(static_cast<const SmapsEntry &>(state.current_entry));
+      if (!StartSmapsEntry(line, &state))
+        return false;
+      break;
+    case SmapsLine::kAttribute:
+      break;
+    case SmapsLine::kMalformed:
+      return false;
+    }
+  }
+  if (state.parsed_header)
+    callback(static_cast<const SmapsEntry &>(state.current_entry));
+  return true;
+}
+
+/// \brief An smaps entry whose path matched a watched library and which has
+/// private dirty pages.
+struct DirtyHit {
+  /// \brief Index of the matched pattern.
+  size_t library;
+  uintptr_t start;
+  uintptr_t end;
+  int64_t private_dirty_kb;
+  std::string pathname;
+};
+
+struct DirtyReport {
+  /// \brief Every hit, in address order. A path matching several patterns
+  /// yields one hit per pattern.
+  std::vector<DirtyHit> hits;
+  /// \brief Sum of Private_Dirty over the hits of each pattern.
+  std::vector<int64_t> private_dirty_kb;
+};
+
+/// \brief Finds the dirty pages of every library whose path contains one of
+/// the compiled patterns, in a single parse of /proc/self/smaps or \p smaps.
+DirtyReport DetectInjection(const Matcher::AhoCorasick &libraries,
+                            ProcFs::Source smaps = "/proc/self/smaps");
+
+DirtyReport DetectInjection(std::span<const std::string_view> libraries);
 
 SmapsEntry DetectInjection(std::string lib);
 } // namespace StatsMap
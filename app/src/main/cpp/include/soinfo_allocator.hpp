@@ -0,0 +1,84 @@
+#pragma once
+
+#include "solist_snapshot.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace SoList {
+
+/// \brief How the linker allocates soinfos: LinkerBlockAllocator maps pools
+/// of pool_size bytes at page boundaries, named [anon:linker_alloc], each a
+/// 16-byte header followed by blocks of one size, handed out in address
+/// order. Freed blocks go to the
+/// head of a free list and are reused first, and a pool is only mapped once
+/// the list is empty. So the only free blocks that were never handed out are
+/// those after the last soinfo of the pool mapped last.
+struct AllocatorModel {
+  /// \brief Size of a soinfo block, or 0 to infer it from the snapshot.
+  size_t block_size = 0;
+  /// \brief Bytes of a pool, PAGE_SIZE * 100 since Android 10.
+  size_t pool_size = 100 * 4096;
+  /// \brief Alignment of the pools.
+  size_t page_size = 4096;
+  /// \brief The [anon:linker_alloc] mappings in address order, as [start,
+  /// end). Those of adjacent pools may be merged, so pools start every
+  /// pool_size bytes from the start of a mapping.
+  ///
+  /// Without them, a pool is placed from the block grid of its soinfos, of
+  /// which several page boundaries may be the start, one every
+  /// page_size / gcd(block_size, page_size) blocks. Only the free blocks
+  /// before and after the soinfos that every such pool has are then found.
+  std::vector<std::pair<uintptr_t, uintptr_t>> mappings;
+  /// \brief Libraries the linker counted as unloaded, or SIZE_MAX if
+  /// g_module_unload_counter is not available.
+  size_t unload_counter = SIZE_MAX;
+};
+
+struct Anomaly {
+  enum Kind {
+    /// \brief A soinfo without a path.
+    kEmptyPath,
+    /// \brief A soinfo without a name loaded after app_process.
+    kNameless,
+    /// \brief Free blocks left by unloaded libraries: between two soinfos of
+    /// a pool, before its first one, or after the last one of a pool that is
+    /// not the one mapped last.
+    kDropped,
+    /// \brief A soinfo outside the allocator mappings, or off the block grid
+    /// of every pool, as if not allocated by the linker.
+    kIsolated,
+  };
+
+  enum Confidence {
+    /// \brief Explained by a normal dlclose().
+    kLow,
+    /// \brief More than the linker admits to, or an unusual layout.
+    kMedium,
+    /// \brief Cannot happen without tampering, such as a library unloaded
+    /// before the app is specialized.
+    kHigh,
+  };
+
+  Kind kind;
+  Confidence confidence;
+  /// \brief The suspicious soinfo, or the first free block of a hole.
+  uintptr_t address;
+  /// \brief Free blocks in the hole, 1 for the other kinds.
+  size_t blocks;
+};
+
+/// \brief The block size of \p snapshot: the most common distance between
+/// soinfos adjacent in memory, at least the end of the name and realpath
+/// fields.
+/// \return 0 if no two soinfos are adjacent.
+size_t InferBlockSize(const Snapshot &snapshot, const AllocatorModel &model);
+
+/// \brief Classifies every soinfo and every hole of the pools of \p snapshot
+/// against \p model, in one pass over the soinfos sorted by address.
+/// \return The anomalies in address order, list checks first.
+std::vector<Anomaly> FindAnomalies(const Snapshot &snapshot,
+                                   const AllocatorModel &model);
+
+} // namespace SoList
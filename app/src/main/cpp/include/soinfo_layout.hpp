@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+namespace SoList {
+
+/// \brief Where the fields SoInfo reads are in the soinfo of the linker,
+/// and the size of its allocator blocks, 0 if unknown.
+struct Layout {
+  uint32_t next_offset;
+  uint32_t realpath_offset;
+  uint32_t name_offset;
+  uint32_t size;
+};
+
+/// \brief The ABI of this process, which the layout depends on as much as
+/// the linker.
+constexpr std::string_view kAbi =
+#if defined(__aarch64__)
+    "arm64-v8a";
+#elif defined(__arm__)
+    "armeabi-v7a";
+#elif defined(__x86_64__)
+    "x86_64";
+#elif defined(__i386__)
+    "x86";
+#elif defined(__riscv)
+    "riscv64";
+#else
+    "unknown";
+#endif
+
+/// \brief Reads the layout cached for the linker with \p build_id and #kAbi.
+/// It still has to be probed, the cache cannot tell a layout that was wrong
+/// when stored.
+bool LoadLayout(std::string_view build_id, Layout &layout);
+
+/// \brief Caches \p layout for the linker with \p build_id and #kAbi, so that
+/// the heuristics only run again after the linker changes.
+void StoreLayout(std::string_view build_id, const Layout &layout);
+
+} // namespace SoList
@@ -1,6 +1,9 @@
 #pragma once
 
 #include "elf_util.h"
+#include "map_snapshot.hpp"
+#include "soinfo_allocator.hpp"
+#include "soinfo_layout.hpp"
 #include <string>
 
 namespace SoList {
@@ -13,6 +16,10 @@ public:
   inline static size_t solist_next_offset = 0xa4;
   inline static size_t solist_realpath_offset = 0x17c;
 #endif
+  inline static size_t solist_name_offset =
+      solist_realpath_offset - sizeof(std::string);
+  /// \brief Size of a soinfo block of the linker's allocator, 0 if unknown.
+  inline static size_t solist_size = 0;
 
   inline static const char *(*get_realpath_sym)(SoInfo *) = NULL;
 
@@ -28,9 +35,7 @@ public:
   }
 
   inline const char *get_name() {
-    return ((std::string *)((uintptr_t)this + solist_realpath_offset -
-                            sizeof(std::string)))
-        ->c_str();
+    return ((std::string *)((uintptr_t)this + solist_name_offset))->c_str();
   }
 
   void set_next(SoInfo *si) {
@@ -50,14 +55,10 @@ public:
       (this->*dtor)();
   }
 
-  static bool setup(const SandHook::ElfImg &linker) {
-    ctor = MemFunc{.data = {.p = reinterpret_cast<void *>(linker.getSymbAddress(
-                                "__dl__ZN18ProtectedDataGuardC2Ev")),
-                            .adj = 0}}
+  static bool setup(ElfW(Addr) ctor_addr, ElfW(Addr) dtor_addr) {
+    ctor = MemFunc{.data = {.p = reinterpret_cast<void *>(ctor_addr), .adj = 0}}
                .f;
-    dtor = MemFunc{.data = {.p = reinterpret_cast<void *>(linker.getSymbAddress(
-                                "__dl__ZN18ProtectedDataGuardD2Ev")),
-                            .adj = 0}}
+    dtor = MemFunc{.data = {.p = reinterpret_cast<void *>(dtor_addr), .adj = 0}}
                .f;
     return ctor != nullptr && dtor != nullptr;
   }
@@ -82,24 +83,34 @@ private:
   };
 };
 
-static SoInfo *solinker = NULL;
-static SoInfo *somain = NULL;
-static SoInfo **sonext = NULL;
-static uint64_t *g_module_unload_counter = NULL;
-
-static bool Initialize();
-
-template <typename T>
-inline T *getStaticPointer(const SandHook::ElfImg &linker, const char *name) {
-  auto *addr = reinterpret_cast<T **>(linker.getSymbAddress(name));
+template <typename T> inline T *getStaticPointer(ElfW(Addr) symbol) {
+  auto *addr = reinterpret_cast<T **>(symbol);
 
   return addr == NULL ? NULL : *addr;
 }
 
 SoInfo *DetectInjection();
+/// \brief Every anomaly of the soinfo list, checked against the soinfo
+/// allocator of the linker.
+std::vector<Anomaly> DetectAnomalies();
+/// \brief \ref DetectAnomalies on a list captured by \ref Capture.
+/// \param maps The regions of the maps, from which the pools of the
+/// allocator are taken; the block grid places them if empty.
+std::vector<Anomaly>
+DetectAnomalies(const Snapshot &snapshot,
+                std::span<const VirtualMap::MapRegion> maps);
 size_t DetectModules();
+
+/// \brief Initializes the first time, then reports whether that worked.
+bool Ready();
+
+/// \brief Captures the soinfo list, or nothing if not \ref Ready.
+Snapshot Capture();
 bool findHeuristicOffsets(std::string linker_name);
 
-bool Initialize();
+/// \brief The layout SoInfo currently reads soinfos with.
+Layout CurrentLayout();
+
+void ApplyLayout(const Layout &layout);
 
 } // namespace SoList
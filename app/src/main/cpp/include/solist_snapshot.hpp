@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace SoList {
+class SoInfo;
+
+/// \brief A copy of the soinfo list of the linker, taken in one pass so that
+/// the analysis never touches linker memory.
+///
+/// The entries are contiguous and their strings are copied into one buffer,
+/// so snapshots can also be built by hand to exercise the analysis.
+class Snapshot {
+public:
+  struct Entry {
+    uintptr_t address;
+    uintptr_t next;
+    /// \brief Offsets into the string buffer, or #kNull.
+    uint32_t path;
+    uint32_t name;
+  };
+
+  static constexpr uint32_t kNull = UINT32_MAX;
+
+  /// \brief Stops a corrupted or cyclic list from being walked forever.
+  static constexpr size_t kMaxEntries = 4096;
+
+  /// \brief Copies the list starting at \p head while holding
+  /// ProtectedDataGuard, prefetching each next soinfo while the strings of
+  /// the current one are copied.
+  static Snapshot Capture(SoInfo *head);
+
+  void Append(uintptr_t address, uintptr_t next, const char *path,
+              const char *name);
+
+  std::span<const Entry> entries() const { return entries_; }
+
+  const char *path(const Entry &entry) const { return string(entry.path); }
+
+  const char *name(const Entry &entry) const { return string(entry.name); }
+
+  void clear() {
+    entries_.clear();
+    strings_.clear();
+  }
+
+private:
+  uint32_t AppendString(const char *string);
+
+  const char *string(uint32_t offset) const {
+    return offset == kNull ? nullptr : strings_.data() + offset;
+  }
+
+  std::vector<Entry> entries_;
+  std::string strings_;
+};
+
+/// \brief Finds a soinfo hidden from or inserted into \p snapshot by an
+/// injector: an empty path, a nameless soinfo after app_process, or a gap in
+/// the soinfo allocator before the app is specialized.
+/// \return The address of the suspicious soinfo, which for a gap is the
+/// dropped one rather than an entry, or 0.
+uintptr_t FindInjection(const Snapshot &snapshot);
+
+} // namespace SoList
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <link.h>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace SandHook {
+
+/// \brief Exact-name index over the FUNC and OBJECT symbols of an ELF symbol
+/// table, for tables without a hash section such as .symtab.
+///
+/// The index is an array of (name hash, name offset, symbol index) grouped by
+/// bucket with a counting sort, plus the offset of every bucket in it, like
+/// .gnu.hash. Building it hashes every name once and allocates three arrays
+/// instead of one node per symbol, and a lookup compares names only for the
+/// entries of one bucket whose hash matches.
+class SymbolIndex {
+public:
+  /// \brief The GNU hash of a symbol name, the same as .gnu.hash uses, so the
+  /// hash computed for a dynamic lookup can be reused.
+  static constexpr uint32_t Hash(std::string_view name) {
+    uint32_t h = 5381;
+    for (unsigned char p : name) {
+      h += (h << 5) + p;
+    }
+    return h;
+  }
+
+  /// \brief Whether \p symbol is a FUNC or OBJECT of non-zero size, the
+  /// symbols worth resolving.
+  static constexpr bool Indexed(const ElfW(Sym) & symbol) {
+    // ELF_ST_TYPE() is only in <linux/elf.h>, which glibc's <elf.h> clashes
+    // with.
+    unsigned int st_type = symbol.st_info & 0xf;
+    return (st_type == STT_FUNC || st_type == STT_OBJECT) &&
+           symbol.st_size != 0;
+  }
+
+  /// \brief Indexes the \ref Indexed() symbols among
+  /// symbols[0, count), whose names are offsets into \p strings. The arrays
+  /// must outlive the index.
+  void Build(const ElfW(Sym) * symbols, size_t count, const char *strings);
+
+  /// \return The first symbol in table order named \p name, or nullptr.
+  /// \param hash Hash(name).
+  const ElfW(Sym) * Find(std::string_view name, uint32_t hash) const;
+
+  const ElfW(Sym) * Find(std::string_view name) const {
+    return Find(name, Hash(name));
+  }
+
+  /// \brief Sorts the indexed symbols by name for #FindPrefix(). Only done
+  /// on demand, as most images are never searched by prefix.
+  void BuildNameOrder();
+
+  /// \brief The indexed symbols whose name starts with \p prefix, as indices
+  /// into the symbol table, in lexicographic order of name and then table
+  /// order. Requires #BuildNameOrder().
+  std::span<const uint32_t> FindPrefix(std::string_view prefix) const;
+
+  const ElfW(Sym) & symbol(uint32_t index) const { return symbols_[index]; }
+
+  std::string_view name(uint32_t index) const {
+    return strings_ + symbols_[index].st_name;
+  }
+
+  size_t size() const { return entries_.size(); }
+
+  /// \brief Heap memory held by the index.
+  size_t memory_bytes() const {
+    return entries_.capacity() * sizeof(Entry) +
+           bucket_begin_.capacity() * sizeof(uint32_t) +
+           name_order_.capacity() * sizeof(uint32_t);
+  }
+
+private:
+  struct Entry {
+    uint32_t hash;
+    uint32_t name;
+    uint32_t symbol;
+  };
+
+  const ElfW(Sym) *symbols_ = nullptr;
+  const char *strings_ = nullptr;
+  /// \brief Entries of bucket b are [bucket_begin_[b], bucket_begin_[b + 1]),
+  /// in table order.
+  std::vector<Entry> entries_;
+  std::vector<uint32_t> bucket_begin_;
+  uint32_t bucket_shift_ = 32;
+  /// \brief Symbol indices sorted by name.
+  std::vector<uint32_t> name_order_;
+};
+
+} // namespace SandHook
@@ -1,5 +1,16 @@
+#pragma once
+
+#include "inode_cache.hpp"
+#include "line_reader.hpp"
+#include "matcher.hpp"
 #include <cstdint>
+#include <optional>
+#include <span>
 #include <string>
+#include <string_view>
+#include <sys/types.h>
+#include <vector>
+
 namespace VirtualMap {
 
 struct MapInfo {
@@ -26,14 +37,131 @@ struct MapInfo {
   /// \brief The path of the memory region.
   std::string path;
 
-  /// \brief Scans /proc/self/maps and returns a list of \ref MapInfo entries.
+  /// \brief Scans /proc/self/maps, or \p maps, and returns a list of
+  /// \ref MapInfo entries.
   /// This is useful to find out the inode of the library to hook.
   /// \return A list of \ref MapInfo entries.
   [[maybe_unused, gnu::visibility("default")]] static std::vector<MapInfo>
-  Scan();
+  Scan(ProcFs::Source maps = "/proc/self/maps");
+
+  /// \brief Streams /proc/self/maps through \p visitor without building the
+  /// whole list. The visitor is called with a \ref MapEntry, which is only
+  /// valid during the call, and returns false to stop the scan early.
+  /// \return true if every entry was visited.
+  template <typename Visitor> static bool ForEach(Visitor &&visitor);
+};
+
+/// \brief A non-owning counterpart of \ref MapInfo produced by
+/// \ref MapsScanner. Its path points into the scanner's buffer.
+struct MapEntry {
+  uintptr_t start;
+  uintptr_t end;
+  uint8_t perms;
+  bool is_private;
+  uintptr_t offset;
+  dev_t dev;
+  ino_t inode;
+  std::string_view path;
+
+  MapInfo ToOwned() const {
+    return {start, end, perms, is_private, offset, dev, inode,
+            std::string(path)};
+  }
+};
+
+/// \brief Parses one line of a maps file without allocating.
+bool ParseMapsLine(std::string_view line, MapEntry &entry);
+
+/// \brief Streams the entries of a maps file.
+///
+/// The file is read in large chunks into a buffer that is reused for the whole
+/// scan, and across scans when #Rewind() is used. The path of an entry is only
+/// valid until the next call to #Next().
+class MapsScanner {
+public:
+  explicit MapsScanner(ProcFs::Source maps = "/proc/self/maps")
+      : reader_(maps) {}
+
+  bool ok() const { return reader_.ok(); }
+
+  bool Next(MapEntry &entry);
+
+  bool Rewind() { return reader_.Rewind(); }
+
+  size_t bytes_read() const { return reader_.bytes_read(); }
+
+private:
+  ProcFs::LineReader reader_;
+};
+
+template <typename Visitor> bool MapInfo::ForEach(Visitor &&visitor) {
+  MapsScanner scanner;
+  MapEntry entry;
+  while (scanner.Next(entry)) {
+    if (!visitor(static_cast<const MapEntry &>(entry)))
+      return false;
+  }
+  return true;
+}
+
+/// \brief A suspicious region, copied out of the scan so that it outlives it.
+struct Detection {
+  MapInfo region;
+  /// \brief A static description of the failed check.
+  const char *reason;
+};
+
+struct MapRegion;
+
+/// \brief Refreshes the maps and checks the regions that changed since the
+/// previous refresh.
+std::optional<Detection> DetectInjection();
+
+/// \brief Checks every region of \p maps, with no state kept across calls,
+/// e.g. to run the check on a recorded or synthetic maps file.
+std::optional<Detection> DetectInjection(ProcFs::Source maps);
+
+/// \brief Refreshes the snapshot of the maps that \ref CheckMaps checks, so
+/// that other scans can share it.
+bool RefreshMaps();
+
+/// \brief The regions of the last \ref RefreshMaps, valid until the next.
+std::span<const MapRegion> Maps();
+
+/// \brief The check of \ref DetectInjection without the refresh. Only the
+/// first call after a refresh checks its changes, the next ones only report.
+std::optional<Detection> CheckMaps();
+
+/// \brief Counters of the inode verification done by \ref DetectInjection.
+const InodeCache::Stats &InodeCheckStats();
+
+/// \brief A stack string matching a signature.
+struct StackHit {
+  /// \brief Index of the signature in the set the stack was scanned with.
+  uint32_t signature;
+  /// \brief Offset of the string from the start of the main thread stack.
+  size_t offset;
+  size_t length;
 };
 
-MapInfo *DetectInjection();
+/// \brief The default signatures of injectors and their modules, matched
+/// ignoring case.
+std::span<const std::string_view> StackSignatures();
+
+/// \brief Matches the distinct printable strings of the main thread stack
+/// against \p signatures in one pass. A string matching a signature is only
+/// reported at its first offset.
+std::vector<StackHit> ScanStackStrings(const Matcher::AhoCorasick &signatures,
+                                       size_t min_string_length = 3);
+
+/// \brief Scans the stack with \ref StackSignatures().
+std::vector<StackHit> ScanStackStrings();
+
+/// \brief Scans the stack with \ref StackSignatures(), finding it in \p maps
+/// instead of reading the maps again.
+std::vector<StackHit> ScanStackStrings(std::span<const MapRegion> maps);
 
-void DumpStackStrings();
+/// \brief Logs the printable strings of the main thread stack, for
+/// debugging, until \p byte_budget bytes of strings have been logged.
+void DumpStackStrings(size_t byte_budget, size_t min_string_length = 3);
 } // namespace VirtualMap
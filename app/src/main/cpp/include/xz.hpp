@@ -0,0 +1,19 @@
+#pragma once
+
+#include <span>
+#include <vector>
+
+/// \brief A decoder for the .xz format, as much of it as MiniDebugInfo uses:
+/// LZMA2 blocks without other filters, in one stream or more. CRC32 and
+/// CRC64 checks are verified, the others skipped.
+///
+/// The NDK has no liblzma, and the stripped libraries of the device are the
+/// ones whose MiniDebugInfo is needed.
+namespace SandHook::Xz {
+
+/// \brief Decodes \p xz and appends its data to \p out.
+/// \return false if \p xz is corrupt or uses a filter other than LZMA2, in
+/// which case \p out holds part of the data.
+bool Decode(std::span<const char> xz, std::vector<char> &out);
+
+} // namespace SandHook::Xz
@@ -0,0 +1,265 @@
+#include "inode_cache.hpp"
+#include "instrument.hpp"
+#include "logging.h"
+#include <algorithm>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Untrusted apps are denied io_uring by SELinux, and older seccomp policies
+// trap the syscalls outright, so Android always takes the stat() path.
+#if !defined(__ANDROID__) && __has_include(<linux/io_uring.h>) &&             \
+    defined(STATX_INO)
+#define INODE_CACHE_IO_URING 1
+#include <atomic>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#else
+#define INODE_CACHE_IO_URING 0
+#endif
+
+namespace VirtualMap {
+
+#if INODE_CACHE_IO_URING
+// A minimal io_uring, only used to submit batches of IORING_OP_STATX.
+struct InodeCache::Ring {
+  static constexpr unsigned kEntries = 64;
+
+  int fd = -1;
+  void *sq_ring = MAP_FAILED;
+  void *cq_ring = MAP_FAILED;
+  size_t sq_ring_size = 0;
+  size_t cq_ring_size = 0;
+  io_uring_sqe *sqes = static_cast<io_uring_sqe *>(MAP_FAILED);
+  io_uring_params params{};
+
+  unsigned *sq_tail = nullptr;
+  unsigned *sq_mask = nullptr;
+  unsigned *sq_array = nullptr;
+  unsigned *cq_head = nullptr;
+  unsigned *cq_tail = nullptr;
+  unsigned *cq_mask = nullptr;
+  io_uring_cqe *cqes = nullptr;
+
+  struct statx results[kEntries];
+
+  bool Setup() {
+    fd = static_cast<int>(syscall(__NR_io_uring_setup, kEntries, &params));
+    if (fd < 0)
+      return false;
+
+    sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cq_ring_size =
+        params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    if (params.features & IORING_FEAT_SINGLE_MMAP)
+      sq_ring_size = cq_ring_size = std::max(sq_ring_size, cq_ring_size);
+
+    sq_ring = mmap(nullptr, sq_ring_size, PROT_READ | PROT_WRITE,
+                   MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+    if (sq_ring == MAP_FAILED)
+      return false;
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+      cq_ring = sq_ring;
+    } else {
+      cq_ring = mmap(nullptr, cq_ring_size, PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+      if (cq_ring == MAP_FAILED)
+        return false;
+    }
+    sqes = static_cast<io_uring_sqe *>(
+        mmap(nullptr, params.sq_entries * sizeof(io_uring_sqe),
+             PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd,
+             IORING_OFF_SQES));
+    if (sqes == MAP_FAILED)
+      return false;
+
+    auto *sq = static_cast<char *>(sq_ring);
+    auto *cq = static_cast<char *>(cq_ring);
+    sq_tail = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+    sq_mask = reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+    sq_array = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+    cq_head = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+    cq_tail = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+    cq_mask = reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+    cqes = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+    return true;
+  }
+
+  ~Ring() {
+    if (sqes != MAP_FAILED)
+      munmap(sqes, params.sq_entries * sizeof(io_uring_sqe));
+    if (cq_ring != MAP_FAILED && cq_ring != sq_ring)
+      munmap(cq_ring, cq_ring_size);
+    if (sq_ring != MAP_FAILED)
+      munmap(sq_ring, sq_ring_size);
+    if (fd >= 0)
+      close(fd);
+  }
+
+  // Submits statx for up to kEntries paths and waits for all of them. The
+  // result of paths[i] is written to results[i]; res[i] receives the CQE
+  // result. Returns false if the kernel rejected the submission.
+  bool StatBatch(const char *const *paths, size_t count, int *res) {
+    unsigned tail = *sq_tail;
+    for (size_t i = 0; i < count; i++, tail++) {
+      unsigned index = tail & *sq_mask;
+      io_uring_sqe &sqe = sqes[index];
+      sqe = {};
+      sqe.opcode = IORING_OP_STATX;
+      sqe.fd = AT_FDCWD;
+      sqe.addr = reinterpret_cast<uintptr_t>(paths[i]);
+      sqe.len = STATX_INO;
+      sqe.off = reinterpret_cast<uintptr_t>(&results[i]);
+      sqe.user_data = i;
+      sq_array[index] = index;
+    }
+    std::atomic_ref<unsigned>(*sq_tail).store(tail, std::memory_order_release);
+
+    if (syscall(__NR_io_uring_enter, fd, count, count,
+                IORING_ENTER_GETEVENTS, nullptr, 0) < 0)
+      return false;
+
+    unsigned head = *cq_head;
+    unsigned done = 0;
+    while (done < count) {
+      unsigned ready =
+          std::atomic_ref<unsigned>(*cq_tail).load(std::memory_order_acquire);
+      for (; head != ready; head++, done++) {
+        const io_uring_cqe &cqe = cqes[head & *cq_mask];
+        res[cqe.user_data] = cqe.res;
+      }
+      std::atomic_ref<unsigned>(*cq_head).store(head,
+                                                std::memory_order_release);
+    }
+    return true;
+  }
+};
+#else
+struct InodeCache::Ring {};
+#endif
+
+size_t InodeCache::KeyHash::operator()(const KeyView &key) const {
+  size_t hash = std::hash<std::string_view>{}(key.path);
+  hash ^= static_cast<size_t>(key.inode) + 0x9e3779b97f4a7c15ULL +
+          (hash << 6) + (hash >> 2);
+  hash ^= static_cast<size_t>(key.dev) + 0x9e3779b97f4a7c15ULL + (hash << 6) +
+          (hash >> 2);
+  return hash;
+}
+
+InodeCache::InodeCache() {
+  INSTRUMENT_SYSCALL();
+  mountinfo_ = open("/proc/self/mountinfo", O_RDONLY | O_CLOEXEC);
+  if (mountinfo_ < 0)
+    PLOGE("open mountinfo");
+#if INODE_CACHE_IO_URING
+  ring_ = std::make_unique<Ring>();
+  if (!ring_->Setup()) {
+    LOGD("io_uring unavailable, checking inodes with stat");
+    ring_.reset();
+  }
+#endif
+}
+
+InodeCache::~InodeCache() {
+  if (mountinfo_ >= 0)
+    close(mountinfo_);
+}
+
+const InodeCache::Entry *InodeCache::Acquire(dev_t dev, ino_t inode,
+                                             std::string_view path) {
+  stats_.lookups++;
+  auto it = entries_.find(KeyView{dev, inode, path});
+  if (it != entries_.end()) {
+    stats_.hits++;
+  } else {
+    it = entries_.emplace(Key{dev, inode, std::string(path)}, Entry{}).first;
+    pending_.push_back(&*it);
+  }
+  it->second.refs++;
+  return &it->second;
+}
+
+const InodeCache::Entry *InodeCache::Find(dev_t dev, ino_t inode,
+                                          std::string_view path) const {
+  auto it = entries_.find(KeyView{dev, inode, path});
+  return it != entries_.end() ? &it->second : nullptr;
+}
+
+void InodeCache::Release(dev_t dev, ino_t inode, std::string_view path) {
+  auto it = entries_.find(KeyView{dev, inode, path});
+  if (it == entries_.end() || --it->second.refs > 0)
+    return;
+  if (it->second.state == State::kPending)
+    std::erase(pending_, &*it);
+  entries_.erase(it);
+  stats_.evictions++;
+}
+
+bool InodeCache::InvalidateOnMountChange() {
+  if (mountinfo_ < 0)
+    return false;
+  pollfd fd{mountinfo_, POLLPRI, 0};
+  stats_.mount_polls++;
+  INSTRUMENT_SYSCALL();
+  if (poll(&fd, 1, 0) <= 0 || (fd.revents & (POLLPRI | POLLERR)) == 0)
+    return false;
+  stats_.invalidations++;
+  pending_.clear();
+  for (auto &entry : entries_) {
+    entry.second.state = State::kPending;
+    pending_.push_back(&entry);
+  }
+  return true;
+}
+
+void InodeCache::StatSync(Map::value_type &entry) {
+  struct stat sb_buf;
+  stats_.stat_calls++;
+  INSTRUMENT_SYSCALL();
+  entry.second.state = stat(entry.first.path.c_str(), &sb_buf) == 0 &&
+                               sb_buf.st_ino == entry.first.inode
+                           ? State::kConsistent
+                           : State::kInconsistent;
+}
+
+void InodeCache::Flush() {
+  if (pending_.empty())
+    return;
+  size_t first = 0;
+#if INODE_CACHE_IO_URING
+  while (ring_ && first < pending_.size()) {
+    size_t count = std::min<size_t>(pending_.size() - first, Ring::kEntries);
+    const char *paths[Ring::kEntries];
+    int res[Ring::kEntries];
+    for (size_t i = 0; i < count; i++)
+      paths[i] = pending_[first + i]->first.path.c_str();
+    stats_.uring_submits++;
+    if (!ring_->StatBatch(paths, count, res)) {
+      ring_.reset();
+      break;
+    }
+    for (size_t i = 0; i < count; i++) {
+      auto &entry = *pending_[first + i];
+      if (res[i] == -EINVAL || res[i] == -EOPNOTSUPP) {
+        // IORING_OP_STATX needs Linux 5.6.
+        StatSync(entry);
+        continue;
+      }
+      stats_.uring_statx++;
+      entry.second.state =
+          res[i] == 0 && ring_->results[i].stx_ino == entry.first.inode
+              ? State::kConsistent
+              : State::kInconsistent;
+    }
+    first += count;
+  }
+#endif
+  for (size_t i = first; i < pending_.size(); i++)
+    StatSync(*pending_[i]);
+  pending_.clear();
+}
+
+} // namespace VirtualMap
@@ -0,0 +1,128 @@
+#include "instrument.hpp"
+
+#ifdef DEMO_INSTRUMENTATION
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <sys/resource.h>
+#include <vector>
+
+namespace Instrument {
+
+namespace {
+
+// Sites push themselves here when first reached, and are never removed.
+std::atomic<Site *> sites = nullptr;
+
+uint64_t WallNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+uint64_t PageFaults() {
+  rusage usage;
+  if (getrusage(RUSAGE_THREAD, &usage) != 0)
+    return 0;
+  return usage.ru_minflt + usage.ru_majflt;
+}
+
+// The upper bound in microseconds of the bucket holding quantile q.
+uint64_t Quantile(const std::atomic<uint64_t> *histogram, uint64_t count,
+                  double q) {
+  uint64_t rank = count * q;
+  uint64_t seen = 0;
+  for (int i = 0; i < Site::kBuckets; i++) {
+    seen += histogram[i].load(std::memory_order_relaxed);
+    if (seen > rank)
+      return uint64_t{2} << i;
+  }
+  return uint64_t{2} << (Site::kBuckets - 1);
+}
+
+} // namespace
+
+Site::Site(const char *name) : name_(name) {
+  next_ = sites.load(std::memory_order_relaxed);
+  while (!sites.compare_exchange_weak(next_, this, std::memory_order_release,
+                                      std::memory_order_relaxed)) {
+  }
+}
+
+void Site::Record(uint64_t wall_ns, const Counters &delta,
+                  uint64_t page_faults) {
+  constexpr auto relaxed = std::memory_order_relaxed;
+  count_.fetch_add(1, relaxed);
+  wall_ns_.fetch_add(wall_ns, relaxed);
+  syscalls_.fetch_add(delta.syscalls, relaxed);
+  proc_bytes_.fetch_add(delta.proc_bytes, relaxed);
+  allocations_.fetch_add(delta.allocations, relaxed);
+  page_faults_.fetch_add(page_faults, relaxed);
+  uint64_t us = wall_ns / 1000;
+  int bucket = us < 2 ? 0 : 63 - __builtin_clzll(us);
+  histogram_[std::min(bucket, kBuckets - 1)].fetch_add(1, relaxed);
+}
+
+Site &SiteNamed(const char *name) {
+  static std::mutex mutex;
+  static std::vector<Site *> named;
+  std::lock_guard lock(mutex);
+  for (auto *site : named) {
+    if (strcmp(site->name(), name) == 0)
+      return *site;
+  }
+  // Sites live as long as the process, like static ones.
+  return *named.emplace_back(new Site(name));
+}
+
+Scope::Scope(Site &site)
+    : site_(site), wall_ns_(WallNs()), counters_(counters),
+      page_faults_(PageFaults()) {}
+
+Scope::~Scope() {
+  Counters delta{counters.syscalls - counters_.syscalls,
+                 counters.proc_bytes - counters_.proc_bytes,
+                 counters.allocations - counters_.allocations};
+  site_.Record(WallNs() - wall_ns_, delta, PageFaults() - page_faults_);
+}
+
+std::string Summary() {
+  constexpr auto relaxed = std::memory_order_relaxed;
+  std::string summary;
+  char buffer[256];
+  for (Site *site = sites.load(std::memory_order_acquire); site != nullptr;
+       site = site->next_) {
+    uint64_t count = site->count_.load(relaxed);
+    if (count == 0)
+      continue;
+    snprintf(buffer, sizeof(buffer),
+             "%s%s: n=%llu avg=%.1fus p50<%lluus p99<%lluus sys=%llu "
+             "proc=%lluB alloc=%llu flt=%llu",
+             summary.empty() ? "" : "; ", site->name_,
+             (unsigned long long)count,
+             site->wall_ns_.load(relaxed) / 1e3 / count,
+             (unsigned long long)Quantile(site->histogram_, count, 0.5),
+             (unsigned long long)Quantile(site->histogram_, count, 0.99),
+             (unsigned long long)site->syscalls_.load(relaxed),
+             (unsigned long long)site->proc_bytes_.load(relaxed),
+             (unsigned long long)site->allocations_.load(relaxed),
+             (unsigned long long)site->page_faults_.load(relaxed));
+    summary += buffer;
+  }
+  return summary;
+}
+
+} // namespace Instrument
+
+#else
+
+namespace Instrument {
+
+std::string Summary() { return {}; }
+
+} // namespace Instrument
+
+#endif
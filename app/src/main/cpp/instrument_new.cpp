@@ -0,0 +1,23 @@
+#include "instrument.hpp"
+
+#ifdef DEMO_INSTRUMENTATION
+
+#include <cstdlib>
+#include <new>
+
+// Counts the allocations for Instrument. This file only defines these, so
+// that the linker leaves it out of the static library for programs that
+// replace them already, like the allocation-counting benchmarks. The array
+// and nothrow forms end up in these.
+void *operator new(size_t size) {
+  Instrument::counters.allocations++;
+  if (void *p = malloc(size ? size : 1))
+    return p;
+  throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { free(p); }
+
+void operator delete(void *p, size_t) noexcept { free(p); }
+
+#endif
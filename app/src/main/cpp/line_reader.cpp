@@ -0,0 +1,108 @@
+#include "line_reader.hpp"
+#include "instrument.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace ProcFs {
+
+LineReader::LineReader(Source source) : memory_(source.contents()) {
+  if (source.path() != nullptr) {
+    INSTRUMENT_SYSCALL();
+    fd_ = open(source.path(), O_RDONLY | O_CLOEXEC);
+  }
+  if (ok()) {
+    buffer_ = std::make_unique<char[]>(kChunkSize);
+    capacity_ = kChunkSize;
+  }
+}
+
+LineReader::~LineReader() {
+  if (fd_ >= 0)
+    close(fd_);
+}
+
+bool LineReader::Rewind() {
+  if (!ok())
+    return false;
+  if (fd_ < 0) {
+    memory_offset_ = 0;
+  } else {
+    INSTRUMENT_SYSCALL();
+    if (lseek(fd_, 0, SEEK_SET) != 0)
+      return false;
+  }
+  begin_ = end_ = 0;
+  eof_ = false;
+  return true;
+}
+
+// Moves the unconsumed tail to the front of the buffer, growing it if a single
+// line does not fit, then appends one read() worth of data.
+bool LineReader::Fill() {
+  if (begin_ > 0) {
+    memmove(buffer_.get(), buffer_.get() + begin_, end_ - begin_);
+    end_ -= begin_;
+    begin_ = 0;
+  }
+  if (end_ == capacity_) {
+    auto grown = std::make_unique<char[]>(capacity_ * 2);
+    memcpy(grown.get(), buffer_.get(), end_);
+    buffer_ = std::move(grown);
+    capacity_ *= 2;
+  }
+  ssize_t rd = Read(buffer_.get() + end_, capacity_ - end_);
+  if (rd <= 0) {
+    eof_ = true;
+    return false;
+  }
+  end_ += static_cast<size_t>(rd);
+  bytes_read_ += static_cast<size_t>(rd);
+  return true;
+}
+
+ssize_t LineReader::Read(char *into, size_t size) {
+  if (fd_ < 0) {
+    size = std::min(size, memory_.size() - memory_offset_);
+    memcpy(into, memory_.data() + memory_offset_, size);
+    memory_offset_ += size;
+    return size;
+  }
+  ssize_t rd;
+  do {
+    INSTRUMENT_SYSCALL();
+    rd = read(fd_, into, size);
+  } while (rd < 0 && errno == EINTR);
+  if (rd > 0)
+    INSTRUMENT_PROC_READ(rd);
+  return rd;
+}
+
+bool LineReader::Next(std::string_view &line) {
+  if (!ok())
+    return false;
+  size_t scanned = begin_;
+  for (;;) {
+    auto *newline = static_cast<char *>(
+        memchr(buffer_.get() + scanned, '\n', end_ - scanned));
+    if (newline != nullptr) {
+      line = {buffer_.get() + begin_,
+              static_cast<size_t>(newline - buffer_.get()) - begin_};
+      begin_ = newline - buffer_.get() + 1;
+      return true;
+    }
+    scanned = end_ - begin_;
+    if (eof_ || !Fill()) {
+      // The last line may lack a terminating newline.
+      if (begin_ == end_)
+        return false;
+      line = {buffer_.get() + begin_, end_ - begin_};
+      begin_ = end_;
+      return true;
+    }
+  }
+}
+
+} // namespace ProcFs
@@ -0,0 +1,213 @@
+#include "logging.h"
+#include <atomic>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+
+namespace logging {
+
+namespace {
+
+// Longer messages are truncated; logcat cuts them at about 4 KiB anyway.
+constexpr size_t kMaxMessage = 1024;
+
+// A single-producer, single-consumer queue of the messages of one thread.
+// Head and tail only grow; records are aligned so that a padding record
+// always fits at the end of the buffer.
+struct Ring {
+  static constexpr size_t kSize = 32 * 1024;
+
+  struct alignas(16) Record {
+    // Of the whole record, a multiple of sizeof(Record).
+    uint32_t size;
+    // Negative for the padding at the end of the buffer.
+    int32_t prio;
+    const char *tag;
+  };
+
+  // Whether a live thread writes to this ring. Rings of exited threads are
+  // drained and handed to new threads, but never freed.
+  std::atomic<bool> owned{true};
+  std::atomic<uint64_t> head{0};
+  std::atomic<uint64_t> tail{0};
+  Ring *next = nullptr;
+  alignas(Record) char data[kSize];
+
+  // Returns false if the ring is full.
+  bool Push(int prio, const char *tag, const char *message, size_t length) {
+    size_t size = (sizeof(Record) + length + 1 + sizeof(Record) - 1) &
+                  ~(sizeof(Record) - 1);
+    uint64_t at = head.load(std::memory_order_relaxed);
+    uint64_t free = kSize - (at - tail.load(std::memory_order_acquire));
+    size_t offset = at % kSize;
+    size_t padding = kSize - offset < size ? kSize - offset : 0;
+    if (free < padding + size)
+      return false;
+    if (padding != 0) {
+      *reinterpret_cast<Record *>(data + offset) = {uint32_t(padding), -1,
+                                                    nullptr};
+      offset = 0;
+    }
+    *reinterpret_cast<Record *>(data + offset) = {uint32_t(size), prio, tag};
+    char *text = data + offset + sizeof(Record);
+    memcpy(text, message, length);
+    text[length] = '\0';
+    head.store(at + padding + size, std::memory_order_release);
+    return true;
+  }
+
+  void Drain(Sink *sink) {
+    uint64_t at = tail.load(std::memory_order_relaxed);
+    uint64_t end = head.load(std::memory_order_acquire);
+    while (at != end) {
+      auto *record = reinterpret_cast<const Record *>(data + at % kSize);
+      if (record->prio >= 0 && sink != nullptr)
+        sink->Write(record->prio, record->tag,
+                    reinterpret_cast<const char *>(record + 1));
+      at += record->size;
+    }
+    tail.store(at, std::memory_order_release);
+  }
+};
+
+struct State {
+  // Rings only ever get pushed, so producers walk the list without locks.
+  std::atomic<Ring *> rings{nullptr};
+  // Set by producers when there is something to drain; the first one to set
+  // it wakes the drain thread.
+  std::atomic<bool> pending{false};
+  // Serializes drains, and guards the sink.
+  std::mutex mutex;
+  std::unique_ptr<Sink> sink = DefaultSink();
+};
+
+// Never destroyed, as the detached drain thread outlives static destructors.
+State &GetState() {
+  static State *state = new State;
+  return *state;
+}
+
+void DrainAll(State &state) {
+  for (Ring *ring = state.rings.load(std::memory_order_acquire);
+       ring != nullptr; ring = ring->next)
+    ring->Drain(state.sink.get());
+}
+
+void RunDrain() {
+  auto &state = GetState();
+  for (;;) {
+    state.pending.wait(false, std::memory_order_acquire);
+    // Reading the flag while clearing it orders the records of the producer
+    // that set it before this drain.
+    state.pending.exchange(false, std::memory_order_acq_rel);
+    std::lock_guard lock(state.mutex);
+    DrainAll(state);
+  }
+}
+
+Ring *AcquireRing() {
+  auto &state = GetState();
+  static std::once_flag started;
+  std::call_once(started, [] {
+    std::thread(RunDrain).detach();
+    atexit(Flush);
+  });
+  for (Ring *ring = state.rings.load(std::memory_order_acquire);
+       ring != nullptr; ring = ring->next) {
+    bool owned = false;
+    if (ring->owned.compare_exchange_strong(owned, true,
+                                            std::memory_order_acquire))
+      return ring;
+  }
+  auto *ring = new Ring;
+  ring->next = state.rings.load(std::memory_order_relaxed);
+  while (!state.rings.compare_exchange_weak(ring->next, ring,
+                                            std::memory_order_release,
+                                            std::memory_order_relaxed)) {
+  }
+  return ring;
+}
+
+// Hands the ring of an exiting thread over to the next new one.
+struct ThreadRing {
+  Ring *ring = AcquireRing();
+
+  ~ThreadRing() { ring->owned.store(false, std::memory_order_release); }
+};
+
+} // namespace
+
+#ifdef __ANDROID__
+void LogcatSink::Write(int prio, const char *tag, const char *message) {
+  __android_log_write(prio, tag, message);
+}
+#endif
+
+StreamSink::~StreamSink() {
+  if (owned_)
+    fclose(stream_);
+}
+
+std::unique_ptr<StreamSink> StreamSink::Open(const char *path) {
+  FILE *stream = fopen(path, "ae");
+  if (stream == nullptr)
+    return nullptr;
+  return std::make_unique<StreamSink>(stream, true);
+}
+
+void StreamSink::Write(int prio, const char *tag, const char *message) {
+  static constexpr char kPriorities[] = "??VDIWEF";
+  fprintf(stream_, "%c/%s: %s\n", kPriorities[prio & 7], tag, message);
+}
+
+std::unique_ptr<Sink> DefaultSink() {
+#ifdef __ANDROID__
+  return std::make_unique<LogcatSink>();
+#else
+  if (const char *path = getenv("DEMO_LOG_FILE")) {
+    if (auto sink = StreamSink::Open(path))
+      return sink;
+  }
+  return std::make_unique<StreamSink>(stderr);
+#endif
+}
+
+void SetSink(std::unique_ptr<Sink> sink) {
+  auto &state = GetState();
+  std::lock_guard lock(state.mutex);
+  DrainAll(state);
+  state.sink = std::move(sink);
+}
+
+void Flush() {
+  auto &state = GetState();
+  std::lock_guard lock(state.mutex);
+  DrainAll(state);
+}
+
+void log(int prio, const char *tag, const char *fmt, ...) {
+  thread_local ThreadRing thread_ring;
+  char message[kMaxMessage];
+  va_list ap;
+  va_start(ap, fmt);
+  int length = vsnprintf(message, sizeof(message), fmt, ap);
+  va_end(ap);
+  if (length < 0)
+    return;
+  if (size_t(length) >= sizeof(message))
+    length = sizeof(message) - 1;
+
+  auto &state = GetState();
+  if (!thread_ring.ring->Push(prio, tag, message, length)) {
+    // Only bursts faster than the sink get here, e.g. stack string dumps.
+    Flush();
+    thread_ring.ring->Push(prio, tag, message, length);
+  }
+  if (prio >= ANDROID_LOG_FATAL) {
+    Flush();
+  } else if (!state.pending.exchange(true, std::memory_order_acq_rel)) {
+    state.pending.notify_one();
+  }
+}
+
+} // namespace logging
@@ -0,0 +1,74 @@
+#include "map_snapshot.hpp"
+
+namespace VirtualMap {
+
+bool MapSnapshot::Load(Generation &into) {
+  if (!scanner_.ok() || (generation_ > 0 && !scanner_.Rewind()))
+    return false;
+
+  into.regions.clear();
+  into.paths.clear();
+  into.path_offsets.clear();
+
+  // The pool may still grow while scanning, so paths are recorded as offsets
+  // and resolved at the end. Consecutive mappings of one file share a copy.
+  std::string_view last_path;
+  MapEntry entry;
+  while (scanner_.Next(entry)) {
+    if (into.path_offsets.empty() || entry.path != last_path) {
+      into.path_offsets.push_back(into.paths.size());
+      into.paths.append(entry.path);
+    } else {
+      into.path_offsets.push_back(into.path_offsets.back());
+    }
+    last_path = {into.paths.data() + into.path_offsets.back(),
+                 entry.path.size()};
+    into.regions.push_back({entry.start, entry.end, entry.offset, entry.dev,
+                            entry.inode, entry.path, entry.perms,
+                            entry.is_private});
+  }
+
+  for (size_t i = 0; i < into.regions.size(); i++) {
+    auto &region = into.regions[i];
+    region.path = {into.paths.data() + into.path_offsets[i],
+                   region.path.size()};
+  }
+  return true;
+}
+
+bool MapSnapshot::Refresh(MapDelta &delta) {
+  delta.clear();
+  std::swap(current_, previous_);
+  if (!Load(current_)) {
+    std::swap(current_, previous_);
+    return false;
+  }
+  generation_++;
+
+  auto &before = previous_.regions;
+  auto &after = current_.regions;
+  size_t i = 0, j = 0;
+  while (i < before.size() || j < after.size()) {
+    if (j == after.size() ||
+        (i < before.size() && before[i].start < after[j].start)) {
+      delta.removed.push_back(&before[i++]);
+    } else if (i == before.size() || after[j].start < before[i].start) {
+      delta.added.push_back(&after[j++]);
+    } else if (!before[i].SameMapping(after[j])) {
+      delta.removed.push_back(&before[i++]);
+      delta.added.push_back(&after[j++]);
+    } else {
+      if (before[i].perms != after[j].perms ||
+          before[i].is_private != after[j].is_private) {
+        delta.changed.emplace_back(&before[i], &after[j]);
+      } else {
+        after[j].verdict = before[i].verdict;
+      }
+      i++;
+      j++;
+    }
+  }
+  return true;
+}
+
+} // namespace VirtualMap
@@ -0,0 +1,82 @@
+#include "matcher.hpp"
+
+namespace Matcher {
+
+AhoCorasick::AhoCorasick(std::span<const std::string_view> patterns,
+                         bool ignore_case)
+    : patterns_(static_cast<uint32_t>(patterns.size())) {
+  // Class 0 stands for every byte absent from the patterns. Ignoring case
+  // puts both cases of a letter in the same class.
+  for (auto pattern : patterns) {
+    for (unsigned char c : pattern) {
+      if (class_of_[c] != 0)
+        continue;
+      class_of_[c] = static_cast<uint8_t>(++classes_);
+      if (ignore_case && static_cast<unsigned>((c | 0x20) - 'a') < 26)
+        class_of_[c ^ 0x20] = class_of_[c];
+    }
+  }
+  if (classes_ == 0)
+    return;
+  classes_++;
+
+  constexpr uint32_t kNone = UINT32_MAX;
+  std::vector<std::vector<uint32_t>> own_outputs(1);
+  next_.assign(classes_, kNone);
+  for (uint32_t index = 0; index < patterns.size(); index++) {
+    if (patterns[index].empty())
+      continue;
+    uint32_t state = 0;
+    for (unsigned char c : patterns[index]) {
+      uint32_t &target = next_[state * classes_ + class_of_[c]];
+      if (target == kNone) {
+        target = static_cast<uint32_t>(own_outputs.size());
+        own_outputs.emplace_back();
+        next_.resize(next_.size() + classes_, kNone);
+      }
+      state = next_[state * classes_ + class_of_[c]];
+    }
+    own_outputs[state].push_back(index);
+  }
+
+  // Breadth-first over the trie: each state inherits the outputs of its
+  // failure state, and missing transitions are taken from it.
+  size_t states = own_outputs.size();
+  std::vector<uint32_t> fail(states, 0);
+  std::vector<uint32_t> order;
+  order.reserve(states);
+  for (uint32_t c = 0; c < classes_; c++) {
+    uint32_t &target = next_[c];
+    if (target == kNone) {
+      target = 0;
+    } else {
+      fail[target] = 0;
+      order.push_back(target);
+    }
+  }
+  for (size_t i = 0; i < order.size(); i++) {
+    uint32_t state = order[i];
+    auto &inherited = own_outputs[fail[state]];
+    own_outputs[state].insert(own_outputs[state].end(), inherited.begin(),
+                              inherited.end());
+    for (uint32_t c = 0; c < classes_; c++) {
+      uint32_t &target = next_[state * classes_ + c];
+      uint32_t fallback = next_[fail[state] * classes_ + c];
+      if (target == kNone) {
+        target = fallback;
+      } else {
+        fail[target] = fallback;
+        order.push_back(target);
+      }
+    }
+  }
+
+  output_begin_.reserve(states + 1);
+  for (auto &outputs : own_outputs) {
+    output_begin_.push_back(static_cast<uint32_t>(outputs_.size()));
+    outputs_.insert(outputs_.end(), outputs.begin(), outputs.end());
+  }
+  output_begin_.push_back(static_cast<uint32_t>(outputs_.size()));
+}
+
+} // namespace Matcher
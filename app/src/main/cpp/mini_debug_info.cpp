@@ -0,0 +1,165 @@
+#include "mini_debug_info.hpp"
+#include "cache_dir.hpp"
+#include "symbol_index.hpp"
+#include "xz.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <iterator>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace SandHook::MiniDebugInfo {
+
+namespace {
+
+constexpr char kCacheMagic[8] = {'S', 'Y', 'M', 'C', 'A', 'C', 'H', 'E'};
+constexpr uint32_t kCacheVersion = 1;
+
+// Followed by the symbols and then the strings.
+struct CacheHeader {
+  char magic[8];
+  uint32_t version;
+  // sizeof(ElfW(Sym)), as 32-bit and 64-bit processes may share the cache.
+  uint32_t symbol_size;
+  uint64_t symbol_count;
+  uint64_t strings_size;
+  uint32_t build_id_size;
+  uint8_t build_id[32];
+  uint32_t reserved;
+};
+static_assert(sizeof(CacheHeader) % alignof(ElfW(Sym)) == 0);
+
+std::string CachePath(std::string_view build_id) {
+  if (build_id.empty() || build_id.size() > sizeof(CacheHeader::build_id))
+    return {};
+  std::string name;
+  Cache::AppendHex(name, build_id);
+  return Cache::Path(name + ".symtab");
+}
+
+// Every name must be terminated within the string table.
+bool Valid(const Symtab &symtab) {
+  if (symtab.strings.empty() || symtab.strings.back() != '\0')
+    return false;
+  return std::all_of(symtab.symbols.begin(), symtab.symbols.end(),
+                     [&](const ElfW(Sym) & symbol) {
+                       return symbol.st_name < symtab.strings.size();
+                     });
+}
+
+} // namespace
+
+bool Decompress(std::span<const char> xz, std::vector<char> &elf) {
+  elf.clear();
+  // MiniDebugInfo usually compresses about four to one.
+  elf.reserve(xz.size() * 4 + 4096);
+  return Xz::Decode(xz, elf);
+}
+
+bool FindSymtab(std::span<const char> elf, Symtab &symtab) {
+  if (elf.size() < sizeof(ElfW(Ehdr)))
+    return false;
+  auto *header = reinterpret_cast<const ElfW(Ehdr) *>(elf.data());
+  if (memcmp(header->e_ident, ELFMAG, SELFMAG) != 0 ||
+      header->e_shentsize != sizeof(ElfW(Shdr)) ||
+      header->e_shoff % alignof(ElfW(Shdr)) != 0 ||
+      header->e_shoff > elf.size() ||
+      (elf.size() - header->e_shoff) / sizeof(ElfW(Shdr)) < header->e_shnum)
+    return false;
+  auto *sections =
+      reinterpret_cast<const ElfW(Shdr) *>(elf.data() + header->e_shoff);
+  auto in_bounds = [&](const ElfW(Shdr) & section) {
+    return section.sh_type != SHT_NOBITS && section.sh_offset <= elf.size() &&
+           section.sh_size <= elf.size() - section.sh_offset;
+  };
+  for (size_t i = 0; i < header->e_shnum; i++) {
+    auto &section = sections[i];
+    if (section.sh_type != SHT_SYMTAB || section.sh_link >= header->e_shnum)
+      continue;
+    auto &strings = sections[section.sh_link];
+    if (!in_bounds(section) || !in_bounds(strings) ||
+        section.sh_offset % alignof(ElfW(Sym)) != 0)
+      return false;
+    symtab.symbols = {
+        reinterpret_cast<const ElfW(Sym) *>(elf.data() + section.sh_offset),
+        section.sh_size / sizeof(ElfW(Sym))};
+    symtab.strings = elf.subspan(strings.sh_offset, strings.sh_size);
+    return Valid(symtab);
+  }
+  return false;
+}
+
+bool LoadCached(std::string_view build_id, Symtab &symtab,
+                std::pair<void *, size_t> &mapping) {
+  std::string path = CachePath(build_id);
+  if (path.empty())
+    return false;
+  int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0)
+    return false;
+  struct stat st;
+  void *map = MAP_FAILED;
+  if (fstat(fd, &st) == 0 && st.st_size >= (off_t)sizeof(CacheHeader))
+    map = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (map == MAP_FAILED)
+    return false;
+
+  size_t size = st.st_size;
+  auto *header = static_cast<const CacheHeader *>(map);
+  auto *file = static_cast<const char *>(map);
+  size_t payload_size = size - sizeof(CacheHeader);
+  bool valid =
+      memcmp(header->magic, kCacheMagic, sizeof(kCacheMagic)) == 0 &&
+      header->version == kCacheVersion &&
+      header->symbol_size == sizeof(ElfW(Sym)) &&
+      header->build_id_size == build_id.size() &&
+      memcmp(header->build_id, build_id.data(), build_id.size()) == 0 &&
+      header->symbol_count <= payload_size / sizeof(ElfW(Sym)) &&
+      header->strings_size ==
+          payload_size - header->symbol_count * sizeof(ElfW(Sym));
+  if (valid) {
+    symtab.symbols = {
+        reinterpret_cast<const ElfW(Sym) *>(file + sizeof(CacheHeader)),
+        static_cast<size_t>(header->symbol_count)};
+    symtab.strings = {file + size - header->strings_size,
+                      static_cast<size_t>(header->strings_size)};
+    valid = Valid(symtab);
+  }
+  if (!valid) {
+    munmap(map, size);
+    return false;
+  }
+  mapping = {map, size};
+  return true;
+}
+
+void StoreCached(std::string_view build_id, const Symtab &symtab) {
+  std::string path = CachePath(build_id);
+  if (path.empty())
+    return;
+  std::vector<ElfW(Sym)> symbols;
+  std::copy_if(symtab.symbols.begin(), symtab.symbols.end(),
+               std::back_inserter(symbols), SymbolIndex::Indexed);
+
+  CacheHeader header{};
+  memcpy(header.magic, kCacheMagic, sizeof(kCacheMagic));
+  header.version = kCacheVersion;
+  header.symbol_size = sizeof(ElfW(Sym));
+  header.symbol_count = symbols.size();
+  header.strings_size = symtab.strings.size();
+  header.build_id_size = build_id.size();
+  memcpy(header.build_id, build_id.data(), build_id.size());
+
+  Cache::Store(path,
+               {{reinterpret_cast<const char *>(&header), sizeof(header)},
+                {reinterpret_cast<const char *>(symbols.data()),
+                 symbols.size() * sizeof(ElfW(Sym))},
+                symtab.strings});
+}
+
+} // namespace SandHook::MiniDebugInfo
@@ -0,0 +1,151 @@
+#include "monitor.hpp"
+#include "detector.hpp"
+#include "logging.h"
+#include "scan.hpp"
+#include <algorithm>
+#include <condition_variable>
+#include <ctime>
+#include <mutex>
+#include <string>
+#include <sys/resource.h>
+#include <thread>
+#include <vector>
+
+namespace Monitor {
+
+namespace {
+
+using std::chrono::milliseconds;
+using std::chrono::nanoseconds;
+
+// Below the default priority of app threads, above that of background work.
+constexpr int kNice = 10;
+
+struct State {
+  // Serializes Start() and Stop(), so that a thread being stopped never sees
+  // the flag cleared for its successor.
+  std::mutex control;
+  std::mutex mutex;
+  std::condition_variable wake;
+  std::thread thread;
+  Options options;
+  bool stop = false;
+  Stats stats{};
+};
+
+State &GetState() {
+  static State *state = new State;
+  return *state;
+}
+
+uint64_t ThreadCpuNs() {
+  timespec ts;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+  return ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+// The next interval after a tick that took cpu of CPU time.
+milliseconds NextInterval(const Options &options, milliseconds interval,
+                          bool changed, nanoseconds cpu) {
+  interval = changed ? options.min_interval
+                     : std::min(interval * 2, options.max_interval);
+  if (options.cpu_budget > 0) {
+    auto budget = std::chrono::duration_cast<milliseconds>(
+        cpu / options.cpu_budget);
+    interval = std::max(interval, budget);
+  }
+  return interval;
+}
+
+void Run() {
+  // On Linux this only lowers the priority of the calling thread.
+  if (setpriority(PRIO_PROCESS, 0, kNice) != 0)
+    PLOGE("setpriority");
+
+  std::vector<Detectors::Detector *> detectors;
+  for (auto *detector : Detectors::Registered()) {
+    if (detector->cheap())
+      detectors.push_back(detector);
+  }
+  // Ticks run on this thread alone, so that they never wake the pool.
+  Detectors::Scheduler scheduler(1);
+  std::vector<std::string> previous;
+  auto &state = GetState();
+  std::unique_lock lock(state.mutex);
+  milliseconds interval = state.options.min_interval;
+
+  while (!state.stop) {
+    lock.unlock();
+    uint64_t begin = ThreadCpuNs();
+    // A scan in progress runs the same detectors and more, so the tick is
+    // skipped rather than waiting for it, which would hold up Stop().
+    std::vector<Detectors::Result> results;
+    bool ran = scheduler.TryRun(detectors, results);
+    bool changed = false;
+    if (ran) {
+      std::vector<std::string> findings;
+      for (auto &result : results)
+        findings.push_back(std::move(result.finding.summary));
+      changed = !previous.empty() && findings != previous;
+      previous = std::move(findings);
+    }
+    if (changed) {
+      LOGI("Monitor: findings changed, requesting a scan");
+      Scan::Request();
+    }
+    uint64_t cpu = ThreadCpuNs() - begin;
+
+    lock.lock();
+    if (ran)
+      interval = NextInterval(state.options, interval, changed,
+                              nanoseconds(cpu));
+    state.stats.ticks += ran;
+    state.stats.skipped += !ran;
+    state.stats.changes += changed;
+    state.stats.cpu_ns = ThreadCpuNs();
+    state.stats.interval = interval;
+    state.wake.wait_for(lock, interval, [&] { return state.stop; });
+  }
+}
+
+} // namespace
+
+void Start(const Options &options) {
+  auto &state = GetState();
+  std::lock_guard control(state.control);
+  std::lock_guard lock(state.mutex);
+  state.options = options;
+  if (state.thread.joinable())
+    return;
+  state.stop = false;
+  state.stats = {};
+  state.thread = std::thread(Run);
+}
+
+void Stop() {
+  auto &state = GetState();
+  std::lock_guard control(state.control);
+  std::thread thread;
+  {
+    std::lock_guard lock(state.mutex);
+    state.stop = true;
+    thread = std::move(state.thread);
+  }
+  state.wake.notify_all();
+  if (thread.joinable())
+    thread.join();
+}
+
+bool Running() {
+  auto &state = GetState();
+  std::lock_guard lock(state.mutex);
+  return state.thread.joinable();
+}
+
+Stats GetStats() {
+  auto &state = GetState();
+  std::lock_guard lock(state.mutex);
+  return state.stats;
+}
+
+} // namespace Monitor
@@ -1,48 +1,112 @@
-#include "atexit.hpp"
+#include "binary_report.hpp"
+#include "cache_dir.hpp"
+#include "instrument.hpp"
 #include "logging.h"
-#include "smap.h"
-#include "solist.hpp"
-#include "vmap.hpp"
-#include <format>
+#include "monitor.hpp"
+#include "scan.hpp"
 #include <jni.h>
-#include <string>
+
+extern "C" JNIEXPORT void JNICALL
+Java_org_matrix_demo_MainActivity_setCacheDir(JNIEnv *env, jobject /* this */,
+                                              jstring dir) {
+  const char *path = env->GetStringUTFChars(dir, nullptr);
+  if (path == nullptr)
+    return;
+  Cache::SetDir(path);
+  env->ReleaseStringUTFChars(dir, path);
+}
+
+namespace {
+
+JavaVM *vm = nullptr;
+jclass activity_class = nullptr;
+jmethodID on_scan_result = nullptr;
+
+// Tells MainActivity.onScanResult about each report, which it then reads
+// with writeReport. The scan worker stays attached to the VM for as long as
+// the process lives.
+void DeliverReport(const Scan::Report &report) {
+  JNIEnv *env;
+  if (vm->GetEnv(reinterpret_cast<void **>(&env), JNI_VERSION_1_6) != JNI_OK &&
+      vm->AttachCurrentThreadAsDaemon(&env, nullptr) != JNI_OK) {
+    LOGE("Failed to attach the scan worker");
+    return;
+  }
+  env->CallStaticVoidMethod(activity_class, on_scan_result,
+                            static_cast<jlong>(report.generation));
+  if (env->ExceptionCheck()) {
+    env->ExceptionDescribe();
+    env->ExceptionClear();
+  }
+}
+
+} // namespace
 
 extern "C" JNIEXPORT jstring JNICALL
 Java_org_matrix_demo_MainActivity_stringFromJNI(JNIEnv *env,
                                                 jobject /* this */) {
+  Scan::Wait(Scan::Request());
+  Scan::Pinned report;
+  return env->NewStringUTF(report ? report->text.c_str() : "");
+}
 
-  std::string solist_detection = "No injection found using solist";
-  std::string vmap_detection = "No injection found using vitrual map";
-  std::string counter_detection = "No injection found using module counter";
-  SoList::SoInfo *abnormal_soinfo = SoList::DetectInjection();
-  VirtualMap::MapInfo *abnormal_vmap = VirtualMap::DetectInjection();
-  size_t module_injected = SoList::DetectModules();
-  VirtualMap::DumpStackStrings();
-  auto g_array = Atexit::findAtexitArray();
-  if (g_array != nullptr) {
-    LOGD("g_array status: %s", g_array->format_state_string().c_str());
-  }
+extern "C" JNIEXPORT jlong JNICALL
+Java_org_matrix_demo_MainActivity_requestScan(JNIEnv *env, jobject thiz) {
+  // The class is looked up here, since the worker thread cannot find the
+  // classes of the app.
+  static bool listening = [&] {
+    env->GetJavaVM(&vm);
+    jclass clazz = env->GetObjectClass(thiz);
+    activity_class = static_cast<jclass>(env->NewGlobalRef(clazz));
+    on_scan_result = env->GetStaticMethodID(activity_class, "onScanResult",
+                                            "(J)V");
+    env->DeleteLocalRef(clazz);
+    if (on_scan_result == nullptr) {
+      env->ExceptionClear();
+      return false;
+    }
+    Scan::SetListener(DeliverReport);
+    return true;
+  }();
+  if (!listening)
+    LOGW("Scan results are only available by polling");
+  return static_cast<jlong>(Scan::Request());
+}
 
-  if (abnormal_soinfo != nullptr) {
-    solist_detection =
-        std::format("Solist: injection at {}", (void *)abnormal_soinfo);
-    LOGE("Abnormal soinfo %p: %s loaded at %s", abnormal_soinfo,
-         abnormal_soinfo->get_name(), abnormal_soinfo->get_path());
-  }
+extern "C" JNIEXPORT jint JNICALL
+Java_org_matrix_demo_MainActivity_writeReport(JNIEnv *env, jobject /* this */,
+                                              jobject buffer) {
+  Scan::Pinned report;
+  if (!report)
+    return 0;
+  auto *data = static_cast<char *>(env->GetDirectBufferAddress(buffer));
+  jlong capacity = env->GetDirectBufferCapacity(buffer);
+  if (data == nullptr || capacity < 0)
+    return -1;
+  return static_cast<jint>(
+      BinaryReport::Encode(*report, {data, static_cast<size_t>(capacity)}));
+}
 
-  if (abnormal_vmap != nullptr) {
-    vmap_detection =
-        std::format("Virtual map: injection at {}", abnormal_vmap->path);
-    LOGE("Abnormal vmap %s: [0x%lx-0x%lx]", abnormal_vmap->path.data(),
-         abnormal_vmap->start, abnormal_vmap->end);
-  }
+extern "C" JNIEXPORT void JNICALL
+Java_org_matrix_demo_MainActivity_startMonitor(JNIEnv * /* env */,
+                                               jobject /* this */) {
+  Monitor::Start();
+}
 
-  if (module_injected > 0) {
-    counter_detection = std::format(
-        "Module counter: {} shared libraries unloaded", module_injected);
-  }
+extern "C" JNIEXPORT void JNICALL
+Java_org_matrix_demo_MainActivity_stopMonitor(JNIEnv * /* env */,
+                                              jobject /* this */) {
+  Monitor::Stop();
+  auto stats = Monitor::GetStats();
+  LOGI("Monitor: %llu ticks, %llu skipped, %llu changes, %.3f ms cpu",
+       (unsigned long long)stats.ticks, (unsigned long long)stats.skipped,
+       (unsigned long long)stats.changes, stats.cpu_ns / 1e6);
+  if (auto summary = Instrument::Summary(); !summary.empty())
+    LOGI("Instrumentation: %s", summary.c_str());
+}
 
-  return env->NewStringUTF(
-      (solist_detection + "\n" + vmap_detection + "\n" + counter_detection)
-          .c_str());
+extern "C" JNIEXPORT jstring JNICALL
+Java_org_matrix_demo_MainActivity_instrumentationSummary(JNIEnv *env,
+                                                         jobject /* this */) {
+  return env->NewStringUTF(Instrument::Summary().c_str());
 }
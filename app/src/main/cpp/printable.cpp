@@ -0,0 +1,218 @@
+#include "printable.hpp"
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define PRINTABLE_X86 1
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#define PRINTABLE_NEON 1
+#endif
+
+namespace Printable {
+
+namespace {
+
+inline bool IsPrintable(char c) {
+  return static_cast<unsigned char>(c - 0x20) < 0x5f;
+}
+
+// Classifies the bytes left over after the last full vector step.
+void ClassifyTail(const char *data, size_t begin, size_t size,
+                  uint64_t *bits) {
+  for (size_t i = begin; i < size; i++) {
+    if (IsPrintable(data[i]))
+      bits[i / 64] |= uint64_t{1} << (i % 64);
+  }
+}
+
+void ClassifyScalar(const char *data, size_t size, uint64_t *bits) {
+  std::fill_n(bits, (size + 63) / 64, 0);
+  ClassifyTail(data, 0, size, bits);
+}
+
+#if PRINTABLE_X86
+void ClassifySse2(const char *data, size_t size, uint64_t *bits) {
+  std::fill_n(bits, (size + 63) / 64, 0);
+  // Bytes from 0x80 are negative as signed chars and fail the first test.
+  const __m128i low = _mm_set1_epi8(0x1f);
+  const __m128i high = _mm_set1_epi8(0x7f);
+  size_t i = 0;
+  for (; i + 16 <= size; i += 16) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+    __m128i printable =
+        _mm_and_si128(_mm_cmpgt_epi8(v, low), _mm_cmplt_epi8(v, high));
+    bits[i / 64] |= static_cast<uint64_t>(static_cast<uint16_t>(
+                        _mm_movemask_epi8(printable)))
+                    << (i % 64);
+  }
+  ClassifyTail(data, i, size, bits);
+}
+
+#ifdef __x86_64__
+__attribute__((target("avx2"))) void ClassifyAvx2(const char *data,
+                                                  size_t size,
+                                                  uint64_t *bits) {
+  std::fill_n(bits, (size + 63) / 64, 0);
+  const __m256i low = _mm256_set1_epi8(0x1f);
+  const __m256i high = _mm256_set1_epi8(0x7f);
+  size_t i = 0;
+  for (; i + 32 <= size; i += 32) {
+    __m256i v =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+    __m256i printable = _mm256_and_si256(_mm256_cmpgt_epi8(v, low),
+                                         _mm256_cmpgt_epi8(high, v));
+    bits[i / 64] |= static_cast<uint64_t>(static_cast<uint32_t>(
+                        _mm256_movemask_epi8(printable)))
+                    << (i % 64);
+  }
+  ClassifyTail(data, i, size, bits);
+}
+#endif
+#endif
+
+#if PRINTABLE_NEON
+void ClassifyNeon(const char *data, size_t size, uint64_t *bits) {
+  std::fill_n(bits, (size + 63) / 64, 0);
+  const uint8x16_t low = vdupq_n_u8(0x20);
+  const uint8x16_t high = vdupq_n_u8(0x7e);
+  const uint8x16_t weights = {1, 2, 4, 8, 16, 32, 64, 128,
+                              1, 2, 4, 8, 16, 32, 64, 128};
+  auto classify = [&](const char *p) {
+    uint8x16_t v = vld1q_u8(reinterpret_cast<const uint8_t *>(p));
+    return vandq_u8(vandq_u8(vcgeq_u8(v, low), vcleq_u8(v, high)), weights);
+  };
+  size_t i = 0;
+  // NEON has no movemask: weight each lane by its bit and fold the four
+  // vectors of a 64-byte block with pairwise additions.
+  for (; i + 64 <= size; i += 64) {
+    uint8x16_t sum = vpaddq_u8(vpaddq_u8(classify(data + i),
+                                         classify(data + i + 16)),
+                               vpaddq_u8(classify(data + i + 32),
+                                         classify(data + i + 48)));
+    sum = vpaddq_u8(sum, sum);
+    bits[i / 64] = vgetq_lane_u64(vreinterpretq_u64_u8(sum), 0);
+  }
+  for (; i + 16 <= size; i += 16) {
+    uint8x16_t sum = classify(data + i);
+    sum = vpaddq_u8(sum, sum);
+    sum = vpaddq_u8(sum, sum);
+    sum = vpaddq_u8(sum, sum);
+    bits[i / 64] |= static_cast<uint64_t>(vgetq_lane_u16(
+                        vreinterpretq_u16_u8(sum), 0))
+                    << (i % 64);
+  }
+  ClassifyTail(data, i, size, bits);
+}
+#endif
+
+} // namespace
+
+Kernel BestKernel() {
+#if PRINTABLE_X86
+#ifdef __x86_64__
+  static const bool has_avx2 = __builtin_cpu_supports("avx2");
+  if (has_avx2)
+    return Kernel::kVector256;
+#endif
+  return Kernel::kVector128;
+#elif PRINTABLE_NEON
+  return Kernel::kVector128;
+#else
+  return Kernel::kScalar;
+#endif
+}
+
+const char *KernelName(Kernel kernel) {
+  switch (kernel) {
+  case Kernel::kAuto:
+    return KernelName(BestKernel());
+  case Kernel::kScalar:
+    return "scalar";
+  case Kernel::kVector128:
+#if PRINTABLE_NEON
+    return "neon";
+#else
+    return "sse2";
+#endif
+  case Kernel::kVector256:
+    return "avx2";
+  }
+  return "unknown";
+}
+
+RunFinder::RunFinder(const char *data, size_t size, size_t min_length,
+                     Kernel kernel)
+    : data_(data), size_(size), min_length_(std::max<size_t>(min_length, 1)) {
+  if (kernel == Kernel::kAuto || kernel > BestKernel())
+    kernel = BestKernel();
+  switch (kernel) {
+#if PRINTABLE_X86
+#ifdef __x86_64__
+  case Kernel::kVector256:
+    classify_ = ClassifyAvx2;
+    break;
+#endif
+  case Kernel::kVector128:
+    classify_ = ClassifySse2;
+    break;
+#elif PRINTABLE_NEON
+  case Kernel::kVector128:
+    classify_ = ClassifyNeon;
+    break;
+#endif
+  default:
+    classify_ = ClassifyScalar;
+    break;
+  }
+}
+
+size_t RunFinder::Next(std::span<Run> out) {
+  size_t count = 0;
+  bool in_run = false;
+  size_t run_start = 0;
+  uint64_t bits[kChunkSize / 64];
+
+  // Returns false once out is full; position_ then points just past the run.
+  auto emit = [&](size_t end) {
+    in_run = false;
+    if (end - run_start < min_length_)
+      return true;
+    out[count++] = {run_start, end - run_start};
+    if (count < out.size())
+      return true;
+    position_ = end;
+    return false;
+  };
+
+  while (position_ < size_ && count < out.size()) {
+    size_t chunk = std::min(kChunkSize, size_ - position_);
+    classify_(data_ + position_, chunk, bits);
+    for (size_t word = 0; word < (chunk + 63) / 64; word++) {
+      uint64_t w = bits[word];
+      size_t base = position_ + word * 64;
+      if (in_run ? w == ~uint64_t{0} : w == 0)
+        continue;
+      // A zero bit past the end of the buffer closes the last run.
+      for (unsigned bit = 0; bit < 64;) {
+        uint64_t pending = (in_run ? ~w : w) & (~uint64_t{0} << bit);
+        if (pending == 0)
+          break;
+        bit = __builtin_ctzll(pending);
+        if (!in_run) {
+          in_run = true;
+          run_start = base + bit;
+        } else if (!emit(std::min(base + bit, size_))) {
+          return count;
+        }
+        bit++;
+      }
+    }
+    position_ += chunk;
+  }
+  if (in_run && count < out.size())
+    emit(size_);
+  return count;
+}
+
+} // namespace Printable
@@ -0,0 +1,147 @@
+#include "scan.hpp"
+#include "logging.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace Scan {
+
+// A report and the readers pinning it. The worker only writes to a slot that
+// is neither published nor pinned.
+struct ReportSlot {
+  std::atomic<uint32_t> readers = 0;
+  Report report;
+};
+
+namespace {
+
+// Three slots leave the worker one to write while a reader still pins the
+// report published before the last.
+constexpr int kSlots = 3;
+
+struct State {
+  ReportSlot slots[kSlots];
+  std::atomic<int> latest = -1;
+  std::atomic<uint64_t> completed = 0;
+  std::atomic<Listener> listener = nullptr;
+
+  std::mutex mutex;
+  std::condition_variable wake;
+  std::condition_variable done;
+  bool worker_started = false;
+  // The generation asked for last and the one of the scan started last; a
+  // scan is pending while they differ.
+  uint64_t requested = 0;
+  uint64_t started = 0;
+};
+
+// Never destroyed: the worker is detached and still waits on the condition
+// variables when the process exits.
+State &state = *new State;
+
+void Publish(Report &&report) {
+  int current = state.latest.load();
+  for (;;) {
+    for (int i = 0; i < kSlots; i++) {
+      // A reader pinning this slot after the check sees that it is not the
+      // latest and lets it go unread.
+      if (i == current || state.slots[i].readers.load() != 0)
+        continue;
+      uint64_t generation = report.generation;
+      state.slots[i].report = std::move(report);
+      state.latest.store(i);
+      state.completed.store(generation);
+      return;
+    }
+    std::this_thread::yield();
+  }
+}
+
+Report RunScan(uint64_t generation) {
+  auto begin = std::chrono::steady_clock::now();
+  Report report{generation, 0, Detectors::RunAll(), {}};
+  report.wall_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       std::chrono::steady_clock::now() - begin)
+                       .count();
+  for (auto &result : report.results) {
+    LOGD("Detector %s: %.3f ms wall, %.3f ms cpu", result.detector->name(),
+         result.wall_ns / 1e6, result.cpu_ns / 1e6);
+    if (result.finding.summary.empty())
+      continue;
+    if (!report.text.empty())
+      report.text += '\n';
+    report.text += result.finding.summary;
+  }
+  return report;
+}
+
+[[noreturn]] void Work() {
+  for (;;) {
+    uint64_t generation;
+    {
+      std::unique_lock lock(state.mutex);
+      state.wake.wait(lock, [] { return state.requested != state.started; });
+      generation = state.started = state.requested;
+    }
+    Publish(RunScan(generation));
+    if (auto notify = state.listener.load()) {
+      Pinned report;
+      notify(*report);
+    }
+    // Waiters check completed under the mutex, so notifying under it too
+    // cannot fall between their check and their wait.
+    std::lock_guard lock(state.mutex);
+    state.done.notify_all();
+  }
+}
+
+} // namespace
+
+void SetListener(Listener new_listener) { state.listener.store(new_listener); }
+
+uint64_t Request() {
+  std::lock_guard lock(state.mutex);
+  if (!state.worker_started) {
+    std::thread(Work).detach();
+    state.worker_started = true;
+  }
+  if (state.requested == state.started) {
+    state.requested = state.started + 1;
+    state.wake.notify_one();
+  }
+  return state.requested;
+}
+
+void Wait(uint64_t ticket) {
+  std::unique_lock lock(state.mutex);
+  state.done.wait(lock, [ticket] { return state.completed.load() >= ticket; });
+}
+
+uint64_t Completed() { return state.completed.load(); }
+
+Pinned::Pinned() {
+  for (;;) {
+    int i = state.latest.load();
+    if (i < 0)
+      return;
+    state.slots[i].readers.fetch_add(1);
+    if (state.latest.load() == i) {
+      slot_ = &state.slots[i];
+      return;
+    }
+    state.slots[i].readers.fetch_sub(1);
+  }
+}
+
+Pinned::~Pinned() {
+  if (slot_ != nullptr)
+    slot_->readers.fetch_sub(1);
+}
+
+const Report *Pinned::operator->() const { return &slot_->report; }
+
+const Report &Pinned::operator*() const { return slot_->report; }
+
+} // namespace Scan
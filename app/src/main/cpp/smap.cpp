@@ -1,93 +1,208 @@
 #include "smap.h"
 #include "logging.h"
-#include <errno.h>
-#include <inttypes.h>
-#include <stdio.h>
-#include <unistd.h>
+#include "vmap.hpp"
+#include <array>
+#include <cinttypes>
+#include <cstring>
+
 namespace StatsMap {
 
-template <typename T> static bool ParseSmaps(FILE *f, T callback) {
-  SmapsParserState state;
-  size_t line_size = 1024;
-  char *line = static_cast<char *>(malloc(line_size));
-  for (;;) {
-    errno = 0;
-    ssize_t rd = getline(&line, &line_size, f);
-    if (rd == -1) {
-      free(line);
-      if (state.parsed_header)
-        callback(state.current_entry);
-      return errno == 0;
-    } else {
-      if (line[rd - 1] == '\n') {
-        line[rd - 1] = '\0';
-        rd--;
-      }
-      if (!ParseSmapsLine(line, static_cast<size_t>(rd), &state, callback)) {
-        free(line);
-        return false;
-      }
-    }
+namespace {
+
+struct SmapsKey {
+  std::string_view name;
+  SmapsField field;
+  int64_t SmapsEntry::*member;
+};
+
+// Every "<name>: <value> kB" attribute printed by smap_gather_stats() and
+// __show_smap() in fs/proc/task_mmu.c. VmFlags is handled separately.
+constexpr SmapsKey kSmapsKeys[] = {
+    {"Size", kSize, &SmapsEntry::size_kb},
+    {"KernelPageSize", kKernelPageSize, &SmapsEntry::kernel_page_size_kb},
+    {"MMUPageSize", kMMUPageSize, &SmapsEntry::mmu_page_size_kb},
+    {"Rss", kRss, &SmapsEntry::rss_kb},
+    {"Pss", kPss, &SmapsEntry::pss_kb},
+    {"Pss_Dirty", kPssDirty, &SmapsEntry::pss_dirty_kb},
+    {"Shared_Clean", kSharedClean, &SmapsEntry::shared_clean_kb},
+    {"Shared_Dirty", kSharedDirty, &SmapsEntry::shared_dirty_kb},
+    {"Private_Clean", kPrivateClean, &SmapsEntry::private_clean_kb},
+    {"Private_Dirty", kPrivateDirty, &SmapsEntry::private_dirty_kb},
+    {"Referenced", kReferenced, &SmapsEntry::referenced_kb},
+    {"Anonymous", kAnonymous, &SmapsEntry::anonymous_kb},
+    {"LazyFree", kLazyFree, &SmapsEntry::lazy_free_kb},
+    {"AnonHugePages", kAnonHugePages, &SmapsEntry::anon_huge_pages_kb},
+    {"ShmemPmdMapped", kShmemPmdMapped, &SmapsEntry::shmem_pmd_mapped_kb},
+    {"FilePmdMapped", kFilePmdMapped, &SmapsEntry::file_pmd_mapped_kb},
+    {"Shared_Hugetlb", kSharedHugetlb, &SmapsEntry::shared_hugetlb_kb},
+    {"Private_Hugetlb", kPrivateHugetlb, &SmapsEntry::private_hugetlb_kb},
+    {"Swap", kSwap, &SmapsEntry::swap_kb},
+    {"SwapPss", kSwapPss, &SmapsEntry::swap_pss_kb},
+    {"Locked", kLocked, &SmapsEntry::locked_kb},
+};
+
+constexpr size_t kKeySlots = 64;
+constexpr int8_t kNoKey = -1;
+constexpr int8_t kVmFlagsKey = static_cast<int8_t>(std::size(kSmapsKeys));
+
+constexpr size_t HashKey(std::string_view key) {
+  return (key.size() * 7 + static_cast<unsigned char>(key[0]) * 3 +
+          static_cast<unsigned char>(key[key.size() - 1])) %
+         kKeySlots;
+}
+
+constexpr std::string_view KeyName(int8_t index) {
+  return index == kVmFlagsKey ? "VmFlags" : kSmapsKeys[index].name;
+}
+
+// Open addressing table from HashKey() to an index into kSmapsKeys, built at
+// compile time.
+constexpr auto kKeyTable = [] {
+  std::array<int8_t, kKeySlots> table{};
+  table.fill(kNoKey);
+  for (int8_t i = 0; i <= kVmFlagsKey; i++) {
+    size_t slot = HashKey(KeyName(i));
+    while (table[slot] != kNoKey)
+      slot = (slot + 1) % kKeySlots;
+    table[slot] = i;
+  }
+  return table;
+}();
+
+constexpr int8_t FindKey(std::string_view key) {
+  if (key.empty())
+    return kNoKey;
+  for (size_t slot = HashKey(key); kKeyTable[slot] != kNoKey;
+       slot = (slot + 1) % kKeySlots) {
+    if (KeyName(kKeyTable[slot]) == key)
+      return kKeyTable[slot];
   }
+  return kNoKey;
 }
 
-static inline const char *FindNthToken(const char *line, size_t n,
-                                       size_t size) {
-  size_t tokens = 0;
-  bool parsing_token = false;
-  for (size_t i = 0; i < size; ++i) {
-    if (!parsing_token && line[i] != ' ') {
-      parsing_token = true;
-      if (tokens++ == n)
-        return line + static_cast<ssize_t>(i);
+static_assert(FindKey("Private_Dirty") == 9);
+static_assert(FindKey("VmFlags") == kVmFlagsKey);
+static_assert(FindKey("THPeligible") == kNoKey);
+
+// Bit of every two-letter VmFlags mnemonic, indexed by its letters.
+constexpr auto kVmFlagTable = [] {
+  std::array<uint8_t, 26 * 26> table{};
+  for (size_t i = 0; i < std::size(kVmFlagNames); i++) {
+    table[(kVmFlagNames[i][0] - 'a') * 26 + kVmFlagNames[i][1] - 'a'] = i + 1;
+  }
+  return table;
+}();
+
+uint64_t ParseVmFlags(const char *p, const char *end) {
+  uint64_t flags = 0;
+  for (; p + 1 < end; p++) {
+    unsigned first = static_cast<unsigned char>(p[0]) - 'a';
+    unsigned second = static_cast<unsigned char>(p[1]) - 'a';
+    if (first < 26 && second < 26) {
+      if (uint8_t bit = kVmFlagTable[first * 26 + second])
+        flags |= uint64_t{1} << (bit - 1);
+      p += 2;
     }
-    if (line[i] == ' ')
-      parsing_token = false;
   }
-  return nullptr;
+  return flags;
 }
 
-template <typename T>
-static bool ParseSmapsLine(char *line, size_t size, SmapsParserState *state,
-                           T callback) {
-  char *first_token_end = static_cast<char *>(memchr(line, ' ', size));
-  if (first_token_end == nullptr || first_token_end == line)
-    return false; // Malformed.
-  bool is_header = *(first_token_end - 1) != ':';
-  if (is_header) {
-    if (state->parsed_header)
-      callback(state->current_entry);
-    state->current_entry = {};
-    const char *last_token_begin = FindNthToken(line, 5u, size);
-    if (last_token_begin)
-      state->current_entry.pathname.assign(last_token_begin);
-    state->parsed_header = true;
-    return true;
-  }
+} // namespace
+
+SmapsLine ParseSmapsLine(std::string_view line, uint32_t fields,
+                         SmapsParserState *state) {
+  const char *begin = line.data();
+  const char *end = begin + line.size();
+  auto *first_token_end = static_cast<const char *>(
+      memchr(begin, ' ', line.size()));
+  if (first_token_end == nullptr || first_token_end == begin)
+    return SmapsLine::kMalformed;
+  if (*(first_token_end - 1) != ':')
+    return SmapsLine::kHeader;
   if (!state->parsed_header)
+    return SmapsLine::kMalformed;
+
+  int8_t key =
+      FindKey({begin, static_cast<size_t>(first_token_end - begin - 1)});
+  if (key == kNoKey)
+    return SmapsLine::kAttribute;
+
+  if (key == kVmFlagsKey) {
+    if (fields & kVmFlags)
+      state->current_entry.vm_flags = ParseVmFlags(first_token_end, end);
+    return SmapsLine::kAttribute;
+  }
+
+  if ((fields & kSmapsKeys[key].field) == 0)
+    return SmapsLine::kAttribute;
+  const char *p = first_token_end;
+  while (p < end && *p == ' ')
+    p++;
+  int64_t value = 0;
+  for (; p < end && static_cast<unsigned char>(*p - '0') < 10u; p++)
+    value = value * 10 + (*p - '0');
+  state->current_entry.*kSmapsKeys[key].member = value;
+  return SmapsLine::kAttribute;
+}
+
+bool StartSmapsEntry(std::string_view line, SmapsParserState *state) {
+  VirtualMap::MapEntry header;
+  if (!VirtualMap::ParseMapsLine(line, header))
     return false;
-  sscanf(line, "Size: %" PRId64 " kB", &state->current_entry.size_kb);
-  sscanf(line, "Swap: %" PRId64 " kB", &state->current_entry.swap_kb);
-  sscanf(line, "Private_Dirty: %" PRId64 " kB",
-         &state->current_entry.private_dirty_kb);
+  auto &entry = state->current_entry;
+  entry.start = header.start;
+  entry.end = header.end;
+  for (auto &key : kSmapsKeys)
+    entry.*key.member = -1;
+  entry.vm_flags = 0;
+  // Keeps the capacity of the previous path.
+  entry.pathname.assign(header.path);
+  state->parsed_header = true;
   return true;
 }
 
-SmapsEntry DetectInjection(std::string lib) {
-  SmapsEntry injection;
+DirtyReport DetectInjection(const Matcher::AhoCorasick &libraries,
+                            ProcFs::Source smaps) {
+  DirtyReport report;
+  report.private_dirty_kb.assign(libraries.size(), 0);
 
-  auto self_maps = fopen("/proc/self/smaps", "re");
-  ParseSmaps(self_maps, [&injection, lib](const SmapsEntry &entry) {
-    if (entry.pathname.find(lib) != std::string::npos &&
-        entry.private_dirty_kb > 0) {
-      injection.pathname = entry.pathname;
-      injection.private_dirty_kb = entry.private_dirty_kb;
-      LOGD("Injection at %s: Private_Dirty %d kB", injection.pathname.data(),
-           injection.private_dirty_kb);
-    }
+  ProcFs::LineReader reader(smaps);
+  ParseSmaps(reader, kPrivateDirty, [&](const SmapsEntry &entry) {
+    if (entry.private_dirty_kb <= 0)
+      return;
+    // Patterns may occur several times in one path; report each once.
+    size_t first = report.hits.size();
+    libraries.Scan(entry.pathname, [&](uint32_t library, size_t) {
+      for (size_t i = first; i < report.hits.size(); i++) {
+        if (report.hits[i].library == library)
+          return true;
+      }
+      report.hits.push_back({library, entry.start, entry.end,
+                             entry.private_dirty_kb, entry.pathname});
+      report.private_dirty_kb[library] += entry.private_dirty_kb;
+      LOGD("Injection at %s: Private_Dirty %" PRId64 " kB",
+           entry.pathname.data(), entry.private_dirty_kb);
+      return true;
+    });
   });
-  fclose(self_maps);
+  LOGD("%zu dirty regions of %zu watched libraries", report.hits.size(),
+       libraries.size());
 
+  return report;
+}
+
+DirtyReport DetectInjection(std::span<const std::string_view> libraries) {
+  return DetectInjection(Matcher::AhoCorasick(libraries));
+}
+
+SmapsEntry DetectInjection(std::string lib) {
+  SmapsEntry injection;
+  std::string_view library = lib;
+  auto report = DetectInjection(std::span(&library, 1));
+  if (!report.hits.empty()) {
+    injection.pathname = std::move(report.hits.back().pathname);
+    injection.private_dirty_kb = report.hits.back().private_dirty_kb;
+  }
   return injection;
 }
 
@@ -0,0 +1,256 @@
+#include "soinfo_allocator.hpp"
+#include "solist.hpp"
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <utility>
+
+namespace SoList {
+
+namespace {
+
+// LinkerBlockAllocator aligns blocks to the size of its free list node.
+constexpr size_t kBlockAlign = 2 * sizeof(void *);
+// The pool header: a pointer to the next pool, padded to 16 bytes.
+constexpr size_t kPoolHeader = 16;
+
+std::vector<uint32_t> AddressOrder(std::span<const Snapshot::Entry> entries) {
+  std::vector<uint32_t> order(entries.size());
+  // Without unloads, the list is already in address order.
+  bool sorted = true;
+  for (uint32_t i = 0; i < entries.size(); i++) {
+    order[i] = i;
+    sorted = sorted && (i == 0 || entries[i - 1].address < entries[i].address);
+  }
+  if (sorted)
+    return order;
+  // Sorting the addresses with their index keeps the comparisons in cache.
+  std::vector<std::pair<uintptr_t, uint32_t>> addresses(entries.size());
+  for (uint32_t i = 0; i < entries.size(); i++)
+    addresses[i] = {entries[i].address, i};
+  std::sort(addresses.begin(), addresses.end());
+  for (size_t i = 0; i < addresses.size(); i++)
+    order[i] = addresses[i].second;
+  return order;
+}
+
+size_t InferBlockSize(std::span<const Snapshot::Entry> entries,
+                      std::span<const uint32_t> order,
+                      const AllocatorModel &model) {
+  size_t min_size = SoInfo::solist_realpath_offset + sizeof(std::string);
+  min_size = (min_size + kBlockAlign - 1) & ~(kBlockAlign - 1);
+  std::vector<uintptr_t> distances;
+  for (size_t i = 1; i < order.size(); i++) {
+    uintptr_t distance =
+        entries[order[i]].address - entries[order[i - 1]].address;
+    if (distance >= min_size && distance < model.pool_size &&
+        distance % kBlockAlign == 0)
+      distances.push_back(distance);
+  }
+  if (distances.empty())
+    return 0;
+  // The mode; ties go to the smaller distance, as holes only make distances
+  // longer.
+  std::sort(distances.begin(), distances.end());
+  size_t best = distances[0], best_count = 0;
+  for (size_t i = 0; i < distances.size();) {
+    size_t k = i;
+    while (k < distances.size() && distances[k] == distances[i])
+      k++;
+    if (k - i > best_count) {
+      best = distances[i];
+      best_count = k - i;
+    }
+    i = k;
+  }
+  return best;
+}
+
+// The start of the pool holding the soinfo at \p address: the highest page
+// boundary that puts it on the block grid after the header, or 0 if none
+// does.
+uintptr_t PoolBase(uintptr_t address, size_t block,
+                   const AllocatorModel &model) {
+  for (size_t offset = kPoolHeader;
+       offset + block <= model.pool_size && offset <= address;
+       offset += block) {
+    if ((address - offset) % model.page_size == 0)
+      return address - offset;
+  }
+  return 0;
+}
+
+// The lowest page boundary on the block grid of \p first that still leaves
+// \p last within the pool, given that \p base is one.
+uintptr_t LowestPoolBase(uintptr_t base, uintptr_t last, size_t block,
+                         const AllocatorModel &model) {
+  uintptr_t limit = model.pool_size - kPoolHeader - block;
+  for (uintptr_t next = base - block; next < base; next -= block) {
+    if (last - next - kPoolHeader > limit)
+      break;
+    if (next % model.page_size == 0)
+      base = next;
+  }
+  return base;
+}
+
+// The start of the pool holding \p address in the allocator mappings, or 0
+// if it is in none of them.
+uintptr_t MappedPoolBase(uintptr_t address, const AllocatorModel &model) {
+  auto &mappings = model.mappings;
+  auto it = std::upper_bound(
+      mappings.begin(), mappings.end(), address,
+      [](uintptr_t address, auto &mapping) { return address < mapping.first; });
+  if (it == mappings.begin() || address >= (--it)->second)
+    return 0;
+  return it->first + (address - it->first) / model.pool_size * model.pool_size;
+}
+
+} // namespace
+
+size_t InferBlockSize(const Snapshot &snapshot, const AllocatorModel &model) {
+  auto entries = snapshot.entries();
+  return InferBlockSize(entries, AddressOrder(entries), model);
+}
+
+std::vector<Anomaly> FindAnomalies(const Snapshot &snapshot,
+                                   const AllocatorModel &model) {
+  std::vector<Anomaly> anomalies;
+  auto entries = snapshot.entries();
+  if (entries.empty())
+    return anomalies;
+
+  // In list order, which is load order: the checks of the fields, and the
+  // first library loaded after the app is specialized.
+  bool app_process_loaded = false;
+  size_t nativehelper = entries.size(), specialized = entries.size();
+  for (size_t i = 0; i < entries.size(); i++) {
+    const char *path = snapshot.path(entries[i]);
+    const char *name = snapshot.name(entries[i]);
+    if (path == nullptr || path[0] == '\0') {
+      anomalies.push_back(
+          {Anomaly::kEmptyPath, Anomaly::kHigh, entries[i].address, 1});
+    } else if (name == nullptr) {
+      if (app_process_loaded)
+        anomalies.push_back(
+            {Anomaly::kNameless, Anomaly::kHigh, entries[i].address, 1});
+      else if (strstr(path, "/system/bin/app_proces"))
+        app_process_loaded = true;
+    } else if (nativehelper == entries.size() &&
+               strcmp(name, "libnativehelper.so") == 0) {
+      nativehelper = i;
+    } else if (specialized == entries.size() &&
+               (strcmp(name, "libart.so") == 0 ||
+                strcmp(name, "libdexfile.so") == 0)) {
+      specialized = i;
+    }
+  }
+  // Unloading is normal once both are loaded.
+  size_t unloads_allowed_from =
+      nativehelper == entries.size() || specialized == entries.size()
+          ? entries.size()
+          : std::max(nativehelper, specialized);
+
+  auto order = AddressOrder(entries);
+  size_t block = model.block_size != 0
+                     ? model.block_size
+                     : InferBlockSize(entries, order, model);
+  if (block == 0)
+    return anomalies;
+
+  // In address order, the soinfos split into pools: from the first soinfo
+  // of a pool, the following ones on its block grid up to its end.
+  struct Pool {
+    size_t begin, end;
+    // 0 if the first soinfo is in no pool.
+    uintptr_t base;
+    size_t trailing;
+  };
+  size_t per_pool = (model.pool_size - kPoolHeader) / block;
+  auto in_pool = [&](uintptr_t address, uintptr_t base) {
+    uintptr_t offset = address - base - kPoolHeader;
+    return address >= base + kPoolHeader && offset % block == 0 &&
+           offset / block < per_pool;
+  };
+  bool mapped = !model.mappings.empty();
+  std::vector<Pool> pools;
+  for (size_t i = 0; i < order.size();) {
+    uintptr_t first = entries[order[i]].address;
+    uintptr_t base = mapped ? MappedPoolBase(first, model)
+                            : PoolBase(first, block, model);
+    if (base != 0 && !in_pool(first, base))
+      base = 0;
+    size_t end = i + 1;
+    while (base != 0 && end < order.size() &&
+           in_pool(entries[order[end]].address, base))
+      end++;
+    size_t trailing = 0;
+    if (base != 0) {
+      // Leading blocks are counted from the highest possible start, and
+      // trailing ones from the lowest.
+      uintptr_t last = entries[order[end - 1]].address;
+      uintptr_t low = mapped ? base : LowestPoolBase(base, last, block, model);
+      trailing = per_pool - 1 - (last - low - kPoolHeader) / block;
+    }
+    pools.push_back({i, end, base, trailing});
+    i = end;
+  }
+
+  // Only the pool mapped last has blocks after its last soinfo that were
+  // never handed out. It is one of the pools with free blocks there, the one
+  // whose last soinfo was loaded last, and its soinfos were all loaded after
+  // the other pools were full.
+  const Pool *newest = nullptr;
+  for (auto &pool : pools) {
+    if (pool.trailing != 0 &&
+        (newest == nullptr || order[pool.end - 1] > order[newest->end - 1]))
+      newest = &pool;
+  }
+  uint32_t newest_loaded = entries.size();
+  if (newest != nullptr) {
+    for (size_t i = newest->begin; i < newest->end; i++)
+      newest_loaded = std::min(newest_loaded, order[i]);
+  }
+
+  size_t first_hole = anomalies.size(), free_blocks = 0;
+  // The free blocks were handed out before the soinfo loaded at \p loaded.
+  auto dropped = [&](uintptr_t address, size_t blocks, uint32_t loaded) {
+    free_blocks += blocks;
+    anomalies.push_back({Anomaly::kDropped,
+                         loaded < unloads_allowed_from ? Anomaly::kHigh
+                                                       : Anomaly::kLow,
+                         address, blocks});
+  };
+  for (auto &pool : pools) {
+    const Snapshot::Entry &first = entries[order[pool.begin]];
+    if (pool.base == 0) {
+      anomalies.push_back(
+          {Anomaly::kIsolated, Anomaly::kMedium, first.address, 1});
+      continue;
+    }
+    // Blocks are handed out from the start of a pool.
+    uintptr_t leading = first.address - pool.base - kPoolHeader;
+    if (leading != 0)
+      dropped(pool.base + kPoolHeader, leading / block, order[pool.begin]);
+    for (size_t i = pool.begin + 1; i < pool.end; i++) {
+      uintptr_t prev = entries[order[i - 1]].address;
+      uintptr_t distance = entries[order[i]].address - prev;
+      if (distance > block)
+        dropped(prev + block, distance / block - 1, order[i]);
+    }
+    if (pool.trailing != 0 && &pool != newest)
+      dropped(entries[order[pool.end - 1]].address + block, pool.trailing,
+              newest_loaded);
+  }
+
+  if (model.unload_counter != SIZE_MAX && free_blocks > model.unload_counter) {
+    for (size_t i = first_hole; i < anomalies.size(); i++) {
+      if (anomalies[i].kind == Anomaly::kDropped &&
+          anomalies[i].confidence == Anomaly::kLow)
+        anomalies[i].confidence = Anomaly::kMedium;
+    }
+  }
+  return anomalies;
+}
+
+} // namespace SoList
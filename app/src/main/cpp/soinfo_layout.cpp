@@ -0,0 +1,76 @@
+#include "soinfo_layout.hpp"
+#include "cache_dir.hpp"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <string>
+#include <unistd.h>
+
+namespace SoList {
+
+namespace {
+
+constexpr char kLayoutMagic[8] = {'S', 'O', 'L', 'A', 'Y', 'O', 'U', 'T'};
+constexpr uint32_t kLayoutVersion = 1;
+
+struct LayoutRecord {
+  char magic[8];
+  uint32_t version;
+  uint32_t pointer_size;
+  uint32_t build_id_size;
+  uint8_t build_id[32];
+  Layout layout;
+};
+
+std::string LayoutPath(std::string_view build_id) {
+  if (build_id.empty() || build_id.size() > sizeof(LayoutRecord::build_id))
+    return {};
+  std::string name = "soinfo-";
+  name += kAbi;
+  name += '-';
+  Cache::AppendHex(name, build_id);
+  return Cache::Path(name + ".layout");
+}
+
+} // namespace
+
+bool LoadLayout(std::string_view build_id, Layout &layout) {
+  std::string path = LayoutPath(build_id);
+  if (path.empty())
+    return false;
+  int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0)
+    return false;
+  LayoutRecord record;
+  ssize_t n;
+  do {
+    n = read(fd, &record, sizeof(record));
+  } while (n < 0 && errno == EINTR);
+  close(fd);
+  if (n != sizeof(record) ||
+      memcmp(record.magic, kLayoutMagic, sizeof(kLayoutMagic)) != 0 ||
+      record.version != kLayoutVersion ||
+      record.pointer_size != sizeof(void *) ||
+      record.build_id_size != build_id.size() ||
+      memcmp(record.build_id, build_id.data(), build_id.size()) != 0)
+    return false;
+  layout = record.layout;
+  return true;
+}
+
+void StoreLayout(std::string_view build_id, const Layout &layout) {
+  std::string path = LayoutPath(build_id);
+  if (path.empty())
+    return;
+  LayoutRecord record{};
+  memcpy(record.magic, kLayoutMagic, sizeof(kLayoutMagic));
+  record.version = kLayoutVersion;
+  record.pointer_size = sizeof(void *);
+  record.build_id_size = build_id.size();
+  memcpy(record.build_id, build_id.data(), build_id.size());
+  record.layout = layout;
+  Cache::Store(path, {{reinterpret_cast<const char *>(&record),
+                       sizeof(record)}});
+}
+
+} // namespace SoList
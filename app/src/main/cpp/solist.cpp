@@ -1,11 +1,25 @@
 #include "solist.hpp"
+#include "instrument.hpp"
 #include "logging.h"
+#include "solist_snapshot.hpp"
+#include <unistd.h>
 
 namespace SoList {
 
 ProtectedDataGuard::FuncType ProtectedDataGuard::ctor = NULL;
 ProtectedDataGuard::FuncType ProtectedDataGuard::dtor = NULL;
 
+namespace {
+
+SoInfo *solinker = NULL;
+SoInfo *somain = NULL;
+uint64_t *g_module_unload_counter = NULL;
+
+// Resolves the symbols above and the soinfo layout.
+bool Initialize();
+
+} // namespace
+
 size_t DetectModules() {
   if (g_module_unload_counter == NULL) {
     LOGI("g_module_unload_counter not found");
@@ -20,118 +34,100 @@ SoInfo *DetectInjection() {
     LOGE("Failed to initialize solist");
     return NULL;
   }
-  SoInfo *prev = solinker;
-  size_t gap = 0;
-  auto gap_repeated = 0;
-  bool app_process_loaded = false;
-  bool app_specialized = false;
-  const char *libraries_after_specialization[2] = {"libart.so",
-                                                   "libdexfile.so"};
-  bool nativehelper_loaded =
-      false; // Not necessarily loaded after AppSpecialize
-
-  for (auto iter = solinker; iter; iter = iter->get_next()) {
-    // No soinfo has empty path name
-    if (iter->get_path() == NULL || iter->get_path()[0] == '\0') {
-      return iter;
-    }
-
-    if (iter->get_name() == NULL && app_process_loaded) {
-      return iter;
-    }
+  // Linker memory is only read while taking the snapshot.
+  auto snapshot = Snapshot::Capture(solinker);
+  return reinterpret_cast<SoInfo *>(FindInjection(snapshot));
+}
 
-    if (iter->get_name() == NULL &&
-        strstr(iter->get_path(), "/system/bin/app_proces")) {
-      app_process_loaded = true;
-      // /system/bin/app_process64 maybe set null name
-      LOGD("Skip %s, gap size", iter, iter->get_path());
-      continue;
-    }
+std::vector<Anomaly> DetectAnomalies() {
+  if (solinker == NULL && !Initialize()) {
+    LOGE("Failed to initialize solist");
+    return {};
+  }
+  return DetectAnomalies(Snapshot::Capture(solinker), {});
+}
 
-    if (iter - prev != gap && gap_repeated < 1) {
-      gap = iter - prev;
-      gap_repeated = 0;
-    } else if (iter - prev == gap) {
-      LOGD("Skip soinfo %p: %s", iter, iter->get_name());
-      gap_repeated++;
-    } else if (iter - prev == 2 * gap) {
-      // A gap appears, indicating that one library was unloaded
-      auto dropped = (SoInfo *)((uintptr_t)prev + gap);
-
-      if (!nativehelper_loaded || !app_specialized) {
-        // gap cannot appear before libnativehelper is loaded
-        return dropped;
-      } else {
-        // gap may appear after any of these libraries is loaded
-        LOGW("%p is dropped between %s and %s", dropped, prev->get_path(),
-             iter->get_path());
-      }
-    } else {
-      gap_repeated--;
-      if (gap != 0)
-        LOGI("Suspicious gap 0x%lx or 0x%lx != 0x%lx between %s and %s",
-             iter - prev, prev - iter, gap, prev->get_name(), iter->get_name());
-    }
+std::vector<Anomaly>
+DetectAnomalies(const Snapshot &snapshot,
+                std::span<const VirtualMap::MapRegion> maps) {
+  AllocatorModel model;
+  for (auto &region : maps) {
+    if (region.path == "[anon:linker_alloc]")
+      model.mappings.emplace_back(region.start, region.end);
+  }
+  model.block_size = SoInfo::solist_size;
+  model.page_size = sysconf(_SC_PAGESIZE);
+  model.pool_size = 100 * model.page_size;
+  if (g_module_unload_counter != NULL)
+    model.unload_counter = *g_module_unload_counter;
+  return FindAnomalies(snapshot, model);
+}
 
-    auto name = iter->get_name();
-    if (!app_specialized) {
-      for (int i = 0; i < 2; i++) {
-        if (strcmp(name, libraries_after_specialization[i]) == 0) {
-          app_specialized = true;
-          break;
-        }
-      }
-    }
+bool Ready() {
+  static bool ready = Initialize();
+  if (!ready)
+    LOGE("Failed to initialize solist");
+  return ready;
+}
 
-    if (!nativehelper_loaded && strcmp(name, "libnativehelper.so") == 0) {
-      nativehelper_loaded = true;
-    }
+Snapshot Capture() {
+  if (!Ready())
+    return {};
+  return Snapshot::Capture(solinker);
+}
 
-    prev = iter;
-  }
+namespace {
 
-  return nullptr;
+// The check findHeuristicOffsets() applies to every candidate, for the
+// offsets in use only.
+bool ProbeLayout(const std::string &linker_name) {
+  size_t fields_end = SoInfo::solist_realpath_offset + sizeof(std::string);
+  if (SoInfo::solist_size != 0 && SoInfo::solist_size < fields_end)
+    return false;
+  auto *realpath = reinterpret_cast<std::string *>(
+      reinterpret_cast<uintptr_t>(solinker) + SoInfo::solist_realpath_offset);
+  return realpath->size() == linker_name.size() &&
+         strcmp(realpath->c_str(), linker_name.c_str()) == 0 &&
+         solinker->get_next() != nullptr;
 }
 
+enum LinkerSymbol : size_t {
+  kGuardCtor,
+  kGuardDtor,
+  kSolinker,
+  kSolist,
+  kGetRealpath,
+  kModuleUnloadCounter,
+  kSomain,
+};
+
+// In LinkerSymbol order. Hashed at compile time; LTO may suffix the local
+// ones with .llvm.<hash>.
+constexpr SandHook::SymbolRequest kLinkerSymbols[] = {
+    {"__dl__ZN18ProtectedDataGuardC2Ev"},
+    {"__dl__ZN18ProtectedDataGuardD2Ev"},
+    {"__dl__ZL8solinker", true},
+    // for SDK < 36 (Android 16), the linker binary is loaded with name solist
+    {"__dl__ZL6solist", true},
+    {"__dl__ZNK6soinfo12get_realpathEv"},
+    {"__dl__ZL23g_module_unload_counter", true},
+    {"__dl__ZL6somain", true},
+};
+
 bool Initialize() {
-  SandHook::ElfImg linker("/linker");
-  if (!ProtectedDataGuard::setup(linker))
+  auto linker = SandHook::ElfImg::Shared("/linker");
+  if (linker == nullptr)
     return false;
-  LOGI("found symbol ProtectedDataGuard");
+  ElfW(Addr) addresses[std::size(kLinkerSymbols)];
+  linker->resolveAll(kLinkerSymbols, addresses);
 
-  std::string_view somain_sym_name =
-      linker.findSymbolNameByPrefix("__dl__ZL6somain");
-  if (somain_sym_name.empty())
+  if (!ProtectedDataGuard::setup(addresses[kGuardCtor], addresses[kGuardDtor]))
     return false;
-  LOGI("found symbol name %s", somain_sym_name.data());
-
-  /* INFO: The size isn't a magic number, it's the size for the string:
-   * .llvm.7690929523238822858 */
-  char llvm_sufix[25 + 1];
-
-  if (somain_sym_name.length() != strlen("__dl__ZL6somain")) {
-    strncpy(llvm_sufix, somain_sym_name.data() + strlen("__dl__ZL6somain"),
-            sizeof(llvm_sufix));
-  } else {
-    llvm_sufix[0] = '\0';
-  }
-
-  char solinker_sym_name[sizeof("__dl__ZL8solinker") + sizeof(llvm_sufix)];
-  snprintf(solinker_sym_name, sizeof(solinker_sym_name), "__dl__ZL8solinker%s",
-           llvm_sufix);
-
-  // for SDK < 36 (Android 16), the linker binary is loaded with name solist
-  char solist_sym_name[sizeof("__dl__ZL6solist") + sizeof(llvm_sufix)];
-  snprintf(solist_sym_name, sizeof(solist_sym_name), "__dl__ZL6solist%s",
-           llvm_sufix);
-
-  char sonext_sym_name[sizeof("__dl__ZL6sonext") + sizeof(llvm_sufix)];
-  snprintf(sonext_sym_name, sizeof(sonext_sym_name), "__dl__ZL6sonext%s",
-           llvm_sufix);
+  LOGI("found symbol ProtectedDataGuard");
 
-  solinker = getStaticPointer<SoInfo>(linker, solinker_sym_name);
+  solinker = getStaticPointer<SoInfo>(addresses[kSolinker]);
   if (solinker == nullptr) {
-    solinker = getStaticPointer<SoInfo>(linker, solist_sym_name);
+    solinker = getStaticPointer<SoInfo>(addresses[kSolist]);
     if (solinker == nullptr)
       return false;
     LOGI("found symbol solist at %p", solinker);
@@ -141,24 +137,63 @@ bool Initialize() {
 
   SoInfo::get_realpath_sym =
       reinterpret_cast<decltype(SoInfo::get_realpath_sym)>(
-          linker.getSymbAddress("__dl__ZNK6soinfo12get_realpathEv"));
+          addresses[kGetRealpath]);
   if (SoInfo::get_realpath_sym != nullptr)
     LOGI("found symbol get_realpath_sym");
 
   g_module_unload_counter = reinterpret_cast<decltype(g_module_unload_counter)>(
-      linker.getSymbAddress("__dl__ZL23g_module_unload_counter"));
+      addresses[kModuleUnloadCounter]);
   if (g_module_unload_counter != nullptr)
     LOGI("found symbol g_module_unload_counter");
 
-  somain = getStaticPointer<SoInfo>(linker, somain_sym_name.data());
-  if (solinker == nullptr)
+  somain = getStaticPointer<SoInfo>(addresses[kSomain]);
+  if (somain == nullptr)
     return false;
   LOGI("found symbol somain at %p", somain);
 
-  return findHeuristicOffsets(linker.name());
+  std::string linker_name = linker->name();
+  Layout defaults = CurrentLayout(), cached;
+  if (LoadLayout(linker->buildId(), cached)) {
+    ApplyLayout(cached);
+    if (ProbeLayout(linker_name)) {
+      LOGI("cached soinfo layout confirmed");
+      return true;
+    }
+    LOGW("cached soinfo layout is stale");
+    ApplyLayout(defaults);
+  }
+
+  if (!findHeuristicOffsets(linker_name))
+    return false;
+  AllocatorModel model;
+  model.page_size = sysconf(_SC_PAGESIZE);
+  model.pool_size = 100 * model.page_size;
+  SoInfo::solist_size = InferBlockSize(Snapshot::Capture(solinker), model);
+  // Without two adjacent soinfos the size is unknown, and ProbeLayout() would
+  // accept the unknown size forever; derive it again on the next start.
+  if (SoInfo::solist_size != 0)
+    StoreLayout(linker->buildId(), CurrentLayout());
+  return true;
+}
+
+} // namespace
+
+Layout CurrentLayout() {
+  return {static_cast<uint32_t>(SoInfo::solist_next_offset),
+          static_cast<uint32_t>(SoInfo::solist_realpath_offset),
+          static_cast<uint32_t>(SoInfo::solist_name_offset),
+          static_cast<uint32_t>(SoInfo::solist_size)};
+}
+
+void ApplyLayout(const Layout &layout) {
+  SoInfo::solist_next_offset = layout.next_offset;
+  SoInfo::solist_realpath_offset = layout.realpath_offset;
+  SoInfo::solist_name_offset = layout.name_offset;
+  SoInfo::solist_size = layout.size;
 }
 
 bool findHeuristicOffsets(std::string linker_name) {
+  INSTRUMENT_SCOPE("findHeuristicOffsets");
   const size_t size_block_range = 1024;
   const size_t linker_realpath_size = linker_name.size();
 
@@ -174,6 +209,8 @@ bool findHeuristicOffsets(std::string linker_name) {
     if (realpath_of_solinker->size() == linker_realpath_size) {
       if (strcmp(linker_name.c_str(), realpath_of_solinker->c_str()) == 0) {
         SoInfo::solist_realpath_offset = i * sizeof(void *);
+        SoInfo::solist_name_offset =
+            SoInfo::solist_realpath_offset - sizeof(std::string);
         LOGI("heuristic field_realpath_offset is %zu * %zu = %p", i,
              sizeof(void *),
              reinterpret_cast<void *>(SoInfo::solist_realpath_offset));
@@ -0,0 +1,63 @@
+#include "detector.hpp"
+#include "logging.h"
+#include "solist.hpp"
+#include "solist_snapshot.hpp"
+#include <format>
+
+namespace {
+
+class SoInfoAnomalyDetector : public Detectors::Detector {
+public:
+  const char *name() const override { return "solist"; }
+
+  uint32_t inputs() const override {
+    return Detectors::kSoInfos | Detectors::kMaps;
+  }
+
+  Detectors::Finding Run(Detectors::Inputs &inputs) override {
+    Detectors::Finding finding{false, "No injection found using solist"};
+    auto &snapshot = inputs.soinfos();
+    if (snapshot.entries().empty())
+      return finding;
+
+    size_t suspicious = 0;
+    for (auto &anomaly : SoList::DetectAnomalies(snapshot, inputs.maps())) {
+      static constexpr const char *kKinds[] = {"empty path", "nameless",
+                                               "dropped", "isolated"};
+      static constexpr const char *kConfidences[] = {"low", "medium", "high"};
+      LOGE("Abnormal soinfo %p: %s, %zu block(s), %s confidence",
+           (void *)anomaly.address, kKinds[anomaly.kind], anomaly.blocks,
+           kConfidences[anomaly.confidence]);
+      // Holes of normal unloads are only logged.
+      if (anomaly.confidence == SoList::Anomaly::kLow)
+        continue;
+      if (suspicious++ == 0)
+        finding.summary =
+            std::format("Solist: injection at {}", (void *)anomaly.address);
+    }
+    if (suspicious > 1)
+      finding.summary += std::format(" and {} more", suspicious - 1);
+    finding.detected = suspicious > 0;
+    return finding;
+  }
+};
+
+class ModuleCounterDetector : public Detectors::Detector {
+public:
+  const char *name() const override { return "module counter"; }
+
+  uint32_t inputs() const override { return Detectors::kLinker; }
+
+  Detectors::Finding Run(Detectors::Inputs &inputs) override {
+    size_t module_injected = inputs.linker() ? SoList::DetectModules() : 0;
+    if (module_injected == 0)
+      return {false, "No injection found using module counter"};
+    return {true, std::format("Module counter: {} shared libraries unloaded",
+                              module_injected)};
+  }
+};
+
+} // namespace
+
+REGISTER_DETECTOR(SoInfoAnomalyDetector, 10);
+REGISTER_DETECTOR(ModuleCounterDetector, 30);
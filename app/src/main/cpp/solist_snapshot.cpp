@@ -0,0 +1,134 @@
+#include "solist_snapshot.hpp"
+#include "instrument.hpp"
+#include "logging.h"
+#include "solist.hpp"
+#include <cstddef>
+#include <cstring>
+
+namespace SoList {
+
+Snapshot Snapshot::Capture(SoInfo *head) {
+  INSTRUMENT_SCOPE("SoList walk");
+  Snapshot snapshot;
+  // Enough for the libraries of most apps, so the pass rarely reallocates.
+  snapshot.entries_.reserve(1024);
+  snapshot.strings_.reserve(1024 * 96);
+
+  ProtectedDataGuard guard;
+  for (SoInfo *iter = head;
+       iter != nullptr && snapshot.entries_.size() < kMaxEntries;) {
+    SoInfo *next = iter->get_next();
+    if (next != nullptr) {
+      // Both fields read from the next soinfo, fetched while the strings of
+      // this one are copied.
+      auto address = reinterpret_cast<const char *>(next);
+      __builtin_prefetch(address + SoInfo::solist_next_offset);
+      __builtin_prefetch(address + SoInfo::solist_name_offset);
+    }
+    snapshot.Append(reinterpret_cast<uintptr_t>(iter),
+                    reinterpret_cast<uintptr_t>(next), iter->get_path(),
+                    iter->get_name());
+    iter = next;
+  }
+  return snapshot;
+}
+
+void Snapshot::Append(uintptr_t address, uintptr_t next, const char *path,
+                      const char *name) {
+  uint32_t path_offset = AppendString(path);
+  entries_.push_back({address, next, path_offset, AppendString(name)});
+}
+
+uint32_t Snapshot::AppendString(const char *string) {
+  if (string == nullptr)
+    return kNull;
+  auto offset = static_cast<uint32_t>(strings_.size());
+  strings_.append(string, strlen(string) + 1);
+  return offset;
+}
+
+uintptr_t FindInjection(const Snapshot &snapshot) {
+  auto entries = snapshot.entries();
+  if (entries.empty())
+    return 0;
+  const Snapshot::Entry *prev = &entries.front();
+  ptrdiff_t gap = 0;
+  auto gap_repeated = 0;
+  bool app_process_loaded = false;
+  bool app_specialized = false;
+  const char *libraries_after_specialization[2] = {"libart.so",
+                                                   "libdexfile.so"};
+  bool nativehelper_loaded =
+      false; // Not necessarily loaded after AppSpecialize
+
+  for (auto &entry : entries) {
+    const char *path = snapshot.path(entry);
+    const char *name = snapshot.name(entry);
+    // No soinfo has empty path name
+    if (path == nullptr || path[0] == '\0') {
+      return entry.address;
+    }
+
+    if (name == nullptr && app_process_loaded) {
+      return entry.address;
+    }
+
+    if (name == nullptr && strstr(path, "/system/bin/app_proces")) {
+      app_process_loaded = true;
+      // /system/bin/app_process64 maybe set null name
+      LOGD("Skip %p: %s", reinterpret_cast<void *>(entry.address), path);
+      continue;
+    }
+
+    auto distance = static_cast<ptrdiff_t>(entry.address - prev->address);
+    if (distance != gap && gap_repeated < 1) {
+      gap = distance;
+      gap_repeated = 0;
+    } else if (distance == gap) {
+      LOGD("Skip soinfo %p: %s", reinterpret_cast<void *>(entry.address),
+           name);
+      gap_repeated++;
+    } else if (distance == 2 * gap) {
+      // A gap appears, indicating that one library was unloaded
+      uintptr_t dropped = prev->address + gap;
+
+      if (!nativehelper_loaded || !app_specialized) {
+        // gap cannot appear before libnativehelper is loaded
+        return dropped;
+      } else {
+        // gap may appear after any of these libraries is loaded
+        LOGW("%p is dropped between %s and %s",
+             reinterpret_cast<void *>(dropped), snapshot.path(*prev), path);
+      }
+    } else {
+      gap_repeated--;
+      if (gap != 0)
+        LOGI("Suspicious gap 0x%lx or 0x%lx != 0x%lx between %s and %s",
+             distance, -distance, gap, snapshot.name(*prev), name);
+    }
+
+    if (name == nullptr) {
+      prev = &entry;
+      continue;
+    }
+
+    if (!app_specialized) {
+      for (int i = 0; i < 2; i++) {
+        if (strcmp(name, libraries_after_specialization[i]) == 0) {
+          app_specialized = true;
+          break;
+        }
+      }
+    }
+
+    if (!nativehelper_loaded && strcmp(name, "libnativehelper.so") == 0) {
+      nativehelper_loaded = true;
+    }
+
+    prev = &entry;
+  }
+
+  return 0;
+}
+
+} // namespace SoList
@@ -0,0 +1,115 @@
+#include "symbol_index.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace SandHook {
+
+namespace {
+
+// The bucket of a hash is taken from the high bits of its product with an
+// odd constant, as the low bits of the GNU hash of similar names correlate.
+constexpr uint32_t Bucket(uint32_t hash, uint32_t shift) {
+  return static_cast<uint32_t>(static_cast<uint64_t>(hash * 0x9e3779b1u) >>
+                               shift);
+}
+
+} // namespace
+
+void SymbolIndex::Build(const ElfW(Sym) * symbols, size_t count,
+                        const char *strings) {
+  symbols_ = symbols;
+  strings_ = strings;
+  entries_.clear();
+  bucket_begin_.clear();
+  name_order_.clear();
+  if (symbols == nullptr || strings == nullptr)
+    return;
+
+  // Hashing dominates on long C++ names, so hash each name once.
+  size_t indexed = 0;
+  for (size_t i = 0; i < count; i++)
+    indexed += Indexed(symbols[i]);
+  std::vector<uint32_t> hashes;
+  hashes.reserve(indexed);
+  for (size_t i = 0; i < count; i++) {
+    if (Indexed(symbols[i]))
+      hashes.push_back(Hash(strings + symbols[i].st_name));
+  }
+  // About one symbol per bucket.
+  uint32_t bits = 0;
+  while ((size_t{1} << bits) < hashes.size())
+    bits++;
+  bucket_shift_ = 32 - bits;
+
+  // Counting sort by bucket, which keeps table order within a bucket so
+  // duplicate names resolve to the first symbol.
+  bucket_begin_.assign((size_t{1} << bits) + 1, 0);
+  for (uint32_t hash : hashes)
+    bucket_begin_[Bucket(hash, bucket_shift_) + 1]++;
+  for (size_t b = 1; b < bucket_begin_.size(); b++)
+    bucket_begin_[b] += bucket_begin_[b - 1];
+  entries_.resize(hashes.size());
+  // bucket_begin_[b] is now the start of bucket b, and serves as its next
+  // free slot while scattering.
+  for (size_t i = 0, k = 0; i < count; i++) {
+    if (!Indexed(symbols[i]))
+      continue;
+    uint32_t hash = hashes[k++];
+    entries_[bucket_begin_[Bucket(hash, bucket_shift_)]++] = {
+        hash, static_cast<uint32_t>(symbols[i].st_name),
+        static_cast<uint32_t>(i)};
+  }
+  // Scattering advanced every bucket to the start of the next one.
+  for (size_t b = bucket_begin_.size() - 1; b > 0; b--)
+    bucket_begin_[b] = bucket_begin_[b - 1];
+  bucket_begin_[0] = 0;
+}
+
+const ElfW(Sym) * SymbolIndex::Find(std::string_view name,
+                                    uint32_t hash) const {
+  if (entries_.empty())
+    return nullptr;
+  uint32_t bucket = Bucket(hash, bucket_shift_);
+  for (uint32_t i = bucket_begin_[bucket]; i < bucket_begin_[bucket + 1];
+       i++) {
+    const Entry &entry = entries_[i];
+    if (entry.hash != hash)
+      continue;
+    const char *candidate = strings_ + entry.name;
+    if (strncmp(candidate, name.data(), name.size()) == 0 &&
+        candidate[name.size()] == '\0')
+      return symbols_ + entry.symbol;
+  }
+  return nullptr;
+}
+
+void SymbolIndex::BuildNameOrder() {
+  name_order_.resize(entries_.size());
+  for (size_t i = 0; i < entries_.size(); i++)
+    name_order_[i] = entries_[i].symbol;
+  std::sort(name_order_.begin(), name_order_.end(),
+            [this](uint32_t a, uint32_t b) {
+              int order = strcmp(strings_ + symbols_[a].st_name,
+                                 strings_ + symbols_[b].st_name);
+              return order != 0 ? order < 0 : a < b;
+            });
+}
+
+std::span<const uint32_t>
+SymbolIndex::FindPrefix(std::string_view prefix) const {
+  // Comparing only the first prefix.size() bytes of each name keeps the
+  // order, so the matches are one contiguous range.
+  auto compare = [&](uint32_t symbol) {
+    return strncmp(strings_ + symbols_[symbol].st_name, prefix.data(),
+                   prefix.size());
+  };
+  auto begin = std::partition_point(
+      name_order_.begin(), name_order_.end(),
+      [&](uint32_t symbol) { return compare(symbol) < 0; });
+  auto end = std::partition_point(
+      begin, name_order_.end(),
+      [&](uint32_t symbol) { return compare(symbol) == 0; });
+  return {begin, end};
+}
+
+} // namespace SandHook
@@ -1,151 +1,513 @@
 #include "vmap.hpp"
+#include "inode_cache.hpp"
+#include "instrument.hpp"
+#include "map_snapshot.hpp"
 #include "logging.h"
-#include <cinttypes>
+#include "printable.hpp"
+#include <algorithm>
 #include <cstring>
 #include <sys/mman.h>
-#include <sys/stat.h>
 #include <sys/sysmacros.h>
 #include <vector>
 
 namespace VirtualMap {
 
-void logPossibleStrings(const char *start, size_t size,
-                        size_t min_string_length = 4) {
-  const char *end = start + size;
-  const char *ptr = start;
+namespace {
 
-  LOGD("--- Starting String Dump (min length: %zu, range size: %zu) ---",
-       min_string_length, size);
+constexpr std::string_view kStackSignatures[] = {
+    "zygisk",   "magisk", "riru",    "lsposed", "xposed",
+    "frida",    "gum-js-loop",       "/data/adb/",
+    "kernelsu", "apatch", "shamiko", "dobby",   "substrate"};
 
-  while (ptr < end) {
-    // Find the beginning of a potential string (a printable character)
-    if (isprint(static_cast<unsigned char>(*ptr))) {
-      const char *string_start = ptr;
-      const char *string_end = ptr + 1;
+template <typename Map> bool IsMainStack(const Map &map) {
+  return map.dev == 0 && map.inode == 0 && map.offset == 0 &&
+         (map.path == "[anon:stack_and_tls:main]" || map.path == "[stack]");
+}
 
-      // Find the end of the sequence of printable characters
-      while (string_end < end &&
-             isprint(static_cast<unsigned char>(*string_end))) {
-        string_end++;
-      }
+// Finds the stack of the main thread, which is where the injected code
+// usually runs during app specialization.
+bool FindMainStack(const char *&start, size_t &size) {
+  return !MapInfo::ForEach([&](const MapEntry &map) {
+    if (IsMainStack(map)) {
+      start = reinterpret_cast<const char *>(map.start);
+      size = map.end - map.start;
+      return false;
+    }
+    return true;
+  });
+}
+
+bool FindMainStack(std::span<const MapRegion> maps, const char *&start,
+                   size_t &size) {
+  for (auto &map : maps) {
+    if (IsMainStack(map)) {
+      start = reinterpret_cast<const char *>(map.start);
+      size = map.end - map.start;
+      return true;
+    }
+  }
+  return false;
+}
 
-      size_t length = string_end - string_start;
+// Remembers the distinct strings of one scan, by content.
+class RunSet {
+public:
+  void Reset(const char *base) {
+    base_ = base;
+    used_ = 0;
+    std::fill(slots_.begin(), slots_.end(), Printable::Run{0, 0});
+  }
 
-      // If the sequence meets our minimum length, log it
-      if (length >= min_string_length) {
-        // Safely create a std::string from the non-null-terminated segment
-        std::string found_str(string_start, length);
+  // Returns false if an equal string was inserted before.
+  bool Insert(const Printable::Run &run) {
+    if ((used_ + 1) * 2 > slots_.size())
+      Grow();
+    return Place(run);
+  }
 
-        // Log the string and its memory offset using LOGD's format string
-        LOGI("Offset 0x%zx: \"%s\"", (size_t)(string_start - start),
-             found_str.c_str());
+private:
+  uint64_t Hash(const Printable::Run &run) const {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (size_t i = 0; i < run.length; i++)
+      hash = (hash ^ static_cast<unsigned char>(base_[run.offset + i])) *
+             0x100000001b3ULL;
+    return hash;
+  }
+
+  bool Place(const Printable::Run &run) {
+    size_t mask = slots_.size() - 1;
+    for (size_t slot = Hash(run) & mask;; slot = (slot + 1) & mask) {
+      auto &entry = slots_[slot];
+      if (entry.length == 0) {
+        entry = run;
+        used_++;
+        return true;
       }
+      if (entry.length == run.length &&
+          memcmp(base_ + entry.offset, base_ + run.offset, run.length) == 0)
+        return false;
+    }
+  }
 
-      // Advance the main pointer past the sequence we just processed
-      ptr = string_end;
-    } else {
-      // Not a printable character, just move to the next byte
-      ptr++;
+  void Grow() {
+    std::vector<Printable::Run> old(std::max<size_t>(slots_.size() * 2, 1024),
+                                    Printable::Run{0, 0});
+    old.swap(slots_);
+    used_ = 0;
+    for (auto &run : old) {
+      if (run.length != 0)
+        Place(run);
     }
   }
-  LOGD("--- Finished String Dump ---");
+
+  const char *base_ = nullptr;
+  std::vector<Printable::Run> slots_;
+  size_t used_ = 0;
+};
+
+} // namespace
+
+std::span<const std::string_view> StackSignatures() {
+  return kStackSignatures;
 }
 
-void DumpStackStrings() {
-  for (auto &map : MapInfo::Scan()) {
-    if (map.dev == 0 && map.inode == 0 && map.offset == 0 &&
-        map.path == "[anon:stack_and_tls:main]") {
-      logPossibleStrings(reinterpret_cast<const char *>(map.start),
-                         map.end - map.start, 3);
+namespace {
+
+std::vector<StackHit> ScanStack(const char *start, size_t size,
+                                const Matcher::AhoCorasick &signatures,
+                                size_t min_string_length) {
+  std::vector<StackHit> hits;
+  RunSet seen;
+  seen.Reset(start);
+  size_t strings = 0;
+  size_t distinct = 0;
+  Printable::Run runs[256];
+  Printable::RunFinder finder(start, size, min_string_length);
+  while (size_t count = finder.Next(runs)) {
+    strings += count;
+    for (size_t i = 0; i < count; i++) {
+      if (!seen.Insert(runs[i]))
+        continue;
+      distinct++;
+      size_t first = hits.size();
+      signatures.Scan({start + runs[i].offset, runs[i].length},
+                      [&](uint32_t signature, size_t) {
+                        for (size_t k = first; k < hits.size(); k++) {
+                          if (hits[k].signature == signature)
+                            return true;
+                        }
+                        hits.push_back({signature, runs[i].offset,
+                                        runs[i].length});
+                        return true;
+                      });
     }
   }
+  LOGD("Stack strings: %zu found, %zu distinct, %zu signature hits", strings,
+       distinct, hits.size());
+  return hits;
 }
 
-MapInfo *DetectInjection() {
-  int jit_cache_count = 0;
-  int jit_zygote_cache_count = 0;
+const Matcher::AhoCorasick &DefaultSignatures() {
+  static const Matcher::AhoCorasick signatures(kStackSignatures, true);
+  return signatures;
+}
 
-  for (auto &info : MapInfo::Scan()) {
-    if (info.perms & PROT_EXEC) {
-      // Executable memory blocks are suspicious
-      if (info.path == "[vdso]")
-        continue;
+} // namespace
 
-      if (!info.path.starts_with("/")) {
-        LOGI("Executable block with path %s", info.path.data());
-        return &info;
-      }
+std::vector<StackHit> ScanStackStrings(const Matcher::AhoCorasick &signatures,
+                                       size_t min_string_length) {
+  const char *start;
+  size_t size;
+  if (!FindMainStack(start, size))
+    return {};
+  return ScanStack(start, size, signatures, min_string_length);
+}
 
-      if (info.path.starts_with("/dev/zero")) {
-        LOGI("Shared anonymous executable block found");
-        return &info;
-      }
+std::vector<StackHit> ScanStackStrings() {
+  return ScanStackStrings(DefaultSignatures());
+}
 
-      if (info.path.starts_with("/memfd:jit-cache")) {
-        jit_cache_count++;
-      } else if (info.path.starts_with("/memfd:jit-zygote-cache")) {
-        jit_zygote_cache_count++;
-      } else {
-        LOGD("Checking inode for %s", info.path.c_str());
-        struct stat sb_buf;
-        if (stat(info.path.data(), &sb_buf) != 0 ||
-            sb_buf.st_ino != info.inode) {
-          LOGI("Executable block with inconsistent inode %s", info.path.data());
-          return &info;
-        }
-      }
+std::vector<StackHit> ScanStackStrings(std::span<const MapRegion> maps) {
+  const char *start;
+  size_t size;
+  if (!FindMainStack(maps, start, size))
+    return {};
+  return ScanStack(start, size, DefaultSignatures(), 3);
+}
+
+void DumpStackStrings(size_t byte_budget, size_t min_string_length) {
+  const char *start;
+  size_t size;
+  if (!FindMainStack(start, size))
+    return;
+  LOGD("--- Starting String Dump (min length: %zu, range size: %zu, %s) ---",
+       min_string_length, size,
+       Printable::KernelName(Printable::Kernel::kAuto));
 
-      if (jit_cache_count > 1 || jit_zygote_cache_count > 1) {
-        LOGI("Futile renaming to jit blocks");
-        return &info;
+  Printable::Run runs[256];
+  Printable::RunFinder finder(start, size, min_string_length);
+  while (size_t count = finder.Next(runs)) {
+    for (size_t i = 0; i < count; i++) {
+      if (runs[i].length > byte_budget) {
+        LOGD("--- String Dump stopped at offset 0x%zx: budget exhausted ---",
+             runs[i].offset);
+        return;
       }
+      byte_budget -= runs[i].length;
+      // Log the string and its memory offset; runs are not null-terminated
+      LOGI("Offset 0x%zx: \"%.*s\"", runs[i].offset, (int)runs[i].length,
+           start + runs[i].offset);
     }
   }
+  LOGD("--- Finished String Dump ---");
+}
+
+namespace {
+
+enum JitRegion { kNotJit, kJitCache, kJitZygoteCache, kJitRegionKinds };
+
+JitRegion ClassifyJit(std::string_view path) {
+  if (path.starts_with("/memfd:jit-cache"))
+    return kJitCache;
+  if (path.starts_with("/memfd:jit-zygote-cache"))
+    return kJitZygoteCache;
+  return kNotJit;
+}
+
+// Returns why an executable region is suspicious without touching the file
+// system, or nullptr if it passes these checks.
+const char *CheckExecutableRegion(const MapRegion &info) {
+  if (info.path == "[vdso]")
+    return nullptr;
+
+  if (!info.path.starts_with("/")) {
+    LOGI("Executable block with path %.*s", (int)info.path.size(),
+         info.path.data());
+    return "executable block without file";
+  }
 
+  if (info.path.starts_with("/dev/zero")) {
+    LOGI("Shared anonymous executable block found");
+    return "shared anonymous executable block";
+  }
   return nullptr;
 }
 
-std::vector<MapInfo> MapInfo::Scan() {
-  constexpr static auto kPermLength = 5;
-  constexpr static auto kMapEntry = 7;
-  std::vector<MapInfo> info;
-  auto maps = std::unique_ptr<FILE, decltype(&fclose)>{
-      fopen("/proc/self/maps", "r"), &fclose};
-  if (maps) {
-    char *line = nullptr;
-    size_t len = 0;
-    ssize_t read;
-    while ((read = getline(&line, &len, maps.get())) > 0) {
-      line[read - 1] = '\0';
-      uintptr_t start = 0;
-      uintptr_t end = 0;
-      uintptr_t off = 0;
-      ino_t inode = 0;
-      unsigned int dev_major = 0;
-      unsigned int dev_minor = 0;
-      std::array<char, kPermLength> perm{'\0'};
-      int path_off;
-      if (sscanf(line,
-                 "%" PRIxPTR "-%" PRIxPTR " %4s %" PRIxPTR " %x:%x %lu %n%*s",
-                 &start, &end, perm.data(), &off, &dev_major, &dev_minor,
-                 &inode, &path_off) != kMapEntry) {
+// Executable file mappings are verified against the inode of their path.
+bool NeedsInodeCheck(const MapRegion &info) {
+  return info.path.starts_with("/") && !info.path.starts_with("/dev/zero") &&
+         ClassifyJit(info.path) == kNotJit;
+}
+
+// Persistent state of DetectInjection(), created on first use.
+struct InjectionState {
+  explicit InjectionState(ProcFs::Source maps = "/proc/self/maps")
+      : snapshot(maps) {}
+
+  MapSnapshot snapshot;
+  MapDelta delta;
+  InodeCache inode_cache;
+  std::vector<std::pair<MapRegion *, const InodeCache::Entry *>> inode_checks;
+  size_t jit_counts[kJitRegionKinds] = {};
+  size_t suspicious = 0;
+  // Generation of the snapshot whose delta was last checked.
+  size_t checked = 0;
+
+  void Forget(const MapRegion &region) {
+    if (region.verdict != nullptr)
+      suspicious--;
+    if ((region.perms & PROT_EXEC) == 0)
+      return;
+    jit_counts[ClassifyJit(region.path)]--;
+    if (NeedsInodeCheck(region))
+      inode_cache.Release(region.dev, region.inode, region.path);
+  }
+
+  // Entries are only checked again when the mount table changes, so the
+  // regions that passed go through the check once more.
+  void RecheckInodes() {
+    for (auto &region : snapshot.regions()) {
+      if ((region.perms & PROT_EXEC) == 0 || region.verdict != nullptr ||
+          !NeedsInodeCheck(region))
         continue;
+      if (auto *entry =
+              inode_cache.Find(region.dev, region.inode, region.path))
+        inode_checks.emplace_back(&region, entry);
+    }
+  }
+
+  void Verify(MapRegion &region) {
+    // Executable memory blocks are suspicious
+    if ((region.perms & PROT_EXEC) == 0)
+      return;
+    jit_counts[ClassifyJit(region.path)]++;
+    region.verdict = CheckExecutableRegion(region);
+    if (region.verdict != nullptr) {
+      suspicious++;
+    } else if (NeedsInodeCheck(region)) {
+      inode_checks.emplace_back(
+          &region, inode_cache.Acquire(region.dev, region.inode, region.path));
+    }
+  }
+};
+
+InjectionState &GetInjectionState() {
+  static InjectionState state;
+  return state;
+}
+
+void ResolveInodeChecks(InjectionState &state);
+
+void CheckDelta(InjectionState &state) {
+  auto &snapshot = state.snapshot;
+  auto &delta = state.delta;
+  LOGD("Maps refresh %zu: %zu added, %zu removed, %zu changed",
+       snapshot.generation(), delta.added.size(), delta.removed.size(),
+       delta.changed.size());
+
+  for (auto *region : delta.removed)
+    state.Forget(*region);
+  for (auto [previous, current] : delta.changed) {
+    state.Forget(*previous);
+    state.Verify(*current);
+  }
+  for (auto *region : delta.added)
+    state.Verify(*region);
+
+  ResolveInodeChecks(state);
+}
+
+void ResolveInodeChecks(InjectionState &state) {
+  state.inode_cache.Flush();
+  for (auto [region, entry] : state.inode_checks) {
+    if (entry->state == InodeCache::State::kInconsistent) {
+      LOGI("Executable block with inconsistent inode %.*s",
+           (int)region->path.size(), region->path.data());
+      region->verdict = "executable block with inconsistent inode";
+      state.suspicious++;
+    }
+  }
+  state.inode_checks.clear();
+  auto &stats = state.inode_cache.stats();
+  LOGD("Inode checks: %zu syscalls for %zu lookups, %zu files cached",
+       stats.syscalls(), stats.lookups, state.inode_cache.size());
+}
+
+std::optional<Detection> Report(InjectionState &state) {
+  auto &snapshot = state.snapshot;
+  if (state.suspicious > 0) {
+    for (auto &region : snapshot.regions()) {
+      if (region.verdict != nullptr)
+        return Detection{region.ToOwned(), region.verdict};
+    }
+  }
+
+  for (auto kind : {kJitCache, kJitZygoteCache}) {
+    if (state.jit_counts[kind] <= 1)
+      continue;
+    LOGI("Futile renaming to jit blocks");
+    bool seen = false;
+    for (auto &region : snapshot.regions()) {
+      if ((region.perms & PROT_EXEC) && ClassifyJit(region.path) == kind) {
+        if (seen)
+          return Detection{region.ToOwned(), "futile renaming to jit blocks"};
+        seen = true;
       }
-      while (path_off < read && isspace(line[path_off]))
-        path_off++;
-      auto &ref = info.emplace_back(
-          MapInfo{start, end, 0, perm[3] == 'p', off,
-                  static_cast<dev_t>(makedev(dev_major, dev_minor)), inode,
-                  line + path_off});
-      if (perm[0] == 'r')
-        ref.perms |= PROT_READ;
-      if (perm[1] == 'w')
-        ref.perms |= PROT_WRITE;
-      if (perm[2] == 'x')
-        ref.perms |= PROT_EXEC;
     }
-    free(line);
   }
+
+  return std::nullopt;
+}
+
+} // namespace
+
+const InodeCache::Stats &InodeCheckStats() {
+  return GetInjectionState().inode_cache.stats();
+}
+
+bool RefreshMaps() {
+  INSTRUMENT_SCOPE("RefreshMaps");
+  auto &state = GetInjectionState();
+  // The counters are kept by the deltas, so none may go unchecked.
+  if (state.snapshot.generation() != state.checked) {
+    state.checked = state.snapshot.generation();
+    CheckDelta(state);
+  }
+  return state.snapshot.Refresh(state.delta);
+}
+
+std::span<const MapRegion> Maps() {
+  return GetInjectionState().snapshot.regions();
+}
+
+std::optional<Detection> DetectInjection() {
+  if (!RefreshMaps())
+    return std::nullopt;
+  return CheckMaps();
+}
+
+std::optional<Detection> DetectInjection(ProcFs::Source maps) {
+  InjectionState state(maps);
+  if (!state.snapshot.Refresh(state.delta))
+    return std::nullopt;
+  CheckDelta(state);
+  return Report(state);
+}
+
+// Only the regions that changed since the previous refresh are checked; the
+// verdicts and JIT counters of the others are carried over by the snapshot.
+// Their inodes are checked again when the mount table changes.
+std::optional<Detection> CheckMaps() {
+  auto &state = GetInjectionState();
+  bool remounted = state.inode_cache.InvalidateOnMountChange();
+  if (state.snapshot.generation() != state.checked) {
+    state.checked = state.snapshot.generation();
+    CheckDelta(state);
+  }
+  if (remounted) {
+    LOGD("Mount table changed, checking every inode again");
+    state.RecheckInodes();
+    ResolveInodeChecks(state);
+  }
+  return Report(state);
+}
+
+namespace {
+
+template <typename T>
+inline bool ParseHex(const char *&p, const char *end, T &out) {
+  const char *begin = p;
+  T value = 0;
+  for (; p < end; p++) {
+    unsigned c = static_cast<unsigned char>(*p);
+    unsigned digit = c - '0';
+    if (digit >= 10) {
+      digit = (c | 0x20) - 'a' + 10;
+      if (digit - 10 >= 6)
+        break;
+    }
+    value = (value << 4) | digit;
+  }
+  out = value;
+  return p != begin;
+}
+
+template <typename T>
+inline bool ParseDec(const char *&p, const char *end, T &out) {
+  const char *begin = p;
+  T value = 0;
+  for (; p < end && static_cast<unsigned char>(*p - '0') < 10u; p++)
+    value = value * 10 + (*p - '0');
+  out = value;
+  return p != begin;
+}
+
+inline bool Expect(const char *&p, const char *end, char c) {
+  if (p == end || *p != c)
+    return false;
+  p++;
+  return true;
+}
+
+inline void SkipSpaces(const char *&p, const char *end) {
+  while (p < end && (*p == ' ' || *p == '\t'))
+    p++;
+}
+
+} // namespace
+
+// Line format, as printed by show_map_vma() in fs/proc/task_mmu.c:
+// start-end perms offset major:minor inode    path
+bool ParseMapsLine(std::string_view line, MapEntry &entry) {
+  const char *p = line.data();
+  const char *end = p + line.size();
+  unsigned int dev_major = 0;
+  unsigned int dev_minor = 0;
+
+  if (!ParseHex(p, end, entry.start) || !Expect(p, end, '-') ||
+      !ParseHex(p, end, entry.end) || !Expect(p, end, ' '))
+    return false;
+
+  if (end - p < 5 || p[4] != ' ')
+    return false;
+  entry.perms = 0;
+  if (p[0] == 'r')
+    entry.perms |= PROT_READ;
+  if (p[1] == 'w')
+    entry.perms |= PROT_WRITE;
+  if (p[2] == 'x')
+    entry.perms |= PROT_EXEC;
+  entry.is_private = p[3] == 'p';
+  p += 5;
+
+  if (!ParseHex(p, end, entry.offset) || !Expect(p, end, ' ') ||
+      !ParseHex(p, end, dev_major) || !Expect(p, end, ':') ||
+      !ParseHex(p, end, dev_minor) || !Expect(p, end, ' ') ||
+      !ParseDec(p, end, entry.inode))
+    return false;
+  entry.dev = static_cast<dev_t>(makedev(dev_major, dev_minor));
+
+  SkipSpaces(p, end);
+  entry.path = {p, static_cast<size_t>(end - p)};
+  return true;
+}
+
+bool MapsScanner::Next(MapEntry &entry) {
+  std::string_view line;
+  while (reader_.Next(line)) {
+    if (ParseMapsLine(line, entry))
+      return true;
+  }
+  return false;
+}
+
+std::vector<MapInfo> MapInfo::Scan(ProcFs::Source maps) {
+  INSTRUMENT_SCOPE("MapInfo::Scan");
+  std::vector<MapInfo> info;
+  MapsScanner scanner(maps);
+  MapEntry entry;
+  while (scanner.Next(entry))
+    info.emplace_back(entry.ToOwned());
   return info;
 }
 
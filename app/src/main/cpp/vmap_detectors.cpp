@@ -0,0 +1,69 @@
+#include "detector.hpp"
+#include "logging.h"
+#include "map_snapshot.hpp"
+#include "vmap.hpp"
+#include <string>
+
+namespace {
+
+class MapsDetector : public Detectors::Detector {
+public:
+  const char *name() const override { return "virtual map"; }
+
+  uint32_t inputs() const override { return Detectors::kMaps; }
+
+  Detectors::Finding Run(Detectors::Inputs &inputs) override {
+    Detectors::Finding finding{false, "No injection found using vitrual map"};
+    if (inputs.maps().empty())
+      return finding;
+    auto abnormal_vmap = VirtualMap::CheckMaps();
+    if (abnormal_vmap) {
+      auto &region = abnormal_vmap->region;
+      finding = {true, "Virtual map: injection at " + region.path};
+      LOGE("Abnormal vmap %s: [0x%lx-0x%lx], %s", region.path.data(),
+           region.start, region.end, abnormal_vmap->reason);
+    }
+    return finding;
+  }
+};
+
+// Reads the same snapshot as MapsDetector, which only writes the verdicts of
+// its regions.
+class StackStringsDetector : public Detectors::Detector {
+public:
+  const char *name() const override { return "stack strings"; }
+
+  uint32_t inputs() const override { return Detectors::kMaps; }
+
+  // Reads the whole main thread stack.
+  bool cheap() const override { return false; }
+
+  Detectors::Finding Run(Detectors::Inputs &inputs) override {
+    Detectors::Finding finding{false, "No injector strings found on stack"};
+    auto stack_hits = VirtualMap::ScanStackStrings(inputs.maps());
+#ifdef DEMO_DUMP_STACK_STRINGS
+    VirtualMap::DumpStackStrings(64 * 1024);
+#endif
+    if (stack_hits.empty())
+      return finding;
+
+    auto signatures = VirtualMap::StackSignatures();
+    std::vector<bool> reported(signatures.size());
+    finding = {true, "Stack strings:"};
+    for (auto &hit : stack_hits) {
+      if (!reported[hit.signature]) {
+        reported[hit.signature] = true;
+        finding.summary += ' ';
+        finding.summary += signatures[hit.signature];
+      }
+      LOGE("Stack string at offset 0x%zx matches %s", hit.offset,
+           signatures[hit.signature].data());
+    }
+    return finding;
+  }
+};
+
+} // namespace
+
+REGISTER_DETECTOR(MapsDetector, 20);
+REGISTER_DETECTOR(StackStringsDetector, 40);
@@ -0,0 +1,556 @@
+#include "xz.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+namespace SandHook::Xz {
+
+namespace {
+
+constexpr uint8_t kHeaderMagic[6] = {0xFD, '7', 'z', 'X', 'Z', 0x00};
+constexpr uint8_t kFooterMagic[2] = {'Y', 'Z'};
+constexpr size_t kStreamHeaderSize = 12;
+constexpr uint64_t kFilterLzma2 = 0x21;
+constexpr uint8_t kCheckCrc32 = 1;
+constexpr uint8_t kCheckCrc64 = 4;
+// Bytes of the check of each check type.
+constexpr uint8_t kCheckSizes[16] = {0,  4,  4,  4,  8,  8,  8,  16,
+                                     16, 16, 32, 32, 32, 64, 64, 64};
+
+template <typename T, T kPolynomial>
+constexpr std::array<T, 256> kCrcTable = [] {
+  std::array<T, 256> table{};
+  for (uint32_t i = 0; i < 256; i++) {
+    T crc = i;
+    for (int bit = 0; bit < 8; bit++)
+      crc = crc & 1 ? (crc >> 1) ^ kPolynomial : crc >> 1;
+    table[i] = crc;
+  }
+  return table;
+}();
+
+template <typename T, T kPolynomial> T Crc(const uint8_t *data, size_t size) {
+  T crc = ~T{0};
+  for (size_t i = 0; i < size; i++)
+    crc = kCrcTable<T, kPolynomial>[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+  return ~crc;
+}
+
+uint32_t Crc32(const uint8_t *data, size_t size) {
+  return Crc<uint32_t, 0xEDB88320>(data, size);
+}
+
+uint64_t Crc64(const uint8_t *data, size_t size) {
+  return Crc<uint64_t, 0xC96C5795D7870F42>(data, size);
+}
+
+uint32_t Le32(const uint8_t *p) {
+  return p[0] | p[1] << 8 | p[2] << 16 | uint32_t(p[3]) << 24;
+}
+
+uint64_t Le64(const uint8_t *p) {
+  return Le32(p) | uint64_t(Le32(p + 4)) << 32;
+}
+
+uint32_t Be16(const uint8_t *p) { return p[0] << 8 | p[1]; }
+
+// The fields of the container, read in order.
+struct Input {
+  const uint8_t *data;
+  size_t size;
+  size_t pos = 0;
+
+  bool Has(size_t n) const { return size - pos >= n; }
+
+  const uint8_t *at() const { return data + pos; }
+
+  bool Byte(uint8_t &byte) {
+    if (!Has(1))
+      return false;
+    byte = data[pos++];
+    return true;
+  }
+
+  // A variable-length integer: 7 bits a byte, the low ones first, in at
+  // most 9 bytes and without trailing zeroes.
+  bool Vli(uint64_t &value) {
+    value = 0;
+    for (int i = 0; i < 9; i++) {
+      uint8_t byte;
+      if (!Byte(byte))
+        return false;
+      value |= uint64_t(byte & 0x7F) << (7 * i);
+      if ((byte & 0x80) == 0)
+        return byte != 0 || i == 0;
+    }
+    return false;
+  }
+
+  // Zeroes up to a multiple of 4 bytes from \p start.
+  bool Padding(size_t start) {
+    for (uint8_t byte; (pos - start) % 4 != 0;) {
+      if (!Byte(byte) || byte != 0)
+        return false;
+    }
+    return true;
+  }
+};
+
+constexpr int kStates = 12;
+// States after a literal, in which the next literal is not matched.
+constexpr uint32_t kLiteralStates = 7;
+constexpr int kPosStatesMax = 1 << 4;
+constexpr int kDistStates = 4;
+constexpr int kDistSlots = 64;
+constexpr uint32_t kDistModelStart = 4;
+constexpr uint32_t kDistModelEnd = 14;
+constexpr int kFullDistances = 1 << (kDistModelEnd / 2);
+constexpr int kAlignBits = 4;
+constexpr uint32_t kMatchLenMin = 2;
+constexpr int kLiteralCoderSize = 0x300;
+// LZMA2 limits lc + lp to 4.
+constexpr int kLiteralCodersMax = 1 << 4;
+
+using Prob = uint16_t;
+
+constexpr int kProbBits = 11;
+constexpr Prob kProbInit = 1 << (kProbBits - 1);
+constexpr int kMoveBits = 5;
+
+struct LengthProbs {
+  Prob choice;
+  Prob choice2;
+  Prob low[kPosStatesMax][1 << 3];
+  Prob mid[kPosStatesMax][1 << 3];
+  Prob high[1 << 8];
+};
+
+struct Probs {
+  Prob is_match[kStates][kPosStatesMax];
+  Prob is_rep[kStates];
+  Prob is_rep0[kStates];
+  Prob is_rep1[kStates];
+  Prob is_rep2[kStates];
+  Prob is_rep0_long[kStates][kPosStatesMax];
+  Prob dist_slot[kDistStates][kDistSlots];
+  Prob dist_special[kFullDistances - kDistModelEnd];
+  Prob dist_align[1 << kAlignBits];
+  LengthProbs match_len;
+  LengthProbs rep_len;
+  Prob literal[kLiteralCoderSize * kLiteralCodersMax];
+};
+static_assert(sizeof(Probs) % sizeof(Prob) == 0);
+
+// The range decoder of one LZMA chunk. Reading past the chunk yields zeroes
+// and fails Finished(), so the decoder need not check every bit.
+class RangeDecoder {
+public:
+  bool Reset(const uint8_t *in, size_t size) {
+    if (size < 5 || in[0] != 0)
+      return false;
+    range_ = UINT32_MAX;
+    code_ = uint32_t(in[1]) << 24 | in[2] << 16 | in[3] << 8 | in[4];
+    next_ = in + 5;
+    end_ = in + size;
+    overrun_ = false;
+    return true;
+  }
+
+  // Whether the chunk was read to its end, where the encoder flushed.
+  bool Finished() {
+    Normalize();
+    return !overrun_ && next_ == end_ && code_ == 0;
+  }
+
+  uint32_t Bit(Prob &prob) {
+    Normalize();
+    uint32_t bound = (range_ >> kProbBits) * prob;
+    if (code_ < bound) {
+      range_ = bound;
+      prob += ((1 << kProbBits) - prob) >> kMoveBits;
+      return 0;
+    }
+    range_ -= bound;
+    code_ -= bound;
+    prob -= prob >> kMoveBits;
+    return 1;
+  }
+
+  // The \p bits bits of a tree of probabilities, the highest first.
+  uint32_t Tree(Prob *probs, int bits) {
+    uint32_t symbol = 1;
+    for (int i = 0; i < bits; i++)
+      symbol = symbol << 1 | Bit(probs[symbol]);
+    return symbol - (1u << bits);
+  }
+
+  // The same, the lowest bit first.
+  uint32_t ReverseTree(Prob *probs, int bits) {
+    uint32_t symbol = 1, value = 0;
+    for (int i = 0; i < bits; i++) {
+      uint32_t bit = Bit(probs[symbol]);
+      symbol = symbol << 1 | bit;
+      value |= bit << i;
+    }
+    return value;
+  }
+
+  // Bits of probability one half.
+  uint32_t Direct(int bits) {
+    uint32_t value = 0;
+    for (int i = 0; i < bits; i++) {
+      Normalize();
+      range_ >>= 1;
+      code_ -= range_;
+      uint32_t mask = 0u - (code_ >> 31);
+      code_ += range_ & mask;
+      value = (value << 1) + (mask + 1);
+    }
+    return value;
+  }
+
+private:
+  void Normalize() {
+    if (range_ >= 1u << 24)
+      return;
+    range_ <<= 8;
+    code_ = code_ << 8 | (next_ != end_ ? *next_++ : Overrun());
+  }
+
+  uint8_t Overrun() {
+    overrun_ = true;
+    return 0;
+  }
+
+  uint32_t range_ = 0;
+  uint32_t code_ = 0;
+  const uint8_t *next_ = nullptr;
+  const uint8_t *end_ = nullptr;
+  bool overrun_ = false;
+};
+
+// Decodes the LZMA2 data of blocks. The output of a block is its
+// dictionary, so matches copy from it directly.
+class Lzma2Decoder {
+public:
+  // Decodes the chunks of one block up to its end marker.
+  bool Decode(Input &in, std::vector<char> &out);
+
+private:
+  bool SetProperties(uint8_t properties);
+  void ResetState();
+  bool DecodeLzma(uint8_t *out, size_t pos, size_t end);
+  uint32_t DecodeLength(LengthProbs &probs, uint32_t pos_state);
+  uint32_t DecodeDistance(uint32_t length);
+
+  Probs probs_;
+  RangeDecoder rc_;
+  uint32_t state_ = 0;
+  uint32_t reps_[4] = {};
+  uint32_t lc_ = 0;
+  uint32_t lp_ = 0;
+  uint32_t pb_ = 0;
+  // Where the dictionary was last reset in the output.
+  size_t dict_start_ = 0;
+};
+
+bool Lzma2Decoder::Decode(Input &in, std::vector<char> &out) {
+  bool need_dict_reset = true, need_properties = true;
+  for (;;) {
+    uint8_t control;
+    if (!in.Byte(control))
+      return false;
+    if (control == 0x00)
+      return true;
+    if (control >= 0xE0 || control == 0x01) {
+      need_dict_reset = false;
+      // The state left by the previous dictionary must not reach into the
+      // new one.
+      need_properties = true;
+      dict_start_ = out.size();
+    } else if (need_dict_reset) {
+      return false;
+    }
+
+    if (control < 0x80) {
+      // Stored data.
+      if (control > 0x02 || !in.Has(2))
+        return false;
+      size_t size = Be16(in.at()) + 1;
+      in.pos += 2;
+      if (!in.Has(size))
+        return false;
+      out.insert(out.end(), in.at(), in.at() + size);
+      in.pos += size;
+      continue;
+    }
+
+    if (!in.Has(4))
+      return false;
+    size_t unpacked = ((control & 0x1F) << 16 | Be16(in.at())) + 1;
+    size_t packed = Be16(in.at() + 2) + 1;
+    in.pos += 4;
+    if (control >= 0xC0) {
+      uint8_t properties;
+      if (!in.Byte(properties) || !SetProperties(properties))
+        return false;
+      need_properties = false;
+    } else if (need_properties) {
+      return false;
+    }
+    if (control >= 0xA0)
+      ResetState();
+    if (!in.Has(packed) || !rc_.Reset(in.at(), packed))
+      return false;
+    size_t pos = out.size();
+    out.resize(pos + unpacked);
+    if (!DecodeLzma(reinterpret_cast<uint8_t *>(out.data()), pos,
+                    out.size()) ||
+        !rc_.Finished())
+      return false;
+    in.pos += packed;
+  }
+}
+
+bool Lzma2Decoder::SetProperties(uint8_t properties) {
+  if (properties >= 9 * 5 * 5)
+    return false;
+  lc_ = properties % 9;
+  lp_ = properties / 9 % 5;
+  pb_ = properties / (9 * 5);
+  return lc_ + lp_ <= 4;
+}
+
+void Lzma2Decoder::ResetState() {
+  std::fill_n(reinterpret_cast<Prob *>(&probs_), sizeof(probs_) / sizeof(Prob),
+              kProbInit);
+  state_ = 0;
+  std::fill(std::begin(reps_), std::end(reps_), 0);
+}
+
+bool Lzma2Decoder::DecodeLzma(uint8_t *out, size_t pos, size_t end) {
+  uint32_t pos_mask = (1u << pb_) - 1, literal_mask = (1u << lp_) - 1;
+  while (pos < end) {
+    size_t dict_size = pos - dict_start_;
+    uint32_t pos_state = dict_size & pos_mask;
+    if (!rc_.Bit(probs_.is_match[state_][pos_state])) {
+      uint32_t previous = dict_size != 0 ? out[pos - 1] : 0;
+      Prob *probs =
+          probs_.literal +
+          kLiteralCoderSize *
+              ((dict_size & literal_mask) << lc_ | previous >> (8 - lc_));
+      uint32_t symbol = 1;
+      if (state_ < kLiteralStates) {
+        while (symbol < 0x100)
+          symbol = symbol << 1 | rc_.Bit(probs[symbol]);
+      } else {
+        // After a match, the byte following it predicts the literal until
+        // they differ.
+        uint32_t match_byte = out[pos - reps_[0] - 1] << 1;
+        uint32_t offset = 0x100;
+        while (symbol < 0x100) {
+          uint32_t match_bit = match_byte & offset;
+          match_byte <<= 1;
+          uint32_t bit = rc_.Bit(probs[offset + match_bit + symbol]);
+          symbol = symbol << 1 | bit;
+          offset &= bit ? match_bit : ~match_bit;
+        }
+      }
+      out[pos++] = uint8_t(symbol);
+      state_ = state_ < 4 ? 0 : state_ < 10 ? state_ - 3 : state_ - 6;
+      continue;
+    }
+
+    uint32_t length;
+    if (!rc_.Bit(probs_.is_rep[state_])) {
+      state_ = state_ < kLiteralStates ? 7 : 10;
+      reps_[3] = reps_[2];
+      reps_[2] = reps_[1];
+      reps_[1] = reps_[0];
+      length = DecodeLength(probs_.match_len, pos_state);
+      reps_[0] = DecodeDistance(length);
+    } else if (!rc_.Bit(probs_.is_rep0[state_])) {
+      if (!rc_.Bit(probs_.is_rep0_long[state_][pos_state])) {
+        state_ = state_ < kLiteralStates ? 9 : 11;
+        length = 1;
+      } else {
+        state_ = state_ < kLiteralStates ? 8 : 11;
+        length = DecodeLength(probs_.rep_len, pos_state);
+      }
+    } else {
+      uint32_t distance;
+      if (!rc_.Bit(probs_.is_rep1[state_])) {
+        distance = reps_[1];
+      } else {
+        if (!rc_.Bit(probs_.is_rep2[state_])) {
+          distance = reps_[2];
+        } else {
+          distance = reps_[3];
+          reps_[3] = reps_[2];
+        }
+        reps_[2] = reps_[1];
+      }
+      reps_[1] = reps_[0];
+      reps_[0] = distance;
+      state_ = state_ < kLiteralStates ? 8 : 11;
+      length = DecodeLength(probs_.rep_len, pos_state);
+    }
+    // Also rejects the end marker, which LZMA2 does not use. Matches do not
+    // cross chunks.
+    if (reps_[0] >= dict_size || length > end - pos)
+      return false;
+    const uint8_t *from = out + pos - reps_[0] - 1;
+    for (uint32_t i = 0; i < length; i++)
+      out[pos + i] = from[i];
+    pos += length;
+  }
+  return true;
+}
+
+uint32_t Lzma2Decoder::DecodeLength(LengthProbs &probs, uint32_t pos_state) {
+  if (!rc_.Bit(probs.choice))
+    return kMatchLenMin + rc_.Tree(probs.low[pos_state], 3);
+  if (!rc_.Bit(probs.choice2))
+    return kMatchLenMin + 8 + rc_.Tree(probs.mid[pos_state], 3);
+  return kMatchLenMin + 16 + rc_.Tree(probs.high, 8);
+}
+
+uint32_t Lzma2Decoder::DecodeDistance(uint32_t length) {
+  uint32_t dist_state =
+      std::min<uint32_t>(length - kMatchLenMin, kDistStates - 1);
+  uint32_t slot = rc_.Tree(probs_.dist_slot[dist_state], 6);
+  if (slot < kDistModelStart)
+    return slot;
+  int bits = (slot >> 1) - 1;
+  uint32_t distance = (2 | (slot & 1)) << bits;
+  if (slot < kDistModelEnd)
+    return distance +
+           rc_.ReverseTree(probs_.dist_special + distance - slot - 1, bits);
+  distance += rc_.Direct(bits - kAlignBits) << kAlignBits;
+  return distance + rc_.ReverseTree(probs_.dist_align, kAlignBits);
+}
+
+struct Record {
+  uint64_t unpadded_size;
+  uint64_t uncompressed_size;
+};
+
+bool DecodeBlock(Input &in, uint8_t check, Lzma2Decoder &lzma2,
+                 std::vector<char> &out, Record &record) {
+  size_t start = in.pos;
+  size_t header_size = (in.data[start] + 1) * 4;
+  if (!in.Has(header_size) ||
+      Crc32(in.at(), header_size - 4) != Le32(in.at() + header_size - 4))
+    return false;
+  Input header{in.data, start + header_size - 4, start + 1};
+  uint8_t flags;
+  if (!header.Byte(flags) || (flags & 0x3F) != 0)
+    return false;
+  uint64_t compressed_size = UINT64_MAX, uncompressed_size = UINT64_MAX;
+  uint64_t filter, properties_size;
+  uint8_t dict_size;
+  if (((flags & 0x40) != 0 && !header.Vli(compressed_size)) ||
+      ((flags & 0x80) != 0 && !header.Vli(uncompressed_size)) ||
+      !header.Vli(filter) || filter != kFilterLzma2 ||
+      !header.Vli(properties_size) || properties_size != 1 ||
+      !header.Byte(dict_size) || dict_size > 40)
+    return false;
+  while (header.pos != header.size) {
+    if (header.data[header.pos++] != 0)
+      return false;
+  }
+  in.pos += header_size;
+
+  size_t compressed_start = in.pos, uncompressed_start = out.size();
+  if (!lzma2.Decode(in, out))
+    return false;
+  uint64_t compressed = in.pos - compressed_start;
+  uint64_t uncompressed = out.size() - uncompressed_start;
+  if ((compressed_size != UINT64_MAX && compressed != compressed_size) ||
+      (uncompressed_size != UINT64_MAX && uncompressed != uncompressed_size) ||
+      !in.Padding(compressed_start))
+    return false;
+
+  size_t check_size = kCheckSizes[check];
+  if (!in.Has(check_size))
+    return false;
+  auto *data = reinterpret_cast<const uint8_t *>(out.data()) +
+               uncompressed_start;
+  if ((check == kCheckCrc32 && Crc32(data, uncompressed) != Le32(in.at())) ||
+      (check == kCheckCrc64 && Crc64(data, uncompressed) != Le64(in.at())))
+    return false;
+  in.pos += check_size;
+  record = {header_size + compressed + check_size, uncompressed};
+  return true;
+}
+
+// The index lists the blocks again; \p size is set to its size.
+bool DecodeIndex(Input &in, const std::vector<Record> &records,
+                 size_t &size) {
+  size_t start = in.pos;
+  uint8_t indicator;
+  uint64_t count;
+  if (!in.Byte(indicator) || indicator != 0 || !in.Vli(count) ||
+      count != records.size())
+    return false;
+  for (auto &record : records) {
+    uint64_t unpadded_size, uncompressed_size;
+    if (!in.Vli(unpadded_size) || unpadded_size != record.unpadded_size ||
+        !in.Vli(uncompressed_size) ||
+        uncompressed_size != record.uncompressed_size)
+      return false;
+  }
+  if (!in.Padding(start) || !in.Has(4) ||
+      Crc32(in.data + start, in.pos - start) != Le32(in.at()))
+    return false;
+  in.pos += 4;
+  size = in.pos - start;
+  return true;
+}
+
+bool DecodeStream(Input &in, Lzma2Decoder &lzma2, std::vector<char> &out) {
+  if (!in.Has(kStreamHeaderSize) ||
+      memcmp(in.at(), kHeaderMagic, sizeof(kHeaderMagic)) != 0)
+    return false;
+  const uint8_t *flags = in.at() + sizeof(kHeaderMagic);
+  if (flags[0] != 0 || flags[1] > 0x0F || Crc32(flags, 2) != Le32(flags + 2))
+    return false;
+  uint8_t check = flags[1];
+  in.pos += kStreamHeaderSize;
+
+  std::vector<Record> records;
+  while (in.Has(1) && in.at()[0] != 0) {
+    if (!DecodeBlock(in, check, lzma2, out, records.emplace_back()))
+      return false;
+  }
+  size_t index_size;
+  if (!DecodeIndex(in, records, index_size) || !in.Has(kStreamHeaderSize))
+    return false;
+  const uint8_t *footer = in.at();
+  in.pos += kStreamHeaderSize;
+  return Crc32(footer + 4, 6) == Le32(footer) &&
+         (uint64_t(Le32(footer + 4)) + 1) * 4 == index_size &&
+         memcmp(footer + 8, flags, 2) == 0 &&
+         memcmp(footer + 10, kFooterMagic, sizeof(kFooterMagic)) == 0;
+}
+
+} // namespace
+
+bool Decode(std::span<const char> xz, std::vector<char> &out) {
+  Input in{reinterpret_cast<const uint8_t *>(xz.data()), xz.size()};
+  // The probabilities take 28 KiB.
+  auto lzma2 = std::make_unique<Lzma2Decoder>();
+  for (;;) {
+    if (!DecodeStream(in, *lzma2, out))
+      return false;
+    // Streams may be followed by zeroes, in words, and by more streams.
+    while (in.Has(4) && Le32(in.at()) == 0)
+      in.pos += 4;
+    if (in.pos == in.size)
+      return true;
+  }
+}
+
+} // namespace SandHook::Xz
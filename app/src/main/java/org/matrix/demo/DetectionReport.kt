@@ -0,0 +1,70 @@
+package org.matrix.demo
+
+import java.nio.ByteBuffer
+import java.nio.ByteOrder
+
+/**
+ * A scan report read in place from the binary encoding of binary_report.hpp,
+ * which the native library writes into a direct ByteBuffer.
+ */
+class DetectionReport private constructor(
+    val generation: Long,
+    val wallNs: Long,
+    val findings: List<Finding>,
+) {
+    data class Finding(
+        val detector: String,
+        val summary: String,
+        val detected: Boolean,
+        val wallNs: Long,
+        val cpuNs: Long,
+    )
+
+    /** The summaries, one per line, as the report shows them. */
+    val text: String
+        get() = findings.filter { it.summary.isNotEmpty() }.joinToString("\n") { it.summary }
+
+    companion object {
+        private const val MAGIC = 0x54505244 // "DRPT"
+        private const val VERSION = 1
+        private const val HEADER_SIZE = 48
+        private const val RECORD_SIZE = 40
+        private const val DETECTED = 1
+
+        /**
+         * Parses the report at the start of [buffer], or returns null if it
+         * holds none of a known version.
+         */
+        fun parse(buffer: ByteBuffer): DetectionReport? {
+            val data = buffer.duplicate().order(ByteOrder.LITTLE_ENDIAN)
+            if (data.limit() < HEADER_SIZE || data.getInt(0) != MAGIC ||
+                data.getShort(4).toInt() != VERSION
+            ) return null
+            val totalSize = data.getInt(8)
+            val recordCount = data.getInt(12)
+            val recordSize = data.getInt(16)
+            val recordsOffset = data.getInt(20)
+            val stringsOffset = data.getInt(24)
+            if (totalSize > data.limit() || recordSize < RECORD_SIZE) return null
+
+            fun string(offset: Int, length: Int): String {
+                val bytes = ByteArray(length)
+                data.position(stringsOffset + offset)
+                data.get(bytes)
+                return String(bytes, Charsets.UTF_8)
+            }
+
+            val findings = List(recordCount) { i ->
+                val record = recordsOffset + i * recordSize
+                Finding(
+                    detector = string(data.getInt(record), data.getInt(record + 4)),
+                    summary = string(data.getInt(record + 8), data.getInt(record + 12)),
+                    detected = data.getInt(record + 16) and DETECTED != 0,
+                    wallNs = data.getLong(record + 24),
+                    cpuNs = data.getLong(record + 32),
+                )
+            }
+            return DetectionReport(data.getLong(32), data.getLong(40), findings)
+        }
+    }
+}
@@ -8,12 +8,22 @@ import android.view.View
 import android.widget.TextView
 import android.widget.Toast
 import org.matrix.demo.databinding.ActivityMainBinding
+import java.nio.ByteBuffer
 
 class MainActivity : AppCompatActivity() {
 
     private lateinit var binding: ActivityMainBinding
     private var doubleClick = false
     private val handler = Handler(Looper.getMainLooper())
+    private var refreshTicket = Long.MAX_VALUE
+    private var reportBuffer = ByteBuffer.allocateDirect(4096)
+    private val onResult = { generation: Long ->
+        readReport()?.let { binding.sampleText.text = it.text }
+        if (generation >= refreshTicket) {
+            Toast.makeText(this, "result updated", Toast.LENGTH_SHORT).show()
+            refreshTicket = Long.MAX_VALUE
+        }
+    }
 
     override fun onCreate(savedInstanceState: Bundle?) {
         super.onCreate(savedInstanceState)
@@ -21,14 +31,19 @@ class MainActivity : AppCompatActivity() {
         binding = ActivityMainBinding.inflate(layoutInflater)
         setContentView(binding.root)
 
-        // Example of a call to a native method
-        binding.sampleText.text = stringFromJNI()
+        // Symbols decompressed from MiniDebugInfo are kept there across starts
+        setCacheDir(cacheDir.absolutePath)
+
+        // Scans run on a native worker; the last result is shown at once,
+        // e.g. after a configuration change, and replaced when a new one ends
+        readReport()?.let { binding.sampleText.text = it.text }
+        listener = onResult
+        requestScan()
 
         binding.root.setOnClickListener {
             if (doubleClick) {
                 // Double click
-                binding.sampleText.text = stringFromJNI()
-                Toast.makeText(this, "result updated", Toast.LENGTH_SHORT).show()
+                refreshTicket = requestScan()
                 doubleClick = false
             } else {
                 // Single click
@@ -43,16 +58,90 @@ class MainActivity : AppCompatActivity() {
         }
     }
 
+    /**
+     * Reads the last report into the reused buffer, growing it when needed.
+     */
+    private fun readReport(): DetectionReport? {
+        var size = writeReport(reportBuffer)
+        if (size > reportBuffer.capacity()) {
+            reportBuffer = ByteBuffer.allocateDirect(size * 2)
+            size = writeReport(reportBuffer)
+        }
+        if (size <= 0 || size > reportBuffer.capacity()) return null
+        return DetectionReport.parse(reportBuffer.duplicate().limit(size) as ByteBuffer)
+    }
+
+    override fun onStart() {
+        super.onStart()
+        startMonitor()
+    }
+
+    override fun onStop() {
+        stopMonitor()
+        super.onStop()
+    }
+
+    override fun onDestroy() {
+        // The activity recreated after a configuration change may already
+        // have replaced it
+        if (listener === onResult) listener = null
+        super.onDestroy()
+    }
+
     /**
      * A native method that is implemented by the 'demo' native library,
-     * which is packaged with this application.
+     * which is packaged with this application. It blocks until a scan ends.
      */
     external fun stringFromJNI(): String
 
+    /**
+     * Starts a scan on the native worker, or joins one that has not started
+     * yet, and returns the generation of its result.
+     */
+    external fun requestScan(): Long
+
+    /**
+     * Encodes the last completed scan into the direct [buffer] if it fits.
+     * Returns the size of the encoding, 0 before the first scan ends.
+     */
+    external fun writeReport(buffer: ByteBuffer): Int
+
+    /**
+     * Runs the cheap detectors in the background while the app is visible;
+     * a change of their findings triggers a scan.
+     */
+    external fun startMonitor()
+
+    external fun stopMonitor()
+
+    /**
+     * The counters of the instrumented hot paths on one line, empty unless
+     * the native library was built with DEMO_INSTRUMENTATION.
+     */
+    external fun instrumentationSummary(): String
+
+    /**
+     * Sets the directory where the native library caches symbol tables.
+     */
+    external fun setCacheDir(dir: String)
+
     companion object {
+        private val mainHandler = Handler(Looper.getMainLooper())
+
+        // Set by the visible activity only, so that the worker never holds one
+        private var listener: ((Long) -> Unit)? = null
+
         // Used to load the 'demo' library on application startup.
         init {
             System.loadLibrary("demo")
         }
+
+        /**
+         * Called by the native worker after each scan.
+         */
+        @JvmStatic
+        fun onScanResult(generation: Long) {
+            mainHandler.post { listener?.invoke(generation) }
+        }
     }
 }